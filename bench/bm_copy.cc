@@ -6,12 +6,14 @@
 #include <gnuradio/streamops/head.h>
 #include <gnuradio/blocks/null_sink.h>
 #include <gnuradio/blocks/null_source.h>
+#include <gnuradio/buffer_cpu_lockfree.h>
 #include <gnuradio/buffer_cpu_simple.h>
 #include <gnuradio/buffer_cpu_vmcirc.h>
 #include <gnuradio/flowgraph.h>
 #include <gnuradio/realtime.h>
 #include <gnuradio/runtime.h>
 #include <gnuradio/schedulers/nbt/scheduler_nbt.h>
+#include <gnuradio/schedulers/ws/scheduler_ws.h>
 
 #include <iostream>
 
@@ -30,6 +32,8 @@ int main(int argc, char* argv[])
     int buffer_type = 1;
     int buffer_size = 32768;
     bool rt_prio = false;
+    std::string scheduler = "nbt";
+    std::string fill_policy = "half";
 
     std::vector<unsigned int> cpu_affinity;
 
@@ -39,15 +43,22 @@ int main(int argc, char* argv[])
     app.add_option("--samples", samples, "Number of Samples");
     app.add_option("--veclen", veclen, "Vector Length");
     app.add_option("--nblocks", nblocks, "Number of copy blocks");
-    app.add_option("--nthreads", nthreads, "Number of threads (0: tpb)");
+    app.add_option("--nthreads",
+                   nthreads,
+                   "Number of threads (nbt 0: tpb, ws 0: one per hardware thread)");
+    app.add_option("--scheduler", scheduler, "Scheduler (nbt, ws)");
     app.add_option("--buffer_type",
                    buffer_type,
-                   "Buffer Type (0:simple, 1:vmcirc, 2:cuda, 3:cuda_pinned");
+                   "Buffer Type (0:simple, 1:vmcirc, 2:cuda, 3:cuda_pinned, 4:lockfree)");
     app.add_option("--buffer_size", buffer_size, "Buffer Size in bytes");
+    app.add_option("--fill_policy",
+                   fill_policy,
+                   "Buffer fill policy (half, full, adaptive, or a fraction in (0, 1])");
     app.add_flag("--rt_prio", rt_prio, "Enable Real-time priority");
     app.add_option("--cpus",
                    cpu_affinity,
-                   "Pin threads to CPUs (if nthreads > 0, will pin to 0,1,..,N");
+                   "Pin threads to CPUs (if nthreads > 0, will pin to 0,1,..,N; ws "
+                   "pins worker N to core N)");
 
     CLI11_PARSE(app, argc, argv);
 
@@ -66,63 +77,91 @@ int main(int argc, char* argv[])
         }
         flowgraph_sptr fg(new flowgraph());
 
-        if (buffer_type == 0) {
-            fg->connect(src, 0, head, 0);
-            fg->connect(head, 0, copy_blks[0], 0);
-            for (unsigned int i = 0; i < nblocks - 1; i++) {
-                fg->connect(copy_blks[i], 0, copy_blks[i + 1], 0);
-            }
-            fg->connect(copy_blks[nblocks - 1], 0, snk, 0);
+        std::shared_ptr<buffer_properties> buf_props = nullptr;
+        if (buffer_type == 1) {
+            buf_props = BUFFER_CPU_VMCIRC_ARGS;
         }
-        else {
-            fg->connect(src, 0, head, 0)->set_custom_buffer(BUFFER_CPU_VMCIRC_ARGS);
-            fg->connect(head, 0, copy_blks[0], 0)
-                ->set_custom_buffer(BUFFER_CPU_VMCIRC_ARGS);
-            for (unsigned int i = 0; i < nblocks - 1; i++) {
-                fg->connect(copy_blks[i], 0, copy_blks[i + 1], 0)
-                    ->set_custom_buffer(BUFFER_CPU_VMCIRC_ARGS);
-            }
-            fg->connect(copy_blks[nblocks - 1], 0, snk, 0)
-                ->set_custom_buffer(BUFFER_CPU_VMCIRC_ARGS);
+        else if (buffer_type == 4) {
+            buf_props = BUFFER_CPU_LOCKFREE_ARGS;
         }
 
-        std::cout << "Initializing NBT scheduler with buffer size of " << buffer_size
-                  << std::endl;
-        auto sched = schedulers::scheduler_nbt::make("nbt", buffer_size);
-
-        if (buffer_type == 1) {
-            sched->set_default_buffer_factory(BUFFER_CPU_VMCIRC_ARGS);
+        if (fill_policy != "half") {
+            if (!buf_props) {
+                std::cout << "Error: --fill_policy needs a buffer type with buffer "
+                             "properties (1:vmcirc or 4:lockfree)"
+                          << std::endl;
+                return 1;
+            }
+            if (fill_policy == "full") {
+                buf_props->set_fill_policy(buffer_fill_policy_t::FULL);
+            }
+            else if (fill_policy == "adaptive") {
+                buf_props->set_fill_policy(buffer_fill_policy_t::ADAPTIVE);
+            }
+            else {
+                buf_props->set_fill_policy(buffer_fill_policy_t::FRACTION,
+                                           std::stod(fill_policy));
+            }
         }
 
-        if (nthreads > 0) {
-            int blks_per_thread = nblocks / nthreads;
-
-            for (unsigned int i = 0; i < nthreads; i++) {
-                std::vector<block_sptr> block_group;
-                if (i == 0) {
-                    block_group.push_back(src);
-                    block_group.push_back(head);
-                }
+        fg->connect(src, 0, head, 0)->set_custom_buffer(buf_props);
+        fg->connect(head, 0, copy_blks[0], 0)->set_custom_buffer(buf_props);
+        for (unsigned int i = 0; i < nblocks - 1; i++) {
+            fg->connect(copy_blks[i], 0, copy_blks[i + 1], 0)
+                ->set_custom_buffer(buf_props);
+        }
+        fg->connect(copy_blks[nblocks - 1], 0, snk, 0)->set_custom_buffer(buf_props);
+
+        scheduler_sptr sched;
+        if (scheduler == "ws") {
+            std::cout << "Initializing WS scheduler with buffer size of " << buffer_size
+                      << std::endl;
+            sched = schedulers::scheduler_ws::make(
+                "ws", nthreads, buffer_size, !cpu_affinity.empty());
+        }
+        else {
+            std::cout << "Initializing NBT scheduler with buffer size of " << buffer_size
+                      << std::endl;
+            auto nbt = schedulers::scheduler_nbt::make("nbt", buffer_size);
+
+            if (nthreads > 0) {
+                int blks_per_thread = nblocks / nthreads;
+
+                for (unsigned int i = 0; i < nthreads; i++) {
+                    std::vector<block_sptr> block_group;
+                    if (i == 0) {
+                        block_group.push_back(src);
+                        block_group.push_back(head);
+                    }
 
-                for (int j = 0; j < blks_per_thread; j++) {
-                    block_group.push_back(copy_blks[i * blks_per_thread + j]);
-                }
+                    for (int j = 0; j < blks_per_thread; j++) {
+                        block_group.push_back(copy_blks[i * blks_per_thread + j]);
+                    }
 
-                if (i == nthreads - 1) {
-                    for (unsigned int j = 0; j < (nblocks - nthreads * blks_per_thread);
-                         j++) {
-                        block_group.push_back(copy_blks[(i + 1) * blks_per_thread + j]);
+                    if (i == nthreads - 1) {
+                        for (unsigned int j = 0;
+                             j < (nblocks - nthreads * blks_per_thread);
+                             j++) {
+                            block_group.push_back(
+                                copy_blks[(i + 1) * blks_per_thread + j]);
+                        }
+                        block_group.push_back(snk);
+                    }
+                    if (cpu_affinity.empty()) {
+                        nbt->add_block_group(block_group);
+                    }
+                    else {
+                        nbt->add_block_group(block_group,
+                                             "group" + std::to_string(i),
+                                             { cpu_affinity[i] });
                     }
-                    block_group.push_back(snk);
-                }
-                if (cpu_affinity.empty()) {
-                    sched->add_block_group(block_group);
-                }
-                else {
-                    sched->add_block_group(
-                        block_group, "group" + std::to_string(i), { cpu_affinity[i] });
                 }
             }
+            sched = nbt;
+        }
+
+        if (buf_props) {
+            sched->set_default_buffer_factory(buf_props);
         }
 
         auto rt = runtime::make();
@@ -138,6 +177,17 @@ int main(int argc, char* argv[])
         auto time =
             std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / 1e9;
 
+        std::cout << "fill policy " << fill_policy << ": " << samples / time / 1e6
+                  << " Msps" << std::endl;
         std::cout << "[PROFILE_TIME]" << time << "[PROFILE_TIME]" << std::endl;
+
+        uint64_t n_suppressed = 0;
+        if (auto nbt = std::dynamic_pointer_cast<schedulers::scheduler_nbt>(sched)) {
+            n_suppressed = nbt->notifications_suppressed();
+        }
+        else if (auto ws = std::dynamic_pointer_cast<schedulers::scheduler_ws>(sched)) {
+            n_suppressed = ws->notifications_suppressed();
+        }
+        std::cout << "notifications suppressed: " << n_suppressed << std::endl;
     }
 }
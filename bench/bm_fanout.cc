@@ -12,6 +12,7 @@
 #include <gnuradio/realtime.h>
 #include <gnuradio/runtime.h>
 #include <gnuradio/schedulers/nbt/scheduler_nbt.h>
+#include <gnuradio/schedulers/ws/scheduler_ws.h>
 
 #include <iostream>
 
@@ -27,7 +28,10 @@ int main(int argc, char* argv[])
     int nblocks = 1;
     int veclen = 1;
     int buffer_type = 0;
+    int buffer_size = 32768;
+    unsigned int nthreads = 0;
     bool rt_prio = false;
+    std::string scheduler = "nbt";
 
     CLI::App app{ "App description" };
 
@@ -37,22 +41,28 @@ int main(int argc, char* argv[])
     app.add_option("--buffer_type",
                    buffer_type,
                    "Buffer Type (0:simple, 1:vmcirc, 2:cuda, 3:cuda_pinned");
+    app.add_option("--buffer_size", buffer_size, "Buffer Size in bytes");
+    app.add_option("--scheduler", scheduler, "Scheduler (nbt, ws)");
+    app.add_option(
+        "--nthreads", nthreads, "Number of ws workers (0: one per hardware thread)");
     app.add_flag("--rt_prio", rt_prio, "Enable Real-time priority");
 
+    CLI11_PARSE(app, argc, argv);
+
     if (rt_prio && gr::enable_realtime_scheduling() != RT_OK) {
         std::cout << "Error: failed to enable real-time scheduling." << std::endl;
     }
 
     {
-        auto src = blocks::null_source::make({ sizeof(gr_complex) * veclen });
+        auto src = blocks::null_source::make({ 1, sizeof(gr_complex) * veclen });
         auto head =
-            streamops::head::make_cpu({ sizeof(gr_complex) * veclen, samples / veclen });
+            streamops::head::make_cpu({ samples / veclen, sizeof(gr_complex) * veclen });
 
         std::vector<blocks::null_sink::sptr> sink_blks(nblocks);
         std::vector<streamops::copy::sptr> copy_blks(nblocks);
         for (int i = 0; i < nblocks; i++) {
             copy_blks[i] = streamops::copy::make({ sizeof(gr_complex) * veclen });
-            sink_blks[i] = blocks::null_sink::make({ sizeof(gr_complex) * veclen });
+            sink_blks[i] = blocks::null_sink::make({ 1, sizeof(gr_complex) * veclen });
         }
         flowgraph_sptr fg(new flowgraph());
 
@@ -75,7 +85,16 @@ int main(int argc, char* argv[])
             }
         }
 
+        scheduler_sptr sched;
+        if (scheduler == "ws") {
+            sched = schedulers::scheduler_ws::make("ws", nthreads, buffer_size);
+        }
+        else {
+            sched = schedulers::scheduler_nbt::make("nbt", buffer_size);
+        }
+
         auto rt = runtime::make();
+        rt->add_scheduler(sched);
         rt->initialize(fg);
 
         auto t1 = std::chrono::steady_clock::now();
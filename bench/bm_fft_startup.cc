@@ -0,0 +1,54 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <gnuradio/kernel/fft/fftw_fft.h>
+#include <gnuradio/kernel/filter/fft_filter.h>
+
+#include "CLI/App.hpp"
+#include "CLI/Config.hpp"
+#include "CLI/Formatter.hpp"
+
+using namespace gr::kernel;
+
+// Startup cost of flowgraphs with many fft based blocks
+//
+// Constructs --nfilters fft filters, cycling through --ndistinct different tap lengths,
+// the way a bank of channelizers or fft filters would at flowgraph startup.  Only the
+// first filter of each length has to plan its transforms, the rest share the cached
+// plans, which the plan counts printed at the end show.
+int main(int argc, char* argv[])
+{
+    unsigned int nfilters = 64;
+    unsigned int ndistinct = 1;
+    unsigned int ntaps = 1000;
+
+    CLI::App app{ "FFT plan cache startup benchmark" };
+
+    app.add_option("--nfilters", nfilters, "Number of fft filters to construct");
+    app.add_option("--ndistinct", ndistinct, "Number of distinct tap lengths");
+    app.add_option("--ntaps", ntaps, "Number of taps of the shortest filter");
+
+    CLI11_PARSE(app, argc, argv);
+
+    std::vector<std::unique_ptr<filter::fft_filter<gr_complex, float>>> filters;
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < nfilters; i++) {
+        // Double the length for each distinct filter so the transform sizes differ
+        std::vector<float> taps(ntaps << (i % std::max(1u, ndistinct)), 1.0f);
+        filters.push_back(
+            std::make_unique<filter::fft_filter<gr_complex, float>>(1, taps));
+    }
+
+    auto t2 = std::chrono::steady_clock::now();
+    auto time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / 1e9;
+
+    auto stats = fft::get_plan_cache_stats();
+    std::cout << "plans created " << stats.plans_created << " plans shared "
+              << stats.plans_shared << std::endl;
+    std::cout << "[PROFILE_TIME]" << time << "[PROFILE_TIME]" << std::endl;
+}
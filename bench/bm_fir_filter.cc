@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include <gnuradio/kernel/filter/fft_filter.h>
+#include <gnuradio/kernel/filter/fir_filter.h>
+
+#include "CLI/App.hpp"
+#include "CLI/Config.hpp"
+#include "CLI/Formatter.hpp"
+
+using namespace gr::kernel::filter;
+
+namespace {
+
+// Runs fn(n) over the whole input repeatedly until min_time has passed and reports the
+// time per output, in the spirit of a google benchmark fixture
+template <class F>
+void run_case(const std::string& name,
+              size_t ntaps,
+              size_t noutput,
+              double min_time,
+              F&& fn)
+{
+    uint64_t iterations = 0;
+    auto t1 = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    while (elapsed < min_time) {
+        fn(noutput);
+        iterations++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1)
+                      .count();
+    }
+
+    auto ns_per_output = elapsed * 1e9 / (iterations * noutput);
+    std::ostringstream label;
+    label << name << "/" << ntaps;
+    std::cout << std::left << std::setw(28) << label.str() << std::right
+              << std::setw(12) << std::fixed << std::setprecision(2) << ns_per_output
+              << " ns/output" << std::setw(12) << 1e3 / ns_per_output << " Msps"
+              << std::setw(10) << iterations << " iterations" << std::endl;
+}
+
+} // namespace
+
+// Throughput of the complex FIR kernels over a range of tap counts
+//
+// Compares computing one output per dot product (what filterN did before it worked on
+// blocks of outputs), the block form of filterN/filterNdec on one and on --nthreads
+// threads, and overlap-save through fft_filter.  The fft_filter_preferred column shows
+// which of the two engines the fir_filter block would pick for the tap count.
+int main(int argc, char* argv[])
+{
+    std::vector<size_t> tap_counts = { 8, 16, 32, 64, 128, 256, 512, 1024, 4096 };
+    size_t noutput = 32768;
+    unsigned int decimation = 1;
+    unsigned int nthreads = 4;
+    double min_time = 0.5;
+
+    CLI::App app{ "FIR filter engine benchmark" };
+
+    app.add_option("--ntaps", tap_counts, "Tap counts to sweep");
+    app.add_option("--noutput", noutput, "Number of outputs per call");
+    app.add_option("--decimation", decimation, "Decimation factor");
+    app.add_option("--nthreads", nthreads, "Number of threads for the threaded case");
+    app.add_option("--min_time", min_time, "Minimum time per case in seconds");
+
+    CLI11_PARSE(app, argc, argv);
+
+    std::mt19937 gen(0);
+    std::normal_distribution<float> dist;
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    for (auto ntaps : tap_counts) {
+        std::vector<float> taps(ntaps);
+        for (auto& t : taps) {
+            t = dist(gen);
+        }
+        std::vector<gr_complex> input(noutput * decimation + ntaps);
+        for (auto& x : input) {
+            x = gr_complex(dist(gen), dist(gen));
+        }
+        std::vector<gr_complex> output(noutput);
+
+        std::cout << "ntaps " << ntaps << " decimation " << decimation
+                  << " fft_filter_preferred "
+                  << fft_filter_preferred(ntaps, decimation) << std::endl;
+
+        fir_filter_ccf fir(taps);
+        run_case("BM_fir_per_output", ntaps, noutput, min_time, [&](size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                output[i] = fir.filter(&input[i * decimation]);
+            }
+        });
+
+        run_case("BM_fir_block", ntaps, noutput, min_time, [&](size_t n) {
+            fir.filterNdec(output.data(), input.data(), n, decimation);
+        });
+
+        fir_filter_ccf fir_mt(taps);
+        fir_mt.set_nthreads(nthreads);
+        run_case("BM_fir_block_threaded", ntaps, noutput, min_time, [&](size_t n) {
+            fir_mt.filterNdec(output.data(), input.data(), n, decimation);
+        });
+
+        // fft_filter works on whole transforms worth of input at a time
+        fft_filter<gr_complex, float> fft(decimation, taps);
+        auto nsamples = fft.set_taps(taps);
+        auto nfft = std::max<size_t>(noutput / nsamples, 1) * nsamples;
+        std::vector<gr_complex> fft_input(nfft * decimation);
+        for (size_t i = 0; i < fft_input.size(); i++) {
+            fft_input[i] = input[i % input.size()];
+        }
+        std::vector<gr_complex> fft_output(nfft);
+        run_case("BM_fft_filter", ntaps, nfft, min_time, [&](size_t n) {
+            fft.filter(n, fft_input.data(), fft_output.data());
+        });
+    }
+
+    auto t2 = std::chrono::steady_clock::now();
+    auto time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / 1e9;
+
+    std::cout << "[PROFILE_TIME]" << time << "[PROFILE_TIME]" << std::endl;
+}
@@ -0,0 +1,136 @@
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/null_source.h>
+#include <gnuradio/flowgraph.h>
+#include <gnuradio/math/complex_to_mag_squared.h>
+#include <gnuradio/math/conjugate.h>
+#include <gnuradio/math/multiply_const.h>
+#include <gnuradio/runtime.h>
+#include <gnuradio/schedulers/nbt/scheduler_nbt.h>
+#include <gnuradio/streamops/head.h>
+
+#include "CLI/App.hpp"
+#include "CLI/Config.hpp"
+#include "CLI/Formatter.hpp"
+
+using namespace gr;
+
+namespace {
+
+// Connects a chain of blocks between the two given blocks and returns the block the
+// chain ends with
+using chain_builder = std::function<block_sptr(flowgraph_sptr, block_sptr)>;
+
+double run_chain(const chain_builder& build,
+                 size_t out_itemsize,
+                 uint64_t samples,
+                 int buffer_size,
+                 size_t tile_bytes,
+                 size_t& nfused)
+{
+    auto src = blocks::null_source::make({ 1, sizeof(gr_complex) });
+    auto head = streamops::head::make_cpu({ samples, sizeof(gr_complex) });
+    auto snk = blocks::null_sink::make({ 1, out_itemsize });
+
+    flowgraph_sptr fg(new flowgraph());
+    fg->connect(src, 0, head, 0);
+    auto last = build(fg, head);
+    fg->connect(last, 0, snk, 0);
+
+    auto sched = schedulers::scheduler_nbt::make("nbt", buffer_size);
+    sched->set_fuse_tile_size(tile_bytes);
+
+    auto rt = runtime::make();
+    rt->add_scheduler(sched);
+    rt->initialize(fg);
+
+    nfused = 0;
+    for (auto& chain : sched->fused_chains()) {
+        nfused += chain.blocks.size();
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    rt->start();
+    rt->wait();
+    auto t2 = std::chrono::steady_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / 1e9;
+}
+
+} // namespace
+
+// Throughput of chains of sync blocks with one thread per block, against the same
+// chains fused into a single thread over tiles of each of the given sizes
+int main(int argc, char* argv[])
+{
+    uint64_t samples = 100000000;
+    unsigned int nblocks = 4;
+    int buffer_size = 32768;
+    std::vector<size_t> tile_sizes = { 4096, 8192, 16384 };
+
+    CLI::App app{ "Fused execution of chains of sync blocks" };
+
+    app.add_option("--samples", samples, "Number of Samples");
+    app.add_option("--nblocks", nblocks, "Number of blocks in the multiply_const chain");
+    app.add_option("--buffer_size", buffer_size, "Buffer Size in bytes");
+    app.add_option("--tile_bytes", tile_sizes, "Tile sizes in bytes to compare");
+
+    CLI11_PARSE(app, argc, argv);
+
+    std::vector<std::tuple<std::string, chain_builder, size_t>> chains;
+    chains.emplace_back(
+        "multiply_const x" + std::to_string(nblocks),
+        [nblocks](flowgraph_sptr fg, block_sptr prev) {
+            for (unsigned int i = 0; i < nblocks; i++) {
+                block_sptr mult =
+                    math::multiply_const_cc::make_cpu({ gr_complex(1, 0), 1 });
+                fg->connect(prev, 0, mult, 0);
+                prev = mult;
+            }
+            return prev;
+        },
+        sizeof(gr_complex));
+    chains.emplace_back(
+        "multiply_const,conjugate,complex_to_mag_squared,multiply_const",
+        [](flowgraph_sptr fg, block_sptr prev) {
+            block_sptr mult = math::multiply_const_cc::make_cpu({ gr_complex(1, 0), 1 });
+            block_sptr conj = math::conjugate::make({});
+            block_sptr mag2 = math::complex_to_mag_squared::make({ 1 });
+            block_sptr scale = math::multiply_const_ff::make_cpu({ 0.5f, 1 });
+            fg->connect(prev, 0, mult, 0);
+            fg->connect(mult, 0, conj, 0);
+            fg->connect(conj, 0, mag2, 0);
+            fg->connect(mag2, 0, scale, 0);
+            return scale;
+        },
+        sizeof(float));
+
+    double total_time = 0;
+    for (auto& [name, build, out_itemsize] : chains) {
+        size_t nfused;
+        auto base_time = run_chain(build, out_itemsize, samples, buffer_size, 0, nfused);
+        total_time += base_time;
+        std::cout << name << std::endl;
+        std::cout << "  " << std::left << std::setw(16) << "unfused" << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(1)
+                  << samples / base_time / 1e6 << " Msps" << std::endl;
+
+        for (auto tile_bytes : tile_sizes) {
+            auto time =
+                run_chain(build, out_itemsize, samples, buffer_size, tile_bytes, nfused);
+            total_time += time;
+            std::cout << "  " << std::left << std::setw(16)
+                      << "tile " + std::to_string(tile_bytes) << std::right
+                      << std::setw(10) << samples / time / 1e6 << " Msps"
+                      << std::setw(8) << std::setprecision(2) << base_time / time
+                      << "x speedup, " << nfused << " blocks fused" << std::endl;
+            std::cout << std::setprecision(1);
+        }
+    }
+
+    std::cout << "[PROFILE_TIME]" << total_time << "[PROFILE_TIME]" << std::endl;
+}
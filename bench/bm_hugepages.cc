@@ -0,0 +1,110 @@
+#include <chrono>
+#include <iostream>
+
+#include <gnuradio/streamops/copy.h>
+#include <gnuradio/streamops/head.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/null_source.h>
+#include <gnuradio/buffer_cpu_lockfree.h>
+#include <gnuradio/flowgraph.h>
+#include <gnuradio/realtime.h>
+#include <gnuradio/runtime.h>
+#include <gnuradio/schedulers/nbt/scheduler_nbt.h>
+
+#include "CLI/App.hpp"
+#include "CLI/Config.hpp"
+#include "CLI/Formatter.hpp"
+
+using namespace gr;
+
+int main(int argc, char* argv[])
+{
+    uint64_t samples = 500000000;
+    unsigned int nblocks = 4;
+    int veclen = 4096;
+    int buffer_size = 8 * 1024 * 1024;
+    std::string hugepages = "both";
+    bool rt_prio = false;
+    std::vector<unsigned int> cpu_affinity;
+
+    CLI::App app{ "Copy wide vectors through large buffers with and without huge pages" };
+
+    app.add_option("--samples", samples, "Number of Samples");
+    app.add_option("--veclen", veclen, "Vector Length");
+    app.add_option("--nblocks", nblocks, "Number of copy blocks");
+    app.add_option("--buffer_size", buffer_size, "Buffer Size in bytes");
+    app.add_option("--hugepages", hugepages, "Huge pages (off, on, both)");
+    app.add_flag("--rt_prio", rt_prio, "Enable Real-time priority");
+    app.add_option("--cpus",
+                   cpu_affinity,
+                   "Pin the source to the first CPU and copy block N to the next ones");
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (rt_prio && gr::enable_realtime_scheduling() != RT_OK) {
+        std::cout << "Error: failed to enable real-time scheduling." << std::endl;
+    }
+
+    std::vector<bool> runs;
+    if (hugepages == "off" || hugepages == "both") {
+        runs.push_back(false);
+    }
+    if (hugepages == "on" || hugepages == "both") {
+        runs.push_back(true);
+    }
+
+    auto itemsize = sizeof(float) * veclen;
+    for (auto huge : runs) {
+        auto src = blocks::null_source::make({ 1, itemsize });
+        auto head = streamops::head::make_cpu({ samples / veclen, itemsize });
+        auto snk = blocks::null_sink::make({ 1, itemsize });
+        std::vector<streamops::copy::sptr> copy_blks(nblocks);
+        for (unsigned int i = 0; i < nblocks; i++) {
+            copy_blks[i] = streamops::copy::make({ itemsize });
+        }
+
+        flowgraph_sptr fg(new flowgraph());
+        fg->connect(src, 0, head, 0);
+        fg->connect(head, 0, copy_blks[0], 0);
+        for (unsigned int i = 0; i < nblocks - 1; i++) {
+            fg->connect(copy_blks[i], 0, copy_blks[i + 1], 0);
+        }
+        fg->connect(copy_blks[nblocks - 1], 0, snk, 0);
+
+        auto sched = schedulers::scheduler_nbt::make("nbt", buffer_size);
+        sched->set_default_buffer_factory(
+            buffer_cpu_lockfree_properties::make()->set_hugepages(huge));
+
+        if (!cpu_affinity.empty()) {
+            sched->add_block_group({ src, head }, "src", { cpu_affinity[0] });
+            for (unsigned int i = 0; i < nblocks; i++) {
+                sched->add_block_group({ copy_blks[i] },
+                                       "copy" + std::to_string(i),
+                                       { cpu_affinity[(i + 1) % cpu_affinity.size()] });
+            }
+        }
+
+        auto rt = runtime::make();
+        rt->add_scheduler(sched);
+        rt->initialize(fg);
+
+        auto buf = std::dynamic_pointer_cast<buffer_cpu_lockfree>(
+            copy_blks[0]->output_stream_ports()[0]->buffer());
+        std::cout << "hugepages requested: " << huge << ", in use: "
+                  << (buf && buf->hugepages()) << ", buffer "
+                  << (buf ? buf->buf_size() : 0) << " bytes" << std::endl;
+
+        auto t1 = std::chrono::steady_clock::now();
+
+        rt->start();
+        rt->wait();
+
+        auto t2 = std::chrono::steady_clock::now();
+        auto time =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / 1e9;
+
+        std::cout << "throughput: " << samples * sizeof(float) / time / 1e9 << " GB/s"
+                  << std::endl;
+        std::cout << "[PROFILE_TIME]" << time << "[PROFILE_TIME]" << std::endl;
+    }
+}
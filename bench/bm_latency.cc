@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+#include <gnuradio/streamops/copy.h>
+#include <gnuradio/flowgraph.h>
+#include <gnuradio/realtime.h>
+#include <gnuradio/runtime.h>
+#include <gnuradio/schedulers/nbt/scheduler_nbt.h>
+#include <gnuradio/sync_block.h>
+
+#include "CLI/App.hpp"
+#include "CLI/Config.hpp"
+#include "CLI/Formatter.hpp"
+
+using namespace gr;
+
+namespace {
+
+int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Produces one item per period holding the time it was produced
+ *
+ */
+class timestamp_source : public sync_block
+{
+public:
+    timestamp_source(uint64_t nitems, std::chrono::microseconds period)
+        : sync_block("timestamp_source"), _nitems(nitems), _period(period)
+    {
+        add_port(untyped_port::make("out", port_direction_t::OUTPUT, sizeof(int64_t)));
+    }
+
+    work_return_code_t work(std::vector<block_work_input_sptr>& work_input,
+                            std::vector<block_work_output_sptr>& work_output) override
+    {
+        if (_produced >= _nitems) {
+            return work_return_code_t::WORK_DONE;
+        }
+
+        // Pace the source so that the latency is not dominated by queueing
+        auto now = std::chrono::steady_clock::now();
+        if (_next_time > now) {
+            std::this_thread::sleep_until(_next_time);
+        }
+        _next_time = std::chrono::steady_clock::now() + _period;
+
+        work_output[0]->items<int64_t>()[0] = now_ns();
+        work_output[0]->n_produced = 1;
+        _produced++;
+        return work_return_code_t::WORK_OK;
+    }
+
+private:
+    uint64_t _nitems;
+    uint64_t _produced = 0;
+    std::chrono::microseconds _period;
+    std::chrono::steady_clock::time_point _next_time;
+};
+
+/**
+ * @brief Records how long ago each incoming timestamp was taken
+ *
+ */
+class latency_sink : public sync_block
+{
+public:
+    latency_sink() : sync_block("latency_sink")
+    {
+        add_port(untyped_port::make("in", port_direction_t::INPUT, sizeof(int64_t)));
+    }
+
+    work_return_code_t work(std::vector<block_work_input_sptr>& work_input,
+                            std::vector<block_work_output_sptr>& work_output) override
+    {
+        auto now = now_ns();
+        auto in = work_input[0]->items<int64_t>();
+        for (size_t i = 0; i < work_input[0]->n_items; i++) {
+            _latency_ns.push_back(now - in[i]);
+        }
+        work_input[0]->n_consumed = work_input[0]->n_items;
+        return work_return_code_t::WORK_OK;
+    }
+
+    std::vector<int64_t>& latency_ns() { return _latency_ns; }
+
+private:
+    std::vector<int64_t> _latency_ns;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    uint64_t samples = 10000;
+    unsigned int nblocks = 4;
+    unsigned int period_us = 100;
+    unsigned int spin_count = block_group_properties::default_spin_count;
+    std::string wait_policy = "all";
+    bool rt_prio = false;
+
+    CLI::App app{ "End-to-end sample latency through a chain of copy blocks" };
+
+    app.add_option("--samples", samples, "Number of Samples");
+    app.add_option("--nblocks", nblocks, "Number of copy blocks");
+    app.add_option("--period", period_us, "Time between samples in us");
+    app.add_option("--wait_policy", wait_policy, "Wait policy (block, spin, poll, all)");
+    app.add_option("--spin_count", spin_count, "Polls before blocking for spin");
+    app.add_flag("--rt_prio", rt_prio, "Enable Real-time priority");
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (rt_prio && gr::enable_realtime_scheduling() != RT_OK) {
+        std::cout << "Error: failed to enable real-time scheduling." << std::endl;
+    }
+
+    std::vector<std::pair<std::string, wait_policy_t>> policies;
+    if (wait_policy == "block" || wait_policy == "all") {
+        policies.emplace_back("block", wait_policy_t::BLOCK);
+    }
+    if (wait_policy == "spin" || wait_policy == "all") {
+        policies.emplace_back("spin", wait_policy_t::SPIN_THEN_BLOCK);
+    }
+    if (wait_policy == "poll" || wait_policy == "all") {
+        policies.emplace_back("poll", wait_policy_t::BUSY_POLL);
+    }
+
+    for (auto& [policy_name, policy] : policies) {
+        auto src = std::make_shared<timestamp_source>(
+            samples, std::chrono::microseconds(period_us));
+        auto snk = std::make_shared<latency_sink>();
+        std::vector<streamops::copy::sptr> copy_blks(nblocks);
+        for (unsigned int i = 0; i < nblocks; i++) {
+            copy_blks[i] = streamops::copy::make({ sizeof(int64_t) });
+        }
+
+        flowgraph_sptr fg(new flowgraph());
+        fg->connect(src, 0, copy_blks[0], 0);
+        for (unsigned int i = 0; i < nblocks - 1; i++) {
+            fg->connect(copy_blks[i], 0, copy_blks[i + 1], 0);
+        }
+        fg->connect(copy_blks[nblocks - 1], 0, snk, 0);
+
+        auto sched = schedulers::scheduler_nbt::make("nbt");
+        sched->set_default_wait_policy(policy, spin_count);
+
+        auto rt = runtime::make();
+        rt->add_scheduler(sched);
+        rt->initialize(fg);
+
+        auto t1 = std::chrono::steady_clock::now();
+
+        rt->start();
+        rt->wait();
+
+        auto t2 = std::chrono::steady_clock::now();
+        auto time =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / 1e9;
+
+        auto& lat = snk->latency_ns();
+        if (lat.empty()) {
+            std::cout << policy_name << ": no samples received" << std::endl;
+            continue;
+        }
+        std::sort(lat.begin(), lat.end());
+        auto mean = std::accumulate(lat.begin(), lat.end(), 0.0) / lat.size();
+        auto pct = [&lat](double p) { return lat[(size_t)(p * (lat.size() - 1))]; };
+
+        std::cout << policy_name << ": latency (us) mean " << mean / 1e3 << " p50 "
+                  << pct(0.5) / 1e3 << " p99 " << pct(0.99) / 1e3 << " max "
+                  << lat.back() / 1e3 << std::endl;
+        std::cout << "[PROFILE_TIME]" << time << "[PROFILE_TIME]" << std::endl;
+    }
+}
@@ -22,6 +22,7 @@ int main(int argc, char* argv[])
     uint64_t pdu_size = 100;
     unsigned int nblocks = 40;
     bool rt_prio = false;
+    size_t batch_size = 1;
 
     std::vector<unsigned int> cpu_affinity;
 
@@ -31,6 +32,7 @@ int main(int argc, char* argv[])
     app.add_option("--samples", samples, "Number of Bursts");
     app.add_option("--pdu_size", pdu_size, "PDU Size");
     app.add_option("--nblocks", nblocks, "Number of copy blocks");
+    app.add_option("--batch_size", batch_size, "Messages handed to post_many at once");
     app.add_flag("--rt_prio", rt_prio, "Enable Real-time priority");
     app.add_option("--cpus",
                    cpu_affinity,
@@ -60,17 +62,28 @@ int main(int argc, char* argv[])
         auto rt = runtime::make();
         rt->initialize(fg);
 
+        auto in_port = msg_blks[0]->input_message_port("in");
+        std::vector<pmtf::pmt> batch;
+
+        // Inject while the chain runs so that the cost of handing the messages to the
+        // first block, one by one or with post_many, is part of the measurement
+        auto t1 = std::chrono::steady_clock::now();
+        rt->start();
+
         for (size_t p = 0; p < samples; p++) {
             pmtf::pmt msg = pmtf::vector<uint8_t>(pdu_size, 0x42);
-            msg_blks[0]->input_message_port("in")->post(msg);
+            if (batch_size <= 1) {
+                in_port->post(msg);
+                continue;
+            }
+            batch.push_back(msg);
+            if (batch.size() == batch_size || p == samples - 1) {
+                in_port->post_many(batch);
+                batch.clear();
+            }
         }
         // msg_blks[0]->input_message_port("system")->post("done");
 
-        // std::this_thread::sleep_for(std::chrono::seconds(3));
-        auto t1 = std::chrono::steady_clock::now();
-
-
-        rt->start();
         rt->wait();
 
 
@@ -78,6 +91,8 @@ int main(int argc, char* argv[])
         auto time =
             std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / 1e9;
 
+        // Every message is handled once by each block of the chain
+        std::cout << "msgs/sec: " << samples * nblocks / time << std::endl;
         std::cout << "[PROFILE_TIME]" << time << "[PROFILE_TIME]" << std::endl;
 
         // for (auto& b : msg_blks)
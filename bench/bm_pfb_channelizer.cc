@@ -0,0 +1,134 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include <gnuradio/kernel/filter/polyphase_filterbank.h>
+
+#include "CLI/App.hpp"
+#include "CLI/Config.hpp"
+#include "CLI/Formatter.hpp"
+
+#include "../kernel/test/per_step_filterbank.h"
+
+using namespace gr::kernel::filter;
+
+namespace {
+
+// Runs fn() repeatedly until min_time has passed and reports the input sample rate
+template <class F>
+double run_case(const std::string& name,
+                unsigned int nchans,
+                size_t nsamples,
+                double min_time,
+                F&& fn)
+{
+    uint64_t iterations = 0;
+    auto t1 = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    while (elapsed < min_time) {
+        fn();
+        iterations++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1)
+                      .count();
+    }
+
+    auto msps = iterations * nsamples / elapsed / 1e6;
+    std::ostringstream label;
+    label << name << "/" << nchans;
+    std::cout << std::left << std::setw(28) << label.str() << std::right
+              << std::setw(12) << std::fixed << std::setprecision(2) << msps << " Msps"
+              << std::setw(10) << iterations << " iterations" << std::endl;
+    return msps;
+}
+
+} // namespace
+
+// Throughput of the polyphase channelizer engine over a range of channel counts
+//
+// Compares filtering each time step of every branch and running one FFT per time step
+// with channelize(), which filters each branch over a tile of time steps and runs the
+// FFTs of the tile as one batched plan.  The flowgraph level counterpart is
+// blocklib/filter/bench/bm_pfb_channelizer.py.
+int main(int argc, char* argv[])
+{
+    std::vector<unsigned int> chan_counts = { 16, 64, 256, 1024 };
+    unsigned int taps_per_chan = 12;
+    size_t nsamples = 1 << 20;
+    float oversample_rate = 1.0;
+    double min_time = 0.5;
+
+    CLI::App app{ "Polyphase channelizer engine benchmark" };
+
+    app.add_option("--nchans", chan_counts, "Channel counts to sweep");
+    app.add_option("--taps_per_chan", taps_per_chan, "Prototype filter taps per channel");
+    app.add_option("--samples", nsamples, "Number of input samples per call");
+    app.add_option("--oversample_rate", oversample_rate, "Oversample rate");
+    app.add_option("--min_time", min_time, "Minimum time per case in seconds");
+
+    CLI11_PARSE(app, argc, argv);
+
+    std::mt19937 gen(0);
+    std::normal_distribution<float> dist;
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    for (auto nchans : chan_counts) {
+        std::vector<float> taps(nchans * taps_per_chan);
+        for (auto& t : taps) {
+            t = dist(gen);
+        }
+
+        int rate_ratio = (int)rintf(nchans / oversample_rate);
+        std::vector<int> idxlut(nchans), channel_map(nchans);
+        for (unsigned int i = 0; i < nchans; i++) {
+            idxlut[i] = nchans - ((i + rate_ratio) % nchans) - 1;
+            channel_map[i] = i;
+        }
+
+        int ninput = nsamples / nchans;
+        std::vector<std::vector<gr_complex>> in(nchans);
+        std::vector<const gr_complex*> in_ptrs(nchans);
+        for (unsigned int j = 0; j < nchans; j++) {
+            in[j].resize(ninput + taps_per_chan + 1);
+            for (auto& x : in[j]) {
+                x = gr_complex(dist(gen), dist(gen));
+            }
+            in_ptrs[j] = in[j].data();
+        }
+
+        // one output per input sample of a branch, times the oversample rate
+        size_t noutput = (size_t)std::ceil(ninput * oversample_rate) + 1;
+        std::vector<std::vector<gr_complex>> out(nchans,
+                                                 std::vector<gr_complex>(noutput));
+        std::vector<gr_complex*> out_ptrs(nchans);
+        for (unsigned int k = 0; k < nchans; k++) {
+            out_ptrs[k] = out[k].data();
+        }
+
+        per_step_filterbank pfb(nchans, taps);
+        auto base = run_case("BM_pfb_per_step", nchans, nsamples, min_time, [&] {
+            pfb.channelize_per_step(
+                out_ptrs.data(), in_ptrs.data(), ninput, rate_ratio, idxlut);
+        });
+        auto batched = run_case("BM_pfb_batched", nchans, nsamples, min_time, [&] {
+            pfb.channelize(out_ptrs.data(),
+                           nchans,
+                           in_ptrs.data(),
+                           ninput,
+                           rate_ratio,
+                           idxlut,
+                           channel_map);
+        });
+        std::cout << std::setw(40) << std::setprecision(2) << batched / base
+                  << "x speedup" << std::endl;
+    }
+
+    auto t2 = std::chrono::steady_clock::now();
+    auto time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / 1e9;
+
+    std::cout << "[PROFILE_TIME]" << time << "[PROFILE_TIME]" << std::endl;
+}
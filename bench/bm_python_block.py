@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+#
+# SPDX-License-Identifier: GPL-3.0
+#
+# Throughput of a chain of numpy blocks implemented in Python, for each of the
+# given minimum work sizes
+
+import argparse
+import time
+
+from gnuradio import gr, blocks, streamops
+
+
+class multiply_const_ff(gr.sync_block):
+    def __init__(self, k, min_work_items):
+        gr.sync_block.__init__(self, name="multiply_const_ff",
+                               min_work_items=min_work_items)
+        self.k = k
+        self.add_port(gr.port_f("in", gr.INPUT))
+        self.add_port(gr.port_f("out", gr.OUTPUT))
+
+    def work(self, inputs, outputs):
+        noutput_items = outputs[0].n_items
+
+        inbuf = self.get_input_array(inputs, 0)
+        outbuf = self.get_output_array(outputs, 0)
+        outbuf[:] = inbuf * self.k
+
+        outputs[0].produce(noutput_items)
+        return gr.work_return_t.WORK_OK
+
+
+def run_chain(args, min_work_items):
+    fg = gr.flowgraph()
+    src = blocks.null_source(itemsize=gr.sizeof_float)
+    hd = streamops.head(nitems=args.samples, itemsize=gr.sizeof_float)
+    snk = blocks.null_sink(itemsize=gr.sizeof_float)
+
+    fg.connect(src, 0, hd, 0)
+    prev = hd
+    blks = []
+    for _ in range(args.nblocks):
+        blk = multiply_const_ff(1.0, min_work_items)
+        fg.connect(prev, 0, blk, 0)
+        blks.append(blk)
+        prev = blk
+    fg.connect(prev, 0, snk, 0)
+
+    rt = gr.runtime()
+    rt.initialize(fg)
+    startt = time.time()
+    rt.start()
+    rt.wait()
+    endt = time.time()
+
+    calls = sum(b.perf_counters().work_calls for b in blks)
+    return endt - startt, calls
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--samples', type=int, default=100000000)
+    parser.add_argument('--nblocks', type=int, default=4)
+    parser.add_argument('--min_work_items', type=int, nargs='+',
+                        default=[0, 4096, 65536])
+    args = parser.parse_args()
+
+    total_time = 0
+    for min_work_items in args.min_work_items:
+        t, calls = run_chain(args, min_work_items)
+        total_time += t
+        print('min_work_items {:>8}: {:10.1f} Msps, {} work calls'.format(
+            min_work_items, args.samples / t / 1e6, calls))
+
+    print(f'[PROFILE_TIME]{total_time}[PROFILE_TIME]')
+
+
+if __name__ == '__main__':
+    main()
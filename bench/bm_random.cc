@@ -0,0 +1,86 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <gnuradio/kernel/math/random.h>
+
+#include "CLI/App.hpp"
+#include "CLI/Config.hpp"
+#include "CLI/Formatter.hpp"
+
+using rng_t = gr::kernel::math::random;
+
+namespace {
+
+// Runs fn() repeatedly until min_time has passed and reports the rate of numbers
+template <class F>
+double run_case(const std::string& name, size_t nsamples, double min_time, F&& fn)
+{
+    uint64_t iterations = 0;
+    auto t1 = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    while (elapsed < min_time) {
+        fn();
+        iterations++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1)
+                      .count();
+    }
+
+    auto msps = iterations * nsamples / elapsed / 1e6;
+    std::cout << std::left << std::setw(24) << name << std::right << std::setw(12)
+              << std::fixed << std::setprecision(1) << msps << " Msps" << std::setw(10)
+              << iterations << " iterations" << std::endl;
+    return msps;
+}
+
+} // namespace
+
+// Throughput of uniform and Gaussian random numbers, one at a time through ran1() and
+// gasdev() as the noise source used to draw them, and in bulk through fill_uniform()
+// and fill_gaussian()
+int main(int argc, char* argv[])
+{
+    size_t nsamples = 8192;
+    double min_time = 0.5;
+
+    CLI::App app{ "Random number generation benchmark" };
+
+    app.add_option("--samples", nsamples, "Numbers per call");
+    app.add_option("--min_time", min_time, "Minimum time per case in seconds");
+
+    CLI11_PARSE(app, argc, argv);
+
+    std::vector<float> out(nsamples);
+    rng_t rng(1);
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    auto ran1 = run_case("BM_ran1", nsamples, min_time, [&] {
+        for (auto& x : out) {
+            x = rng.ran1();
+        }
+    });
+    auto uniform = run_case("BM_fill_uniform", nsamples, min_time, [&] {
+        rng.fill_uniform(out.data(), out.size());
+    });
+    std::cout << std::setw(36) << std::setprecision(2) << uniform / ran1
+              << "x speedup" << std::endl;
+
+    auto gasdev = run_case("BM_gasdev", nsamples, min_time, [&] {
+        for (auto& x : out) {
+            x = rng.gasdev();
+        }
+    });
+    auto gaussian = run_case("BM_fill_gaussian", nsamples, min_time, [&] {
+        rng.fill_gaussian(out.data(), out.size());
+    });
+    std::cout << std::setw(36) << std::setprecision(2) << gaussian / gasdev
+              << "x speedup" << std::endl;
+
+    auto t2 = std::chrono::steady_clock::now();
+    auto time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / 1e9;
+
+    std::cout << "[PROFILE_TIME]" << time << "[PROFILE_TIME]" << std::endl;
+}
@@ -0,0 +1,54 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+#
+# SPDX-License-Identifier: GPL-3.0
+#
+# Compare the nbt and ws schedulers on the copy and fanout benchmarks while
+# restricting the process to 1..N cores
+
+import argparse
+import os
+import re
+import subprocess
+
+
+def run_bm(exe, cores, args):
+    cpus = ','.join(str(c) for c in range(cores))
+    cmd = ['taskset', '-c', cpus, exe] + args
+    out = subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+    m = re.search(r'\[PROFILE_TIME\](.*)\[PROFILE_TIME\]', out)
+    return float(m.group(1))
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--bindir', default='.',
+                        help='Directory holding bm_nbt_copy and bm_nbt_fanout')
+    parser.add_argument('--max_cores', type=int, default=os.cpu_count())
+    parser.add_argument('--samples', type=int, default=100000000)
+    parser.add_argument('--nblocks', type=int, default=16)
+    parser.add_argument('--buffer_size', type=int, default=32768)
+    parser.add_argument('--iters', type=int, default=3)
+    args = parser.parse_args()
+
+    common = ['--samples', str(args.samples), '--nblocks', str(args.nblocks),
+              '--buffer_size', str(args.buffer_size)]
+
+    print('bench,cores,nbt_msps,ws_msps')
+    for bench in ['copy', 'fanout']:
+        exe = os.path.join(args.bindir, 'bm_nbt_' + bench)
+        for cores in range(1, args.max_cores + 1):
+            result = {}
+            for sched in ['nbt', 'ws']:
+                bm_args = common + ['--scheduler', sched]
+                if sched == 'ws':
+                    bm_args += ['--nthreads', str(cores)]
+                t = min(run_bm(exe, cores, bm_args) for _ in range(args.iters))
+                result[sched] = args.samples / t / 1e6
+            print('{},{},{:.2f},{:.2f}'.format(
+                bench, cores, result['nbt'], result['ws']))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,88 @@
+#include <chrono>
+#include <iostream>
+
+#include <gnuradio/buffer_cpu_vmcirc.h>
+
+#include "CLI/App.hpp"
+#include "CLI/Config.hpp"
+#include "CLI/Formatter.hpp"
+
+using namespace gr;
+
+// Tag stress test on a single edge, without a scheduler in the way
+//
+// A writer attaches one tag every --tag_interval items, and the reader trails the writer
+// by --lag items, so that lag / tag_interval tags are pending in the buffer at any time.
+// Every read looks up the tags in its window, propagates them to a downstream buffer and
+// prunes the consumed ones, as the scheduler does each work call.  Sweeping --lag shows
+// how the tag operations scale with the number of pending tags.
+int main(int argc, char* argv[])
+{
+    uint64_t samples = 10000000;
+    uint64_t tag_interval = 16;
+    uint64_t lag = 65536;
+    uint64_t chunk = 1024;
+
+    CLI::App app{ "App description" };
+
+    app.add_option("--samples", samples, "Number of Samples");
+    app.add_option("--tag_interval", tag_interval, "Number of items between tags");
+    app.add_option("--lag", lag, "Number of items the reader trails the writer by");
+    app.add_option("--chunk", chunk, "Number of items per write and read");
+
+    CLI11_PARSE(app, argc, argv);
+
+    size_t itemsize = sizeof(float);
+    // space_available is capped at half the buffer
+    size_t num_items = 4 * (lag + chunk);
+
+    auto buf = buffer_cpu_vmcirc::make(num_items, itemsize, BUFFER_CPU_VMCIRC_ARGS);
+    auto rdr = buf->add_reader(nullptr, itemsize);
+    auto out_buf = buffer_cpu_vmcirc::make(num_items, itemsize, BUFFER_CPU_VMCIRC_ARGS);
+    auto out_rdr = out_buf->add_reader(nullptr, itemsize);
+
+    uint64_t next_tag = 0;
+    uint64_t ntags_seen = 0;
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    while (rdr->total_read() < samples) {
+        // Writer side
+        if (buf->total_written() < samples) {
+            buffer_info_t wi;
+            buf->write_info(wi);
+            uint64_t n = std::min((uint64_t)wi.n_items, chunk);
+            n = std::min(n, samples - buf->total_written());
+            auto end = buf->total_written() + n;
+            for (; next_tag < end; next_tag += tag_interval) {
+                buf->add_tag(tag_t(next_tag, tag_map{}));
+            }
+            buf->post_write(n);
+        }
+
+        // Reader side, only once the writer is far enough ahead
+        buffer_info_t ri;
+        rdr->read_info(ri);
+        if ((uint64_t)ri.n_items < lag + chunk && buf->total_written() < samples) {
+            continue;
+        }
+        uint64_t n = std::min((uint64_t)ri.n_items, chunk);
+
+        ntags_seen += rdr->get_tags(n).size();
+        out_buf->propagate_tags(rdr, n);
+        out_buf->post_write(n);
+        rdr->post_read(n);
+        buf->prune_tags();
+
+        out_rdr->post_read(n);
+        out_buf->prune_tags();
+    }
+
+    auto t2 = std::chrono::steady_clock::now();
+    auto time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / 1e9;
+
+    std::cout << "tags: " << ntags_seen << " pending: " << lag / tag_interval
+              << std::endl;
+    std::cout << "[PROFILE_TIME]" << time << "[PROFILE_TIME]" << std::endl;
+}
@@ -11,6 +11,7 @@
 
 #include "noise_source_cpu.h"
 #include "noise_source_cpu_gen.h"
+#include <type_traits>
 
 namespace gr {
 namespace analog {
@@ -30,6 +31,27 @@ noise_source_cpu<gr_complex>::noise_source_cpu(const typename noise_source<gr_co
     // param_amplitude gets set in the INHERITED_CONSTRUCTORS from the noise_source autogen class
     // but for complex, needs the 1/sqrt(2) factor
     *param_amplitude = args.amplitude / sqrtf(2.0f);
+    update_param_snapshot(id_amplitude);
+}
+
+template <class T>
+template <class F>
+void noise_source_cpu<T>::fill_bulk(T* out, size_t n, F&& fill)
+{
+    if constexpr (std::is_same_v<T, float>) {
+        fill(out, n);
+    }
+    else if constexpr (std::is_same_v<T, gr_complex>) {
+        // both the real and the imaginary part are noise
+        fill(reinterpret_cast<float*>(out), 2 * n);
+    }
+    else {
+        d_scratch.resize(n);
+        fill(d_scratch.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            out[i] = static_cast<T>(d_scratch[i]);
+        }
+    }
 }
 
 template <class T>
@@ -39,20 +61,20 @@ work_return_code_t noise_source_cpu<T>::work(std::vector<block_work_input_sptr>&
     auto out = work_output[0]->items<T>();
     auto noutput_items = work_output[0]->n_items;
 
-    auto type = pmtf::get_as<int>(*this->param_type);
-    auto ampl = pmtf::get_as<float>(*this->param_amplitude);
+    auto type = this->snapshot_type.get();
+    auto ampl = this->snapshot_amplitude.get();
 
-    switch (static_cast<noise_type>(type)) {
+    switch (type) {
     case noise_type::uniform:
-        for (size_t i = 0; i < noutput_items; i++) {
-            out[i] = static_cast<T>(ampl * ((d_rng.ran1() * 2.0) - 1.0));
-        }
+        fill_bulk(out, noutput_items, [this, ampl](float* f, size_t n) {
+            d_rng.fill_uniform(f, n, -ampl, ampl);
+        });
         break;
 
     case noise_type::gaussian:
-        for (size_t i = 0; i < noutput_items; i++) {
-            out[i] = static_cast<T>(ampl * d_rng.gasdev());
-        }
+        fill_bulk(out, noutput_items, [this, ampl](float* f, size_t n) {
+            d_rng.fill_gaussian(f, n, ampl);
+        });
         break;
 
     case noise_type::laplacian:
@@ -27,6 +27,12 @@ public:
 
 private:
     kernel::math::random d_rng;
+    std::vector<float> d_scratch;
+
+    // Runs a bulk fill of the random generator over out, viewed as floats, or through
+    // d_scratch for the integer types
+    template <class F>
+    void fill_bulk(T* out, size_t n, F&& fill);
 };
 
 
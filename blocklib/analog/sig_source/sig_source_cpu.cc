@@ -33,11 +33,10 @@ work_return_code_t sig_source_cpu<T>::work(std::vector<block_work_input_sptr>& w
     auto noutput_items = work_output[0]->n_items;
 
     T t;
-    std::scoped_lock l(d_mutex);
 
-    auto offset = pmtf::get_as<T>(*this->param_offset);
-    auto ampl = pmtf::get_as<float>(*this->param_ampl);
-    auto waveform = static_cast<waveform_type>(pmtf::get_as<int>(*this->param_waveform));
+    auto offset = this->snapshot_offset.get();
+    float ampl = this->snapshot_ampl.get();
+    auto waveform = this->snapshot_waveform.get();
 
     switch (waveform) {
     case waveform_type::constant:
@@ -113,11 +112,10 @@ work_return_code_t sig_source_cpu<gr_complex>::work(std::vector<block_work_input
     auto noutput_items = work_output[0]->n_items;
 
     gr_complex t;
-    std::scoped_lock l(d_mutex);
 
-    auto offset = pmtf::get_as<gr_complex>(*this->param_offset);
-    auto ampl = pmtf::get_as<float>(*this->param_ampl);
-    auto waveform = static_cast<waveform_type>(pmtf::get_as<int>(*this->param_waveform));
+    auto offset = this->snapshot_offset.get();
+    float ampl = this->snapshot_ampl.get();
+    auto waveform = this->snapshot_waveform.get();
 
     switch (waveform) {
     case waveform_type::constant:
@@ -12,7 +12,6 @@
 
 #include <gnuradio/analog/sig_source.h>
 #include <gnuradio/kernel/math/fxpt_nco.h>
-#include <mutex>
 #include <gnuradio/kernel/math/math.h>
 
 namespace gr {
@@ -51,9 +50,6 @@ public:
 private:
     // Declare private variables here
     gr::kernel::math::fxpt_nco d_nco;
-
-    // sig_source has some non thread safe accessors (for now)
-    std::mutex d_mutex;
 };
 
 
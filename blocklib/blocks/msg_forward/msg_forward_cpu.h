@@ -38,7 +38,7 @@ protected:
         if (d_max_messages && msg_cnt >= d_max_messages) {
             input_message_port("system")->post("done");
         }
-        get_message_port("out")->post(msg);
+        _msg_out->post(std::move(msg));
     }
 
 private:
@@ -29,9 +29,18 @@ vector_sink_cpu<T>::work(std::vector<block_work_input_sptr>& work_input,
 {
     auto iptr = work_input[0]->items<T>();
     int noutput_items = work_input[0]->n_items;
-
-    for (unsigned int i = 0; i < noutput_items * d_vlen; i++)
-        d_data.push_back(iptr[i]);
+    auto stride = work_input[0]->stride();
+
+    if (stride == 1) {
+        d_data.insert(d_data.end(), iptr, iptr + noutput_items * d_vlen);
+    }
+    else {
+        // Every stride'th vector of the buffer, from a strided edge
+        for (int i = 0; i < noutput_items; i++) {
+            auto v = iptr + i * stride * d_vlen;
+            d_data.insert(d_data.end(), v, v + d_vlen);
+        }
+    }
 
     auto tags = work_input[0]->tags_in_window(0, noutput_items);
     d_tags.insert(d_tags.end(), tags.begin(), tags.end());
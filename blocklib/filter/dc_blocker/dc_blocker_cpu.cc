@@ -11,6 +11,7 @@
 #include "dc_blocker_cpu.h"
 #include "dc_blocker_cpu_gen.h"
 #include <volk/volk.h>
+#include <algorithm>
 
 namespace gr {
 namespace filter {
@@ -26,7 +27,7 @@ dc_blocker_cpu<T>::dc_blocker_cpu(const typename dc_blocker<T>::block_args& args
     if (d_long_form) {
         d_ma_2 = std::make_unique<kernel::filter::moving_averager<T>>(d_length);
         d_ma_3 = std::make_unique<kernel::filter::moving_averager<T>>(d_length);
-        d_delay_line = std::deque<T>(d_length - 1, 0);
+        d_delayed.assign(d_length - 1, 0);
     }
 }
 
@@ -49,27 +50,33 @@ dc_blocker_cpu<T>::work(std::vector<block_work_input_sptr>& work_input,
     auto out = work_output[0]->items<T>();
     auto noutput_items = work_output[0]->n_items;
 
-    if (d_long_form) {
-        T y1, y2, y3, y4, d;
-        for (size_t i = 0; i < noutput_items; i++) {
-            y1 = d_ma_0.filter(in[i]);
-            y2 = d_ma_1.filter(y1);
-            y3 = d_ma_2->filter(y2);
-            y4 = d_ma_3->filter(y3);
+    if (d_y1.size() < noutput_items) {
+        d_y1.resize(noutput_items);
+        d_y2.resize(noutput_items);
+    }
 
-            d_delay_line.push_back(d_ma_0.delayed_sig());
-            d = d_delay_line[0];
-            d_delay_line.pop_front();
+    if (d_long_form) {
+        // The input delayed by D - 1 lands behind the D - 1 items still owed from the
+        // last call, which makes the front of d_delayed the input delayed by 2D - 2
+        d_delayed.resize(d_length - 1 + noutput_items);
+        d_ma_0.filterN(d_y1.data(), in, noutput_items, &d_delayed[d_length - 1]);
+        d_ma_1.filterN(d_y2.data(), d_y1.data(), noutput_items);
+        d_ma_2->filterN(d_y1.data(), d_y2.data(), noutput_items);
+        d_ma_3->filterN(d_y2.data(), d_y1.data(), noutput_items);
 
-            out[i] = d - y4;
+        for (size_t i = 0; i < noutput_items; i++) {
+            out[i] = d_delayed[i] - d_y2[i];
         }
+        std::copy(d_delayed.end() - (d_length - 1), d_delayed.end(), d_delayed.begin());
+        d_delayed.resize(d_length - 1);
     }
     else {
-        T y1, y2;
+        d_delayed.resize(noutput_items);
+        d_ma_0.filterN(d_y1.data(), in, noutput_items, d_delayed.data());
+        d_ma_1.filterN(d_y2.data(), d_y1.data(), noutput_items);
+
         for (size_t i = 0; i < noutput_items; i++) {
-            y1 = d_ma_0.filter(in[i]);
-            y2 = d_ma_1.filter(y1);
-            out[i] = d_ma_0.delayed_sig() - y2;
+            out[i] = d_delayed[i] - d_y2[i];
         }
     }
 
@@ -35,7 +35,11 @@ protected:
     kernel::filter::moving_averager<T> d_ma_1;
     std::unique_ptr<kernel::filter::moving_averager<T>> d_ma_2;
     std::unique_ptr<kernel::filter::moving_averager<T>> d_ma_3;
-    std::deque<T> d_delay_line;
+
+    // outputs of the averagers, and the input delayed to line up with them
+    std::vector<T> d_y1;
+    std::vector<T> d_y2;
+    std::vector<T> d_delayed;
 };
 
 
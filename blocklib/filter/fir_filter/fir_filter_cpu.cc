@@ -17,9 +17,21 @@ namespace filter {
 template <class IN_T, class OUT_T, class TAP_T>
 fir_filter_cpu<IN_T, OUT_T, TAP_T>::fir_filter_cpu(
     const typename fir_filter<IN_T, OUT_T, TAP_T>::block_args& args)
-    : INHERITED_CONSTRUCTORS(IN_T, OUT_T, TAP_T), d_fir(args.taps)
+    : INHERITED_CONSTRUCTORS(IN_T, OUT_T, TAP_T),
+      d_fir(args.taps),
+      d_decim(args.decimation)
 {
     this->set_relative_rate(1.0 / args.decimation);
+    d_fir.set_nthreads(args.nthreads);
+
+    // The engine is picked once since the output multiple cannot change after the
+    // flowgraph has sized its buffers
+    if constexpr (fft_capable) {
+        if (gr::kernel::filter::fft_filter_preferred(args.taps.size(), d_decim)) {
+            set_fft_taps(args.taps);
+            this->set_output_multiple(d_fft_nsamples);
+        }
+    }
 
     // const int alignment_multiple = volk_get_alignment() / sizeof(float);
     // this->set_alignment(std::max(1, alignment_multiple));
@@ -35,10 +47,77 @@ void fir_filter_cpu<IN_T, OUT_T, TAP_T>::on_parameter_change(param_action_sptr a
     if (action->id() == fir_filter<IN_T, OUT_T, TAP_T>::id_taps) {
         auto taps = pmtf::get_as<std::vector<TAP_T>>(*this->param_taps);
         d_fir.set_taps(taps);
+        if (d_fft) {
+            set_fft_taps(taps);
+        }
         d_updated = true;
     }
 }
 
+template <class IN_T, class OUT_T, class TAP_T>
+void fir_filter_cpu<IN_T, OUT_T, TAP_T>::set_fft_taps(const std::vector<TAP_T>& taps)
+{
+    if constexpr (fft_capable) {
+        // fft_filter outputs y[n] = sum_k taps[k] x[n - k] for n a multiple of the
+        // decimation, while the direct form lines output i up with
+        // x[i * decim + ntaps - 1].  Delaying the taps by a few zeros moves that point
+        // onto a multiple of the decimation, and the first d_fft_lag outputs are the
+        // ones to drop.
+        auto ntaps = std::max<size_t>(taps.size(), 1);
+        d_fft_lag = (ntaps - 1 + d_decim - 1) / d_decim;
+        std::vector<TAP_T> delayed(d_fft_lag * d_decim - (ntaps - 1), TAP_T(0));
+        delayed.insert(delayed.end(), taps.begin(), taps.end());
+
+        // New taps restart the filter at the read pointer, just like the direct form
+        if (!d_fft) {
+            d_fft = std::make_unique<fft_filter_t>(d_decim, delayed);
+        }
+        d_fft_nsamples = d_fft->set_taps(delayed);
+        d_fft_out.resize(d_fft_nsamples);
+        d_fft_primed = false;
+    }
+}
+
+template <class IN_T, class OUT_T, class TAP_T>
+size_t fir_filter_cpu<IN_T, OUT_T, TAP_T>::work_fft(const IN_T* in,
+                                                    OUT_T* out,
+                                                    size_t ninput,
+                                                    size_t noutput)
+{
+    if constexpr (fft_capable) {
+        // Once primed the filter has been fed d_fft_lag outputs worth of input past the
+        // read pointer; otherwise it starts at the read pointer and the first
+        // d_fft_lag outputs are the start up transient
+        auto lead = d_fft_primed ? d_fft_lag * d_decim : 0;
+        auto skip = d_fft_primed ? 0 : d_fft_lag;
+        auto chunk = d_fft_nsamples * d_decim;
+        if (ninput < lead + chunk) {
+            return 0;
+        }
+        auto nchunks =
+            std::min((ninput - lead) / chunk, (noutput + skip) / d_fft_nsamples);
+        if (nchunks == 0) {
+            return 0;
+        }
+
+        in += lead;
+        if (skip > 0) {
+            d_fft->filter(d_fft_nsamples, in, d_fft_out.data());
+            std::copy(d_fft_out.begin() + skip, d_fft_out.end(), out);
+            in += chunk;
+            out += d_fft_nsamples - skip;
+            nchunks--;
+        }
+        d_fft->filter(nchunks * d_fft_nsamples, in, out);
+        d_fft_primed = true;
+
+        return nchunks * d_fft_nsamples + (skip > 0 ? d_fft_nsamples - skip : 0);
+    }
+    else {
+        return 0;
+    }
+}
+
 template <class IN_T, class OUT_T, class TAP_T>
 work_return_code_t
 fir_filter_cpu<IN_T, OUT_T, TAP_T>::work(std::vector<block_work_input_sptr>& work_input,
@@ -48,7 +127,7 @@ fir_filter_cpu<IN_T, OUT_T, TAP_T>::work(std::vector<block_work_input_sptr>& wor
     size_t ninput = work_input[0]->n_items;
     size_t noutput = work_output[0]->n_items;
 
-    auto decim = pmtf::get_as<size_t>(*this->param_decimation);
+    auto decim = d_decim;
 
     if (d_updated) {
         d_hist_change = d_history - d_fir.ntaps();
@@ -69,6 +148,20 @@ fir_filter_cpu<IN_T, OUT_T, TAP_T>::work(std::vector<block_work_input_sptr>& wor
     auto in = work_input[0]->items<IN_T>();
     auto out = work_output[0]->items<OUT_T>();
 
+    // Overlap-save whenever a whole transform worth of input is there, the direct form
+    // picks up what is left over and the transform restarts from there next time
+    if (d_fft) {
+        auto n = work_fft(in, out, ninput, noutput);
+        if (n > 0) {
+            this->consume_each(n * decim, work_input);
+            this->produce_each(n, work_output);
+            d_hist_change = 0;
+            d_hist_updated = false;
+            return work_return_code_t::WORK_OK;
+        }
+        d_fft_primed = false;
+    }
+
     if (decim == 1) {
         d_fir.filterN(out, in, noutput_items);
     }
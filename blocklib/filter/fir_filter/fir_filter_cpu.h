@@ -11,8 +11,11 @@
 #pragma once
 
 #include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/kernel/filter/fft_filter.h>
 #include <gnuradio/kernel/filter/fir_filter.h>
 
+#include <type_traits>
+
 namespace gr {
 namespace filter {
 
@@ -35,6 +38,24 @@ private:
     size_t d_history = 1;
     int d_hist_change = 1;
     bool d_hist_updated = false;
+    size_t d_decim;
+
+    // Long filters go through overlap-save when there is an fft_filter for the types
+    static constexpr bool fft_capable =
+        std::is_same_v<IN_T, OUT_T> &&
+        (std::is_same_v<OUT_T, gr_complex> || std::is_same_v<TAP_T, float>);
+    using fft_filter_t =
+        std::conditional_t<fft_capable,
+                           gr::kernel::filter::fft_filter<OUT_T, TAP_T>,
+                           gr::kernel::filter::fft_filter<float, float>>;
+    std::unique_ptr<fft_filter_t> d_fft;
+    std::vector<OUT_T> d_fft_out;
+    size_t d_fft_nsamples = 0;
+    size_t d_fft_lag = 0;      // outputs overlap-save trails the direct form by
+    bool d_fft_primed = false; // fed ahead of the read pointer by d_fft_lag outputs
+
+    void set_fft_taps(const std::vector<TAP_T>& taps);
+    size_t work_fft(const IN_T* in, OUT_T* out, size_t ninput, size_t noutput);
 };
 
 
@@ -24,10 +24,9 @@ moving_average_cpu<T>::moving_average_cpu(
       d_max_iter(args.max_iter),
       d_vlen(args.vlen),
       d_new_length(args.length),
-      d_new_scale(args.scale)
+      d_new_scale(args.scale),
+      d_averager(args.length, args.scale, args.vlen)
 {
-    d_sum = std::vector<T>(d_vlen);
-    d_history = std::vector<T>(d_vlen * (d_length - 1));
 }
 
 template <class T>
@@ -35,7 +34,7 @@ work_return_code_t
 moving_average_cpu<T>::work(std::vector<block_work_input_sptr>& work_input,
                             std::vector<block_work_output_sptr>& work_output)
 {
-    if (work_input[0]->n_items < d_length) {
+    if (work_input[0]->n_items == 0) {
         work_output[0]->n_produced = 0;
         work_input[0]->n_consumed = 0;
         return work_return_code_t::WORK_INSUFFICIENT_INPUT_ITEMS;
@@ -44,46 +43,22 @@ moving_average_cpu<T>::work(std::vector<block_work_input_sptr>& work_input,
     if (d_updated) {
         d_length = d_new_length;
         d_scale = d_new_scale;
+        d_averager.set_length(d_length);
+        d_averager.set_scale(d_scale);
         d_updated = false;
-        work_output[0]->n_produced = 0;
-        work_input[0]->n_consumed = 0;
-        return work_return_code_t::WORK_OK;
     }
 
     auto in = work_input[0]->items<T>();
     auto out = work_output[0]->items<T>();
 
-    size_t noutput_items =
-        std::min((work_input[0]->n_items - d_length), work_output[0]->n_items);
-
+    size_t noutput_items = std::min(work_input[0]->n_items, work_output[0]->n_items);
     auto num_iter = (noutput_items > d_max_iter) ? d_max_iter : noutput_items;
-    auto tr = work_input[0]->buffer->total_read();
 
-    if (tr == 0) { // for the first no history case
-        for (size_t i = 0; i < num_iter; i++) {
-            for (size_t elem = 0; elem < d_vlen; elem++) {
-                d_sum[elem] += in[i * d_vlen + elem];
-                out[i * d_vlen + elem] = d_sum[elem] * d_scale;
-                if (i >= (d_length - 1)) {
-                    d_sum[elem] -= in[(i - (d_length - 1)) * d_vlen + elem];
-                }
-            }
-        }
-    }
-    else {
-        for (size_t i = 0; i < num_iter; i++) {
-            for (size_t elem = 0; elem < d_vlen; elem++) {
-
-                d_sum[elem] += in[(i + d_length - 1) * d_vlen + elem];
-                out[i * d_vlen + elem] = d_sum[elem] * d_scale;
-                d_sum[elem] -= in[i * d_vlen + elem];
-            }
-        }
-    }
+    // The averager keeps the last d_length items itself, so all the input is consumed
+    d_averager.filterN(out, in, num_iter);
 
-    // don't consume the last d_length-1 samples
     work_output[0]->n_produced = num_iter;
-    work_input[0]->n_consumed = tr == 0 ? num_iter - (d_length - 1) : num_iter;
+    work_input[0]->n_consumed = num_iter;
     return work_return_code_t::WORK_OK;
 } // namespace filter
 
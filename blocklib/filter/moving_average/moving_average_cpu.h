@@ -11,6 +11,7 @@
 #pragma once
 
 #include <gnuradio/filter/moving_average.h>
+#include <gnuradio/kernel/filter/moving_averager.h>
 
 #include <vector>
 
@@ -34,14 +35,12 @@ protected:
     T d_scale;
     size_t d_max_iter;
     size_t d_vlen;
-    T d_scalar_sum;
-    std::vector<T> d_sum;
-
-    std::vector<T> d_history;
 
     size_t d_new_length;
     T d_new_scale;
     bool d_updated = false;
+
+    kernel::filter::moving_averager<T> d_averager;
 };
 
 
@@ -10,6 +10,7 @@
 
 #include "pfb_channelizer_cpu.h"
 #include "pfb_channelizer_cpu_gen.h"
+#include <gnuradio/kernel/streamops/deinterleave.h>
 #include <volk/volk.h>
 
 namespace gr {
@@ -84,6 +85,7 @@ void pfb_channelizer_cpu<T>::set_taps(const std::vector<float>& taps)
     polyphase_filterbank::set_taps(taps);
     // set_history(d_taps_per_filter + 1);
     d_history = d_nchans * (d_taps_per_filter + 1);
+    this->set_min_input_items(d_history * d_nchans);
     d_updated = true;
 }
 
@@ -96,7 +98,6 @@ pfb_channelizer_cpu<T>::work(std::vector<block_work_input_sptr>& work_input,
     // std::scoped_lock guard(d_mutex);
 
     auto in = work_input[0]->items<T>();
-    auto out = work_output[0]->items<T>();
     auto noutput_items = work_output[0]->n_items;
     auto ninput_items = work_input[0]->n_items;
 
@@ -112,22 +113,21 @@ pfb_channelizer_cpu<T>::work(std::vector<block_work_input_sptr>& work_input,
     // includes history
     auto total_items = std::min(ninput_items / d_nchans, noutput_items + (d_history / d_nchans) );
 
+    d_deinterleaved_ptrs.resize(d_nchans);
     for (size_t j = 0; j < d_nchans; j++) {
         if (d_deinterleaved[j].size() < total_items) {
             d_deinterleaved[j].resize(total_items);
         }
-        for (size_t i = 0; i < total_items; i++) {
-            d_deinterleaved[j][i] = in[i * d_nchans + j];
-        }
+        d_deinterleaved_ptrs[j] = d_deinterleaved[j].data();
     }
+    kernel::streamops::deinterleave<sizeof(T)>(
+        d_deinterleaved_ptrs.data(), in, d_nchans, total_items);
 
     size_t noutputs = work_output.size();
     noutput_items = total_items - d_history + 1;
 
-    // The following algorithm looks more complex in order to handle
-    // the cases where we want more that 1 sps for each
-    // channel. Otherwise, this would boil down into a single loop
-    // that operates from input_items[0] to [d_nfilts].
+    // The filterbank works through a tile of time steps at a time: every branch filter
+    // runs over the whole tile and one batched FFT de-spins it.
 
     // When dealing with osps>1, we start not at the last filter,
     // but nfilts/osps and then wrap around to the next symbol into
@@ -136,44 +136,27 @@ pfb_channelizer_cpu<T>::work(std::vector<block_work_input_sptr>& work_input,
     // fred harris, Multirate Signal Processing For Communication
     // Systems. Upper Saddle River, NJ: Prentice Hall, 2004.
 
-    int n = 1, i = -1, j = 0, oo = 0, last;
-    int toconsume = (int)rintf(noutput_items / d_oversample_rate);
-    while (n <= toconsume) {
-        j = 0;
-        i = (i + d_rate_ratio) % d_nfilts;
-        last = i;
-        while (i >= 0) {
-            // in = work_input[j]->items<gr_complex>();
-            in = d_deinterleaved[j].data();
-            d_fft.get_inbuf()[d_idxlut[j]] = d_fir_filters[i].filter(&in[n]);
-            j++;
-            i--;
-        }
-
-        i = d_nfilts - 1;
-        while (i > last) {
-            // in = work_input[j]->items<gr_complex>();
-            in = d_deinterleaved[j].data();
-            d_fft.get_inbuf()[d_idxlut[j]] = d_fir_filters[i].filter(&in[n - 1]);
-            j++;
-            i--;
-        }
-
-        n += (i + d_rate_ratio) >= (int)d_nfilts;
+    d_branch_ptrs.resize(d_nchans);
+    for (size_t j = 0; j < d_nchans; j++) {
+        d_branch_ptrs[j] = d_deinterleaved[j].data();
+    }
+    d_out_ptrs.resize(noutputs);
+    for (size_t nn = 0; nn < noutputs; nn++) {
+        d_out_ptrs[nn] = work_output[nn]->items<gr_complex>();
+    }
 
-        // despin through FFT
-        d_fft.execute();
+    int toconsume = (int)rintf(noutput_items / d_oversample_rate);
+    auto nsteps = channelize(d_out_ptrs.data(),
+                             noutputs,
+                             d_branch_ptrs.data(),
+                             toconsume,
+                             d_rate_ratio,
+                             d_idxlut,
+                             d_channel_map);
 
-        // Send to output channels
-        for (unsigned int nn = 0; nn < noutputs; nn++) {
-            out = work_output[nn]->items<gr_complex>();
-            out[oo] = d_fft.get_outbuf()[d_channel_map[nn]];
-        }
-        oo++;
-    }
     this->consume_each(toconsume * d_nchans, work_input);
     // this->produce_each(noutput_items - (d_history / d_nchans - 1), work_output);
-    this->produce_each(noutput_items, work_output);
+    this->produce_each(nsteps, work_output);
     return work_return_code_t::WORK_OK;
 }
 
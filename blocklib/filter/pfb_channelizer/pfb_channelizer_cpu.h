@@ -45,6 +45,9 @@ private:
     size_t d_nchans;
 
     std::vector<std::vector<T>> d_deinterleaved;
+    std::vector<void*> d_deinterleaved_ptrs;
+    std::vector<const gr_complex*> d_branch_ptrs;
+    std::vector<gr_complex*> d_out_ptrs;
 };
 
 
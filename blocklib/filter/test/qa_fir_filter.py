@@ -191,6 +191,44 @@ class test_filter(gr_unittest.TestCase):
         result_data = dst.data()
         self.assertComplexTuplesAlmostEqual(expected_data, result_data, 5)
 
+    def test_fir_filter_fff_fft(self):
+        # Enough taps for overlap-save, over several transforms
+        decim = 2
+        taps = [0.01 * math.cos(0.05 * k) for k in range(257)]
+        src_data = [math.sin(0.01 * n) + math.cos(0.37 * n) for n in range(20000)]
+        expected_data = fir_filter(src_data, taps, decim)
+
+        src = blocks.vector_source_f(src_data)
+        op = filter.fir_filter_fff(decim, taps)
+        dst = blocks.vector_sink_f()
+        self.tb.connect((src, op, dst))
+        self.tb.run()
+        result_data = dst.data()
+        self.assertEqual(len(expected_data), len(result_data))
+        self.assertFloatTuplesAlmostEqual(expected_data, result_data, 4)
+
+    def test_fir_filter_ccc_fft_direct(self):
+        # A transform needs 766 * 3 input items, and 258 more once the filter is
+        # primed.  Reads of 2400 items make it alternate between overlap-save and the
+        # direct form, each restarting where the other stopped.
+        decim = 3
+        taps = [0.01 * complex(math.cos(0.05 * k), math.sin(0.02 * k))
+                for k in range(257)]
+        src_data = [complex(math.sin(0.01 * n), math.cos(0.37 * n))
+                    for n in range(20000)]
+        expected_data = fir_filter(src_data, taps, decim)
+
+        src = blocks.vector_source_c(src_data)
+        op = filter.fir_filter_ccc(decim, taps)
+        dst = blocks.vector_sink_c()
+        self.tb.connect((src, 0), (op, 0)).set_custom_buffer(
+            gr.buffer_cpu_vmcirc_properties.make().set_max_buffer_read(2400))
+        self.tb.connect((op, 0), (dst, 0))
+        self.tb.run()
+        result_data = dst.data()
+        self.assertEqual(len(expected_data), len(result_data))
+        self.assertComplexTuplesAlmostEqual(expected_data, result_data, 4)
+
 
 if __name__ == '__main__':
     gr_unittest.run(test_filter)
@@ -11,6 +11,7 @@
 #include "deinterleave_cpu.h"
 #include "deinterleave_cpu_gen.h"
 
+#include <gnuradio/kernel/streamops/deinterleave.h>
 #include <algorithm>
 
 namespace gr {
@@ -47,35 +48,27 @@ deinterleave_cpu::work(std::vector<block_work_input_sptr>& work_input,
     if (min_output < 1) {
         return work_return_code_t::WORK_INSUFFICIENT_INPUT_ITEMS;
     }
+    // Whole passes over the outputs only, so every call starts at the first output
     noutput_items = std::min(noutput_items, min_output);
+    noutput_items -= noutput_items % blocksize;
+    if (noutput_items == 0) {
+        return work_return_code_t::WORK_INSUFFICIENT_OUTPUT_ITEMS;
+    }
     ninput_items = noutput_items * nstreams;
 
-    auto in = work_input[0]->items<uint8_t>();
-    int count = 0, totalcount = noutput_items * nstreams;
-    unsigned int skip = 0;
-    unsigned int acc = 0;
-    while (count < totalcount) {
-        auto out = work_output[d_current_output]->items<uint8_t>();
-        memcpy(out + skip * d_size_bytes, in, d_size_bytes);
-        in += d_size_bytes;
-        // produce(d_current_output, blocksize);
-        work_output[d_current_output]->n_produced += blocksize;
-        d_current_output = (d_current_output + 1) % nstreams;
-
-        // accumulate times through the loop; increment skip after a
-        // full pass over the output streams.
-        // This is separate than d_current_output since we could be in
-        // the middle of a loop when we exit.
-        acc++;
-        if (acc >= nstreams) {
-            skip++;
-            acc = 0;
-        }
-
-        // Keep track of our loop counter
-        count += blocksize;
+    d_out.resize(nstreams);
+    for (size_t j = 0; j < nstreams; j++) {
+        d_out[j] = work_output[j]->raw_items();
+        work_output[j]->n_produced = noutput_items;
     }
-    consume_each(totalcount, work_input);
+
+    // A block of items is deinterleaved as a single item of blocksize times the size
+    kernel::streamops::deinterleave(d_out.data(),
+                                    work_input[0]->raw_items(),
+                                    nstreams,
+                                    noutput_items / blocksize,
+                                    d_size_bytes);
+    consume_each(ninput_items, work_input);
     return work_return_code_t::WORK_OK;
 }
 
@@ -23,7 +23,7 @@ public:
                                     std::vector<block_work_output_sptr>& work_output) override;
 
 private:
-    size_t d_current_output = 0;
+    std::vector<void*> d_out;
     size_t d_size_bytes = 0; // block size in bytes
 };
 
@@ -27,8 +27,10 @@ work_return_code_t probe_signal_cpu<T>::work(std::vector<block_work_input_sptr>&
     auto in = work_input[0]->items<T>();
     auto ninput_items = work_input[0]->n_items;
 
-    if (ninput_items > 0)
+    if (ninput_items > 0) {
         *this->param_level = in[ninput_items-1];
+        this->update_param_snapshot(this->id_level);
+    }
 
     this->consume_each(ninput_items, work_input);
     return work_return_code_t::WORK_OK;
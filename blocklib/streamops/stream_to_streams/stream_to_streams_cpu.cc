@@ -10,7 +10,7 @@
 
 #include "stream_to_streams_cpu.h"
 #include "stream_to_streams_cpu_gen.h"
-#include <volk/volk.h>
+#include <gnuradio/kernel/streamops/deinterleave.h>
 
 namespace gr {
 namespace streamops {
@@ -24,9 +24,6 @@ work_return_code_t
 stream_to_streams_cpu::work(std::vector<block_work_input_sptr>& work_input,
                             std::vector<block_work_output_sptr>& work_output)
 {
-    auto in = work_input[0]->items<uint8_t>();
-
-    uint8_t* in_ptr = const_cast<uint8_t*>(in);
     auto noutput_items = work_output[0]->n_items;
     auto ninput_items = work_input[0]->n_items;
     size_t nstreams = work_output.size();
@@ -34,12 +31,12 @@ stream_to_streams_cpu::work(std::vector<block_work_input_sptr>& work_input,
     auto total_items = std::min(ninput_items / nstreams, (size_t)noutput_items);
     auto itemsize = work_output[0]->buffer->item_size();
 
-    for (size_t i = 0; i < total_items; i++) {
-        for (size_t j = 0; j < nstreams; j++) {
-            memcpy(work_output[j]->items<uint8_t>() + i * itemsize, in_ptr, itemsize);
-            in_ptr += itemsize;
-        }
+    d_out.resize(nstreams);
+    for (size_t j = 0; j < nstreams; j++) {
+        d_out[j] = work_output[j]->raw_items();
     }
+    kernel::streamops::deinterleave(
+        d_out.data(), work_input[0]->raw_items(), nstreams, total_items, itemsize);
 
     produce_each(total_items, work_output);
     consume_each(total_items * nstreams, work_input);
@@ -23,6 +23,9 @@ public:
     work_return_code_t
     work(std::vector<block_work_input_sptr>& work_input,
          std::vector<block_work_output_sptr>& work_output) override;
+
+private:
+    std::vector<void*> d_out;
 };
 
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -10,6 +11,7 @@
 #include <gnuradio/neighbor_interface.h>
 #include <gnuradio/node.h>
 #include <gnuradio/parameter.h>
+#include <gnuradio/perf_counters.h>
 
 #include <pmtf/map.hpp>
 #include <pmtf/string.hpp>
@@ -35,9 +37,15 @@ private:
     const std::string s_module;
     std::string d_suffix = "";
     tag_propagation_policy_t d_tag_propagation_policy;
+    bool d_consumes_tags = true;
+    bool d_inplace = false;
+    bool d_strided_input = false;
     size_t d_output_multiple = 1;
     bool d_output_multiple_set = false;
     double d_relative_rate = 1.0;
+    size_t d_min_input_items = 0;
+    size_t d_min_work_items = 0;
+    block_perf_counters d_perf_counters;
 
 protected:
     neighbor_interface_sptr p_scheduler = nullptr;
@@ -72,6 +80,45 @@ public:
 
     tag_propagation_policy_t tag_propagation_policy();
     void set_tag_propagation_policy(tag_propagation_policy_t policy);
+
+    /**
+     * @brief Whether the work function reads tags from its inputs
+     *
+     * Set from the consumes_tags field of the block YAML.  Tags are only kept on edges
+     * that lead to a block that reads them, either directly or through blocks that
+     * propagate them.  Blocks not generated from YAML are assumed to read tags.
+     */
+    bool consumes_tags() const { return d_consumes_tags; }
+    void set_consumes_tags(bool consumes_tags) { d_consumes_tags = consumes_tags; }
+
+    /**
+     * @brief Whether the work function gives the same results when its output points
+     * at the same memory as its input
+     *
+     * Set from the inplace field of the block YAML.  When enabled on the scheduler, the
+     * output of such a block can reuse the memory of its input buffer instead of a
+     * buffer of its own (see buffer_cpu_inplace).
+     */
+    bool inplace() const { return d_inplace; }
+    void set_inplace(bool inplace) { d_inplace = inplace; }
+
+    /**
+     * @brief Whether the work function can read its inputs from strided edges
+     *
+     * Set from the strided_input field of the block YAML.  Such a block indexes item i
+     * of an input at items<T>()[i * stride()] (see block_work_input::stride), so it can
+     * be the destination of an edge set up with edge::set_stride.
+     */
+    bool strided_input() const { return d_strided_input; }
+    void set_strided_input(bool strided_input) { d_strided_input = strided_input; }
+
+    /**
+     * @brief Counters of work calls, items, time in work and blocking
+     *
+     * Updated by the scheduler thread running the block on every work call; call
+     * snapshot() on them from any thread to read them while the flowgraph runs.
+     */
+    block_perf_counters& perf_counters() { return d_perf_counters; }
     void set_pyblock_detail(std::shared_ptr<pyblock_detail> p);
     std::shared_ptr<pyblock_detail> pb_detail();
     /**
@@ -112,15 +159,98 @@ public:
     {
         return request_parameter_query(get_param_id(param_str));
     }
-    void request_parameter_change(int param_id, pmtf::pmt new_value, bool block = true);
+
+    /**
+     * @brief Query a parameter without waiting for the thread running the block
+     *
+     * The returned future becomes ready once the owning thread has serviced the query,
+     * so many queries can be in flight at once.  If the scheduler stops with the query
+     * still queued, the query is dropped and get() on the future throws std::future_error
+     * with std::future_errc::broken_promise.
+     *
+     * A block that stands for a remote block (rpc_client() is set) is queried over the
+     * rpc client on the calling thread, so the call blocks for the round trip and returns
+     * a future that is already ready.
+     *
+     * @param param_id
+     * @return std::future<pmtf::pmt>
+     */
+    std::future<pmtf::pmt> request_parameter_query_async(int param_id);
+    std::future<pmtf::pmt> request_parameter_query_async(const std::string& param_str)
+    {
+        return request_parameter_query_async(get_param_id(param_str));
+    }
+
+    /**
+     * @brief Query several parameters of this block in a single round trip to the
+     * thread running it
+     *
+     * Remote blocks are queried in a single rpc request.  Errors and blocking as for
+     * request_parameter_query_async.
+     *
+     * @param param_ids
+     * @return std::future<std::vector<pmtf::pmt>> values in the order of param_ids
+     */
+    std::future<std::vector<pmtf::pmt>>
+    request_parameters_query_async(const std::vector<int>& param_ids);
+    std::vector<pmtf::pmt>
+    request_parameters_query(const std::vector<std::string>& param_strs);
+    /**
+     * @brief Change the value of a parameter while the flowgraph is running
+     *
+     * @param param_id
+     * @param new_value
+     * @param block wait until the change has been applied
+     * @param at_sample absolute sample index at which the change takes effect, counted
+     * on the first input port, or the first output port for a source.  Work calls are
+     * split so that the change is applied exactly before this sample.  0 applies the
+     * change as soon as possible.
+     */
+    void request_parameter_change(int param_id,
+                                  pmtf::pmt new_value,
+                                  bool block = true,
+                                  uint64_t at_sample = 0);
     void request_parameter_change(const std::string& param_str,
                                   pmtf::pmt new_value,
-                                  bool block = true)
+                                  bool block = true,
+                                  uint64_t at_sample = 0)
     {
-        return request_parameter_change(get_param_id(param_str), new_value, block);
+        return request_parameter_change(
+            get_param_id(param_str), new_value, block, at_sample);
     };
+
+    /**
+     * @brief Change a parameter without waiting for the thread running the block
+     *
+     * Errors and blocking as for request_parameter_query_async.
+     *
+     * @param param_id
+     * @param new_value
+     * @param at_sample see request_parameter_change
+     * @return std::future<void> ready once the change has been applied
+     */
+    std::future<void> request_parameter_change_async(int param_id,
+                                                     pmtf::pmt new_value,
+                                                     uint64_t at_sample = 0);
+    std::future<void> request_parameter_change_async(const std::string& param_str,
+                                                     pmtf::pmt new_value,
+                                                     uint64_t at_sample = 0)
+    {
+        return request_parameter_change_async(
+            get_param_id(param_str), new_value, at_sample);
+    }
     virtual void on_parameter_change(param_action_sptr action);
     virtual void on_parameter_query(param_action_sptr action);
+
+    /**
+     * @brief Refresh the typed snapshot of a parameter from its pmt
+     *
+     * Overridden by the generated block classes, called whenever the parameter pmt has
+     * been changed so that work() can read the value without decoding the pmt
+     *
+     * @param param_id
+     */
+    virtual void update_param_snapshot(int param_id) {}
     static void consume_each(size_t num, std::vector<block_work_input_sptr>& work_input);
     static void produce_each(size_t num, std::vector<block_work_output_sptr>& work_output);
     void set_output_multiple(size_t multiple);
@@ -129,6 +259,30 @@ public:
     void set_relative_rate(double relative_rate) { d_relative_rate = relative_rate; }
     double relative_rate() const { return d_relative_rate; }
 
+    /**
+     * @brief Set the number of input items work() needs before it can produce anything
+     *
+     * e.g. the history of a filter.  Buffers feeding the block are sized to hold at
+     * least twice this many items.
+     *
+     * @param min_items
+     */
+    void set_min_input_items(size_t min_items) { d_min_input_items = min_items; }
+    size_t min_input_items() const { return d_min_input_items; }
+
+    /**
+     * @brief Ask the scheduler to call work() with at least this many items
+     *
+     * Work is held back until every input has this many items and every output room
+     * for them, except at the end of the stream.  Blocks with a high cost per call, such
+     * as those implemented in Python, use it to be called less often on larger chunks.
+     * Buffers around the block are sized to hold at least twice this many items.
+     *
+     * @param min_items
+     */
+    void set_min_work_items(size_t min_items) { d_min_work_items = min_items; }
+    size_t min_work_items() const { return d_min_work_items; }
+
     virtual int get_param_id(const std::string& id) { return d_param_str_map[id]; }
     virtual std::string get_param_str(const int id) { return d_str_param_map[id]; }
     virtual std::string suffix() { return ""; }
@@ -5,9 +5,21 @@
 
 namespace gr {
 
+/**
+ * @brief How a scheduler thread waits for its next message once it runs out of work
+ *
+ */
+enum class wait_policy_t {
+    BLOCK,           // sleep in the message queue until a message arrives
+    SPIN_THEN_BLOCK, // poll the queue spin_count times before going to sleep
+    BUSY_POLL,       // never sleep, keep polling the queue
+};
+
 class block_group_properties
 {
 public:
+    static constexpr unsigned int default_spin_count = 10000;
+
     block_group_properties(const std::vector<block_sptr>& blocks,
                            const std::string& name = "",
                            const std::vector<unsigned int>& affinity_mask = {})
@@ -39,6 +51,45 @@ public:
      */
     std::vector<unsigned int> processor_affinity() { return _affinity_mask; }
 
+    /**
+     * @brief Set how the thread running this group waits for messages
+     *
+     * Spinning trades CPU time for lower wake-up latency, since a thread that is asleep
+     * in the queue has to be woken up by the kernel for every notification.
+     *
+     * @param policy
+     * @param spin_count number of polls before blocking, for SPIN_THEN_BLOCK
+     */
+    void set_wait_policy(wait_policy_t policy,
+                         unsigned int spin_count = default_spin_count)
+    {
+        _wait_policy = policy;
+        _spin_count = spin_count;
+        _wait_policy_set = true;
+    }
+
+    wait_policy_t wait_policy() const { return _wait_policy; }
+    unsigned int spin_count() const { return _spin_count; }
+
+    /**
+     * @brief Whether the wait policy was set explicitly, rather than left for the
+     * scheduler to decide
+     */
+    bool wait_policy_set() const { return _wait_policy_set; }
+
+    /**
+     * @brief Run the blocks as a fused chain
+     *
+     * The blocks are called in order, over and over, for as long as every one of them
+     * makes progress, so that a small buffer between them is enough to pass a tile of
+     * items all the way down the chain.  Meant for the chains found by
+     * graph_utils::sync_chains, whose internal edges get tile buffers.
+     *
+     * @param fused
+     */
+    void set_fused(bool fused) { _fused = fused; }
+    bool fused() const { return _fused; }
+
 
     /**
      * @brief Get the vector of blocks
@@ -59,6 +110,10 @@ private:
     std::string _name;
     bool _affinity_set = false;
     std::vector<unsigned int> _affinity_mask;
+    wait_policy_t _wait_policy = wait_policy_t::BLOCK;
+    unsigned int _spin_count = default_spin_count;
+    bool _wait_policy_set = false;
+    bool _fused = false;
 };
 
 } // namespace gr
\ No newline at end of file
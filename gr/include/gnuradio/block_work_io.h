@@ -31,6 +31,14 @@ struct block_work_input {
     }
     const void* raw_items() const { return buffer->read_ptr(); }
 
+    /**
+     * @brief Distance in items between consecutive items of the input
+     *
+     * Greater than 1 when the edge reads a strided view of its buffer (see
+     * edge::set_stride), in which case item i is at items<T>()[i * stride()]
+     */
+    size_t stride() const { return buffer->stride(); }
+
     uint64_t nitems_read() { return buffer->total_read(); }
 
     void consume(int num) { n_consumed = num; }
@@ -40,6 +48,21 @@ struct block_work_input {
         return buffer->tags_in_window(item_start, item_end);
     }
 
+    /**
+     * @brief Tags on the items available to this work call
+     *
+     * Tags are only looked up when this is called.  They are copied into a vector owned
+     * by this input and reused from one call to the next, so no lock is held once this
+     * returns and a steady flow of tags does not allocate.  The reference is valid until
+     * the next call.
+     */
+    const std::vector<tag_t>& tags()
+    {
+        auto n_read = buffer->total_read();
+        buffer->tags_in_range(n_read, n_read + n_items, _tags);
+        return _tags;
+    }
+
     static std::vector<const void*> all_items(const std::vector<sptr>& work_inputs)
     {
         std::vector<const void*> ret(work_inputs.size());
@@ -57,6 +80,10 @@ struct block_work_input {
             }));
         return (*result)->n_items;
     }
+
+private:
+    // filled by tags()
+    std::vector<tag_t> _tags;
 };
 
 using block_work_input_sptr = block_work_input::sptr;
@@ -3,10 +3,14 @@
 #include <gnuradio/api.h>
 #include <gnuradio/logger.h>
 #include <gnuradio/neighbor_interface.h>
+#include <gnuradio/perf_counters.h>
 #include <gnuradio/tag.h>
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <vector>
 
 namespace gr {
@@ -30,6 +34,7 @@ class buffer_reader;
 using buffer_reader_sptr = std::shared_ptr<buffer_reader>;
 
 class buffer;
+class buffer_cpu_inplace;
 class buffer_properties;
 using buffer_factory_function = std::function<std::shared_ptr<buffer>(
     size_t, size_t, std::shared_ptr<buffer_properties>)>;
@@ -37,6 +42,25 @@ using buffer_factory_function = std::function<std::shared_ptr<buffer>(
 using buffer_reader_factory_function = std::function<std::shared_ptr<buffer_reader>(
     size_t, std::shared_ptr<buffer_properties>)>;
 
+/**
+ * @brief Tags held by a buffer, kept sorted by offset
+ *
+ * Tags with equal offsets keep the order in which they were added.  Since the readers
+ * consume the buffer in order, the oldest tags are always at the front, and pruning
+ * is a pop from the front.
+ */
+using tag_store = std::deque<tag_t>;
+
+/**
+ * @brief How much of its free space a buffer offers to the writer at once
+ *
+ */
+enum class buffer_fill_policy_t {
+    FRACTION, // at most a fixed fraction of the buffer, half by default
+    FULL,     // all of the free space
+    ADAPTIVE, // all of the free space less twice the typical lag of the slowest reader
+};
+
 /**
  * @brief Base class for passing custom buffer properties into factory method
  *
@@ -97,6 +121,50 @@ public:
 
     auto independent_reader() { return _independent_reader; }
 
+    /**
+     * @brief Set how much of the free space the writer may fill in one go
+     *
+     * Filling only part of the buffer lets the reader work on one part while the writer
+     * fills another, at the cost of more work calls per item.  ADAPTIVE fills more of
+     * the buffer when the readers keep up, and falls back to half when they lag.
+     *
+     * A singly mapped buffer (buffer_sm) moves the unread tail back to the start when
+     * the writer reaches the end, which only works once at least as much has been read
+     * from the front.  Filling more than half of it makes the writer wait for that.
+     *
+     * @param policy
+     * @param fraction of the buffer, for FRACTION, in (0, 1]
+     */
+    auto set_fill_policy(buffer_fill_policy_t policy, double fraction = 0.5)
+    {
+        if (fraction <= 0 || fraction > 1) {
+            throw std::invalid_argument("buffer fill fraction must be in (0, 1]");
+        }
+        _fill_policy = policy;
+        _fill_fraction = fraction;
+        return shared_from_this();
+    }
+    buffer_fill_policy_t fill_policy() { return _fill_policy; }
+    double fill_fraction() { return _fill_fraction; }
+
+    /**
+     * @brief Back the buffer memory with huge pages where the buffer type supports it
+     *
+     * Buffers are rounded up to a multiple of the huge page size, so this is meant for
+     * large buffers where TLB misses matter.  If no huge pages can be allocated, the
+     * buffer falls back to regular pages.
+     *
+     * buffer_cpu_lockfree and the SysV flavor of buffer_cpu_vmcirc (the default) support
+     * it.  The POSIX shm_open flavor of buffer_cpu_vmcirc, whose memory lives on tmpfs,
+     * and buffer_sm ignore it.
+     */
+    auto set_hugepages(bool hugepages)
+    {
+        _hugepages = hugepages;
+        return shared_from_this();
+    }
+    bool hugepages() { return _hugepages; }
+
     virtual std::string to_json() { return "{ }"; }
 
 protected:
@@ -112,6 +180,9 @@ protected:
     buffer_reader_factory_function _brff = nullptr;
 
     bool _independent_reader = false;
+    bool _hugepages = false;
+    buffer_fill_policy_t _fill_policy = buffer_fill_policy_t::FRACTION;
+    double _fill_fraction = 0.5;
 };
 
 /**
@@ -136,10 +207,40 @@ protected:
     void set_type(const std::string& type) { _type = type; }
 
     std::mutex _buf_mutex;
-    std::vector<tag_t> _tags;
+    tag_store _tags;
+    bool _tags_needed = true;
+
+    /**
+     * @brief Insert a tag keeping the store sorted by offset
+     *
+     * Must be called with _buf_mutex held
+     */
+    void insert_tag(tag_t&& tag);
 
     std::vector<buffer_reader*> _readers;
 
+    // set by the writer once it will not produce any more items
+    std::atomic<bool> _eos{ false };
+
+    // set by buffer types that honor buffer_properties::set_hugepages
+    bool _hugepages = false;
+
+    buffer_fill_policy_t _fill_policy = buffer_fill_policy_t::FRACTION;
+    double _fill_fraction = 0.5;
+    // running average of the items the slowest reader has not read yet, for ADAPTIVE
+    double _avg_lag = 0;
+
+    /**
+     * @brief Apply the fill policy to the free space of the buffer
+     *
+     * Must only be called by the writer
+     *
+     * @param space_in_items free space in the buffer
+     * @param n_unread_items items not yet read by the slowest reader
+     * @return size_t number of items the writer may write
+     */
+    size_t fill_limit(size_t space_in_items, uint64_t n_unread_items);
+
     gr::logger_ptr d_logger;
     gr::logger_ptr d_debug_logger;
 
@@ -152,6 +253,10 @@ public:
           _buf_size(num_items * item_size),
           _buf_properties(buf_properties)
     {
+        if (buf_properties) {
+            _fill_policy = buf_properties->fill_policy();
+            _fill_fraction = buf_properties->fill_fraction();
+        }
     }
     virtual ~buffer() {}
     size_t item_size() { return _item_size; }
@@ -159,7 +264,7 @@ public:
     size_t buf_size() { return _buf_size; }
     size_t write_index() { return _write_index; }
     uint64_t total_written() const { return _total_written; }
-    const std::vector<tag_t>& tags() { return _tags; }
+    const tag_store& tags() { return _tags; }
     std::mutex* mutex() { return &_buf_mutex; }
 
     // std::shared_ptr<buffer_properties>& buf_properties() { return _buf_properties; }
@@ -182,6 +287,36 @@ public:
 
     std::vector<buffer_reader*>& readers() { return _readers; }
 
+    /**
+     * @brief Signal that no more items will be written to the buffer
+     *
+     * Must be called after the last post_write, so that a reader that sees the end of
+     * stream also sees every item written before it
+     */
+    void set_eos() { _eos.store(true, std::memory_order_release); }
+    bool eos() const { return _eos.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Whether the buffer has readers and all of them are done reading
+     */
+    bool readers_done();
+
+    /**
+     * @brief Prefer placing the buffer memory on the given NUMA node
+     *
+     * Pages that were already touched are migrated, the rest are allocated on the node
+     * when first written
+     *
+     * @param node
+     * @return true if the memory policy was applied
+     */
+    virtual bool set_numa_node(int node);
+
+    /**
+     * @brief Whether the buffer memory ended up backed by huge pages
+     */
+    bool hugepages() const { return _hugepages; }
+
 
     /**
      * @brief Return the pointer into the buffer at the given index
@@ -208,6 +343,14 @@ public:
     virtual bool write_info(buffer_info_t& info);
     virtual size_t space_available();
 
+    /**
+     * @brief Bytes written that the slowest reader has not released yet
+     *
+     * Includes the bytes that in-place buffers downstream of the readers still hold in
+     * this buffer's memory
+     */
+    virtual uint64_t bytes_unread();
+
 
     /**
      * @brief Add Tags onto the tag queue
@@ -217,7 +360,31 @@ public:
      */
     void add_tags(size_t num_items, std::vector<tag_t>& tags);
 
-    const std::vector<tag_t>& tags() const { return _tags; }
+    const tag_store& tags() const { return _tags; }
+
+    /**
+     * @brief Whether any block downstream of this buffer reads the tags
+     *
+     * When no reader (directly or through tag propagation) consumes tags, adding and
+     * propagating tags into this buffer are no-ops
+     */
+    bool tags_needed() const { return _tags_needed; }
+    void set_tags_needed(bool tags_needed) { _tags_needed = tags_needed; }
+
+    /**
+     * @brief Return the range of tags with offsets in [start, end)
+     *
+     * Offsets are compared after being scaled into the units of a reader whose item
+     * size differs from the buffer item size.  Lookup is a binary search over the sorted
+     * tag store.  Must be called with the buffer mutex held.
+     *
+     * @param start first offset of the window
+     * @param end one past the last offset of the window
+     * @param relative_rate reader item size divided by buffer item size
+     * @return std::pair of iterators delimiting the tags in the window
+     */
+    std::pair<tag_store::const_iterator, tag_store::const_iterator>
+    tag_range(uint64_t start, uint64_t end, double relative_rate = 1.0) const;
 
     void add_tag(tag_t tag);
     void add_tag(uint64_t offset, tag_map map);
@@ -281,11 +448,24 @@ class GR_RUNTIME_API buffer_reader
 protected:
     buffer_sptr _buffer; // the buffer that owns this reader
     std::shared_ptr<buffer_properties> _buf_properties;
-    uint64_t _total_read = 0;
+    // read by the writer of an in-place buffer on top of this reader
+    std::atomic<uint64_t> _total_read{ 0 };
     size_t _itemsize;
     size_t _read_index = 0;
     std::mutex _rdr_mutex;
 
+    // strided view of the buffer, in items of the buffer
+    size_t _offset = 0;
+    size_t _stride = 1;
+
+    // set by the reading block once it will not read any more items
+    std::atomic<bool> _done{ false };
+
+    // in-place buffer whose items are written over the items this reader has read
+    buffer_cpu_inplace* _inplace_buffer = nullptr;
+
+    edge_perf_counters _perf_counters;
+
 
 public:
     buffer_reader(buffer_sptr buffer,
@@ -301,9 +481,12 @@ public:
     virtual ~buffer_reader() {}
     size_t read_index() { return _read_index; }
     void set_read_index(size_t r) { _read_index = r; }
-    virtual void* read_ptr() { return _buffer->read_ptr(_read_index); }
+    virtual void* read_ptr()
+    {
+        return _buffer->read_ptr(_read_index + _offset * _buffer->item_size());
+    }
     virtual void post_read(int num_items) = 0;
-    uint64_t total_read() const { return _total_read; }
+    uint64_t total_read() const { return _total_read.load(std::memory_order_acquire); }
     // std::shared_ptr<buffer_properties>& buf_properties() { return _buf_properties; }
     size_t max_buffer_read()
     {
@@ -316,8 +499,80 @@ public:
     size_t item_size() { return _itemsize; }
     size_t buffer_item_size() { return _buffer->item_size(); }
 
+    /**
+     * @brief Read only every stride'th item of the buffer, starting at offset
+     *
+     * N readers with offsets 0..N-1 and a stride of N deinterleave the stream without
+     * copying it.  Each item of this reader is a frame of stride buffer items, so
+     * items_available, post_read and tag offsets all count frames.  The read pointer
+     * points at item offset of the current frame, and item i of the view is found
+     * i * stride buffer items after it.
+     *
+     * @param offset index of the item to read within each frame
+     * @param stride number of buffer items per frame
+     */
+    void set_stride(size_t offset, size_t stride);
+    size_t stride() const { return _stride; }
+    size_t offset() const { return _offset; }
+
     std::mutex* mutex() { return &_rdr_mutex; }
 
+    /**
+     * @brief Tell the reader that its items are reused as the memory of another buffer
+     *
+     * The writer of this reader's buffer may then only write over items once the
+     * readers of the in-place buffer have released them as well
+     */
+    void set_inplace_buffer(buffer_cpu_inplace* inplace_buffer)
+    {
+        _inplace_buffer = inplace_buffer;
+    }
+
+    /**
+     * @brief Bytes already read that the in-place buffer on top of this reader still
+     * holds, 0 if there is none
+     *
+     * Must be called after bytes_available when both are added up, so that items read
+     * in between are counted by one of them
+     */
+    uint64_t inplace_bytes_unread();
+
+    /**
+     * @brief Counters of the edge this reader is the destination of
+     *
+     * Updated by the thread running the reading block
+     */
+    edge_perf_counters& perf_counters() { return _perf_counters; }
+
+    /**
+     * @brief Fraction of the buffer holding items this reader has not read
+     */
+    double occupancy()
+    {
+        return _buffer->buf_size() ? (double)bytes_available() / _buffer->buf_size()
+                                   : 0;
+    }
+
+    /**
+     * @brief Whether the writer has signalled that no more items will be written
+     *
+     * Items written before the end of stream may still be waiting to be read
+     */
+    virtual bool eos() const { return _buffer->eos(); }
+
+    /**
+     * @brief Whether the end of stream of the writer is visible to this reader
+     *
+     * False when the writer lives in another process
+     */
+    virtual bool propagates_eos() const { return true; }
+
+    /**
+     * @brief Signal that the reading block will not read any more items
+     */
+    void set_done() { _done.store(true, std::memory_order_release); }
+    bool done() const { return _done.load(std::memory_order_acquire); }
+
     /**
      * @brief Return the number of items available to be read
      *
@@ -349,6 +604,30 @@ public:
 
     std::vector<tag_t> tags_in_window(const uint64_t item_start, const uint64_t item_end);
 
+    /**
+     * @brief Return the tags between two absolute offsets
+     *
+     * @param abs_start first absolute offset, in items of this reader
+     * @param abs_end one past the last absolute offset, in items of this reader
+     * @return std::vector<tag_t> tags with offsets converted to items of this reader
+     */
+    std::vector<tag_t> tags_in_range(const uint64_t abs_start, const uint64_t abs_end);
+
+    /**
+     * @brief Copy the tags between two absolute offsets into tags
+     *
+     * tags is cleared first and keeps its capacity, so a caller reusing the same vector
+     * stops allocating once it has grown to the usual number of tags.  The buffer mutex
+     * is only held while copying.
+     *
+     * @param abs_start first absolute offset, in items of this reader
+     * @param abs_end one past the last absolute offset, in items of this reader
+     * @param tags receives the tags, with offsets converted to items of this reader
+     */
+    void tags_in_range(const uint64_t abs_start,
+                       const uint64_t abs_end,
+                       std::vector<tag_t>& tags);
+
     /**
      * @brief Return the tags associated with this buffer
      *
@@ -359,7 +638,7 @@ public:
      */
     virtual std::vector<tag_t> get_tags(size_t num_items);
 
-    virtual const std::vector<tag_t>& tags() const;
+    virtual const tag_store& tags() const;
 
     void set_parent_intf(neighbor_interface_sptr sched) { p_scheduler = sched; }
     void notify_scheduler();
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <gnuradio/buffer.h>
+#include <atomic>
+#include <vector>
+
+// Output buffer of a block that writes its results over the items it reads
+//
+// The buffer has no memory of its own.  Its write pointer is the read pointer of the
+// block's input, so a sync block that produces as many items as it consumes writes each
+// result where the input item was.  Readers of this buffer then read from the memory of
+// the upstream buffer, whose writer is held back until they have released it (see
+// bytes_held).  The upstream buffer has to be doubly mapped, so that items
+// never wrap.
+
+namespace gr {
+
+class buffer_cpu_inplace_reader;
+
+class buffer_cpu_inplace : public buffer
+{
+private:
+    std::shared_ptr<buffer_reader> _src_reader;
+    buffer_sptr _src_buffer;
+
+    // monotonically increasing count of bytes written, published to the readers
+    alignas(64) std::atomic<uint64_t> _bytes_written{ 0 };
+
+    // bytes src_reader had read when the buffer was created
+    uint64_t _src_bytes_base;
+
+public:
+    using sptr = std::shared_ptr<buffer_cpu_inplace>;
+
+    /**
+     * @brief Create a buffer on top of the items read by src_reader
+     *
+     * @param src_reader reader of the in-place block's input
+     * @param src_buffer buffer src_reader reads from
+     */
+    static buffer_sptr make(std::shared_ptr<buffer_reader> src_reader,
+                            buffer_sptr src_buffer);
+
+    buffer_cpu_inplace(std::shared_ptr<buffer_reader> src_reader, buffer_sptr src_buffer);
+    ~buffer_cpu_inplace() override;
+
+    /**
+     * @brief Whether the memory of buf can be written to in place
+     *
+     * Only doubly mapped buffers can, as the block writes as many contiguous items as it
+     * reads
+     */
+    static bool supports(buffer_sptr buf);
+
+    void* read_ptr(size_t index) override { return _src_buffer->read_ptr(index); }
+    void* write_ptr() override { return _src_reader->read_ptr(); }
+
+    uint64_t bytes_written() const
+    {
+        return _bytes_written.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Bytes read by the block from the upstream buffer that the readers of this
+     * buffer have not released yet
+     *
+     * Counted from what src_reader has read rather than from what was written here, so
+     * that items the block has written over but not posted yet are held as well
+     */
+    uint64_t bytes_held();
+
+    bool write_info(buffer_info_t& info) override;
+    size_t space_available() override;
+    void post_write(int num_items) override;
+
+    std::shared_ptr<buffer_reader>
+    add_reader(std::shared_ptr<buffer_properties> buf_props, size_t itemsize) override;
+};
+
+class buffer_cpu_inplace_reader : public buffer_reader
+{
+private:
+    buffer_cpu_inplace* _inplace;
+
+    // monotonically increasing count of bytes read, published to the upstream writer
+    alignas(64) std::atomic<uint64_t> _bytes_read;
+
+public:
+    buffer_cpu_inplace_reader(buffer_sptr buffer,
+                              std::shared_ptr<buffer_properties> buf_props,
+                              size_t itemsize,
+                              uint64_t bytes_read = 0)
+        : buffer_reader(buffer, buf_props, itemsize, buffer->write_index()),
+          _inplace(static_cast<buffer_cpu_inplace*>(buffer.get())),
+          _bytes_read(bytes_read)
+    {
+    }
+
+    uint64_t bytes_read() const { return _bytes_read.load(std::memory_order_acquire); }
+    uint64_t bytes_available() override;
+    void post_read(int num_items) override;
+};
+
+} // namespace gr
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <gnuradio/buffer.h>
+#include <atomic>
+#include <string>
+
+// Doubly mapped circular buffer with lock-free read/write indices
+//
+// The writer publishes the number of bytes written with release semantics after the
+// data has been copied in, and each reader publishes the number of bytes it has consumed
+// the same way.  Since every index has exactly one thread that modifies it, neither
+// post_write nor post_read need to take a mutex, and any number of readers can be
+// attached to the same buffer.
+
+namespace gr {
+
+class buffer_cpu_lockfree_reader;
+
+class buffer_cpu_lockfree : public buffer
+{
+private:
+    uint8_t* _buffer = nullptr;
+    void* _mapped_base = nullptr;
+    size_t _mapped_size = 0;
+
+    // monotonically increasing count of bytes written, published to the readers
+    alignas(64) std::atomic<uint64_t> _bytes_written{ 0 };
+
+    std::vector<buffer_cpu_lockfree_reader*> _lockfree_readers;
+
+    bool
+    map_buffer(size_t num_items, size_t item_size, size_t granularity, bool hugepages);
+
+public:
+    using sptr = std::shared_ptr<buffer_cpu_lockfree>;
+
+    static buffer_sptr make(size_t num_items,
+                            size_t item_size,
+                            std::shared_ptr<buffer_properties> buffer_properties);
+
+    buffer_cpu_lockfree(size_t num_items,
+                        size_t item_size,
+                        std::shared_ptr<buffer_properties> buf_properties);
+    ~buffer_cpu_lockfree() override;
+
+    void* read_ptr(size_t index) override { return (void*)&_buffer[index]; }
+    void* write_ptr() override { return (void*)&_buffer[_write_index]; }
+
+    uint64_t bytes_written() const
+    {
+        return _bytes_written.load(std::memory_order_acquire);
+    }
+
+    bool write_info(buffer_info_t& info) override;
+    size_t space_available() override;
+    void post_write(int num_items) override;
+
+    std::shared_ptr<buffer_reader>
+    add_reader(std::shared_ptr<buffer_properties> buf_props, size_t itemsize) override;
+};
+
+class buffer_cpu_lockfree_reader : public buffer_reader
+{
+private:
+    buffer_cpu_lockfree* _lockfree_buffer;
+
+    // monotonically increasing count of bytes read, published to the writer
+    alignas(64) std::atomic<uint64_t> _bytes_read;
+
+public:
+    buffer_cpu_lockfree_reader(buffer_sptr buffer,
+                               std::shared_ptr<buffer_properties> buf_props,
+                               size_t itemsize,
+                               uint64_t bytes_read = 0)
+        : buffer_reader(buffer, buf_props, itemsize, bytes_read % buffer->buf_size()),
+          _lockfree_buffer(static_cast<buffer_cpu_lockfree*>(buffer.get())),
+          _bytes_read(bytes_read)
+    {
+    }
+
+    uint64_t bytes_read() const { return _bytes_read.load(std::memory_order_acquire); }
+
+    uint64_t bytes_available() override;
+    void post_read(int num_items) override;
+};
+
+class buffer_cpu_lockfree_properties : public buffer_properties
+{
+public:
+    buffer_cpu_lockfree_properties() : buffer_properties()
+    {
+        _bff = buffer_cpu_lockfree::make;
+    }
+    static std::shared_ptr<buffer_properties> make()
+    {
+        return std::static_pointer_cast<buffer_properties>(
+            std::make_shared<buffer_cpu_lockfree_properties>());
+    }
+};
+
+} // namespace gr
+
+#define BUFFER_CPU_LOCKFREE_ARGS buffer_cpu_lockfree_properties::make()
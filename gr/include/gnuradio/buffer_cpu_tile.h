@@ -0,0 +1,69 @@
+#pragma once
+
+#include <gnuradio/buffer.h>
+#include <cstdint>
+#include <vector>
+
+// Small linear buffer between blocks that run back to back on the same thread
+//
+// Used for the edges inside a fused chain of sync blocks, where the writer and its single
+// reader are called one after the other by the same graph executor.  Whenever the reader
+// has caught up with the writer both indices go back to the start of the buffer, so the
+// items never wrap and the same few KiB are reused for every tile.  With the tile sized
+// to fit in L1 or L2, the items stay in cache from one block of the chain to the next.
+
+namespace gr {
+
+class buffer_cpu_tile_reader;
+
+class buffer_cpu_tile : public buffer
+{
+private:
+    std::vector<uint8_t> _storage;
+    uint8_t* _buffer = nullptr;
+    buffer_cpu_tile_reader* _tile_reader = nullptr;
+
+public:
+    using sptr = std::shared_ptr<buffer_cpu_tile>;
+
+    static buffer_sptr make(size_t num_items,
+                            size_t item_size,
+                            std::shared_ptr<buffer_properties> buffer_properties);
+
+    buffer_cpu_tile(size_t num_items,
+                    size_t item_size,
+                    std::shared_ptr<buffer_properties> buf_properties);
+
+    void* read_ptr(size_t index) override { return (void*)&_buffer[index]; }
+    void* write_ptr() override { return (void*)&_buffer[_write_index]; }
+
+    bool write_info(buffer_info_t& info) override;
+    size_t space_available() override;
+    void post_write(int num_items) override;
+
+    /**
+     * @brief Go back to the start of the buffer once the reader has caught up
+     *
+     * Items the reader left behind are moved to the front instead
+     */
+    void rewind();
+
+    std::shared_ptr<buffer_reader>
+    add_reader(std::shared_ptr<buffer_properties> buf_props, size_t itemsize) override;
+};
+
+class buffer_cpu_tile_reader : public buffer_reader
+{
+public:
+    buffer_cpu_tile_reader(buffer_sptr buffer,
+                           std::shared_ptr<buffer_properties> buf_props,
+                           size_t itemsize)
+        : buffer_reader(buffer, buf_props, itemsize, 0)
+    {
+    }
+
+    uint64_t bytes_available() override;
+    void post_read(int num_items) override;
+};
+
+} // namespace gr
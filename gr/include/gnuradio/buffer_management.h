@@ -5,8 +5,22 @@
 #include <gnuradio/logger.h>
 #include <gnuradio/neighbor_interface.h>
 
+#include <map>
+#include <set>
+
 namespace gr {
 
+/**
+ * @brief Size chosen for the buffer of one edge, and what decided it
+ *
+ */
+struct buffer_size_report {
+    std::string edge;
+    size_t num_items;
+    size_t item_size;
+    std::string reason;
+};
+
 class GR_RUNTIME_API buffer_manager
 {
 private:
@@ -18,6 +32,13 @@ private:
     logger_ptr d_logger;
     logger_ptr d_debug_logger;
 
+    double _sample_rate = 0;
+    double _max_latency = 0;
+    std::vector<buffer_size_report> _size_report;
+    std::set<edge_sptr> _tile_edges;
+    size_t _tile_bytes = 0;
+    bool _inplace = false;
+
 public:
     using sptr = std::shared_ptr<buffer_manager>;
     buffer_manager(const unsigned int default_buffer_size_in_bytes)
@@ -31,8 +52,61 @@ public:
                             std::shared_ptr<buffer_properties> buf_props,
                             neighbor_interface_sptr sched_intf = nullptr);
 
+    /**
+     * @brief Bound how much data each buffer can hold, in time
+     *
+     * The item rate on each edge is derived from the sample rate of the sources and the
+     * relative rates of the blocks in between.  Buffers are shrunk so they never hold
+     * more than max_latency seconds of items, but never below what the blocks on either
+     * side need to make progress.
+     *
+     * @param sample_rate items per second produced by the source blocks
+     * @param max_latency seconds, 0 for no bound
+     */
+    void set_latency_target(double sample_rate, double max_latency)
+    {
+        _sample_rate = sample_rate;
+        _max_latency = max_latency;
+    }
+
+    /**
+     * @brief Back the given edges with small linear buffers of tile_bytes
+     *
+     * For the edges inside a fused chain of blocks that are run back to back by one
+     * thread (see graph_utils::sync_chains).  Takes effect on the next call to
+     * initialize_buffers.
+     *
+     * @param edges
+     * @param tile_bytes size of each buffer, rounded down to whole items
+     */
+    void set_tile_edges(const edge_vector_t& edges, size_t tile_bytes)
+    {
+        _tile_edges = std::set<edge_sptr>(edges.begin(), edges.end());
+        _tile_bytes = tile_bytes;
+    }
+
+    /**
+     * @brief Let blocks declared in-place write their output over their input
+     *
+     * Applies to blocks with one input and one output whose producer has no other
+     * reader, when both edges use the default buffers and the upstream buffer is doubly
+     * mapped.  The output buffer is then a buffer_cpu_inplace on top of the input.
+     * Takes effect on the next call to initialize_buffers.
+     */
+    void set_inplace(bool inplace) { _inplace = inplace; }
+
+    /**
+     * @brief The sizes chosen for the buffers created by initialize_buffers
+     */
+    const std::vector<buffer_size_report>& size_report() const { return _size_report; }
+
 private:
-    int get_buffer_num_items(edge_sptr e, flat_graph_sptr fg);
+    size_t get_buffer_num_items(edge_sptr e, flat_graph_sptr fg, std::string& reason);
+    double
+    output_rate(block_sptr b, flat_graph_sptr fg, std::map<block_sptr, double>& rates);
+    void mark_tag_consumers(flat_graph_sptr fg);
+    void add_reader(edge_sptr e, neighbor_interface_sptr sched_intf);
+    edge_sptr inplace_input(block_sptr b, flat_graph_sptr fg);
 };
 
 } // namespace gr
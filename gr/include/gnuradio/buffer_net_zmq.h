@@ -90,8 +90,12 @@ public:
     }
     void* read_ptr() override { return _circbuf_rdr->read_ptr(); }
 
+    // The writer is on the other end of the socket
+    bool eos() const override { return false; }
+    bool propagates_eos() const override { return false; }
+
     // Tags not supported yet
-    const std::vector<tag_t>& tags() const override { return _circbuf->tags(); }
+    const tag_store& tags() const override { return _circbuf->tags(); }
     std::vector<tag_t> get_tags(size_t num_items) override { return {}; }
     void post_read(int num_items) override
     {
@@ -18,6 +18,12 @@ public:
         q.enqueue(msg);
         return true;
     }
+    // Wakes a waiting consumer once for all of the items
+    template <typename It>
+    bool push_bulk(It first, size_t count)
+    {
+        return q.enqueue_bulk(first, count);
+    }
 
     // Non-blocking
     bool try_pop(T& msg) { return q.try_dequeue(msg); }
@@ -73,6 +73,8 @@ class GR_RUNTIME_API edge
 protected:
     node_endpoint _src, _dst;
     std::shared_ptr<buffer_properties> _buffer_properties = nullptr;
+    size_t _stride_offset = 0;
+    size_t _stride = 1;
 
 public:
     using sptr = std::shared_ptr<edge>;
@@ -99,6 +101,31 @@ public:
         _buffer_properties = buffer_properties;
     }
 
+    /**
+     * @brief Have the destination read every stride'th item, starting at offset
+     *
+     * Connecting N edges from one output with offsets 0..N-1 and a stride of N
+     * deinterleaves the stream without a copy.  The destination block has to index its
+     * input by block_work_input::stride() and declare so with block::strided_input(),
+     * otherwise initializing the flowgraph throws.
+     */
+    void set_stride(size_t offset, size_t stride);
+    size_t stride() const { return _stride; }
+    size_t stride_offset() const { return _stride_offset; }
+
+    /**
+     * @brief Carry the buffer and reader settings of another edge over to this one
+     */
+    void copy_settings(const sptr& other);
+
+    /**
+     * @brief Counters of the bytes read over this edge and of the buffer occupancy
+     *
+     * Read from the buffer reader of the destination port, so they are all zero before
+     * the flowgraph is initialized
+     */
+    edge_perf_snapshot perf_counters() const;
+
     bool has_custom_buffer();
     buffer_factory_function buffer_factory();
     buffer_reader_factory_function buffer_reader_factory();
@@ -99,8 +99,7 @@ public:
                     for (auto& hbe : dst_hier_block->input_edges()) {
                         if (hbe->src().port() == e->dst().port()) {
                             // connect with the original source port
-                            fg->connect(e->src(), hbe->dst())
-                                ->set_custom_buffer(e->buf_properties());
+                            fg->connect(e->src(), hbe->dst())->copy_settings(e);
                             
                             e->src().port()->disconnect(e->dst().port());
                         }
@@ -118,8 +117,7 @@ public:
                                 // then we have an internal connection that needs to be
                                 // replicated
                                 hbe->src().port()->disconnect(hbe->dst().port());
-                                fg->connect(hbe->src(), hbe->dst())
-                                    ->set_custom_buffer(hbe->buf_properties());
+                                fg->connect(hbe->src(), hbe->dst())->copy_settings(hbe);
                             }
                         }
                         hier_block_map[dst_hier_block] = true;
@@ -131,8 +129,7 @@ public:
                     for (auto& hbe : src_hier_block->output_edges()) {
                         if (hbe->dst().port() == e->src().port()) {
                             // connect with the original source port
-                            fg->connect(hbe->src(), e->dst())
-                                ->set_custom_buffer(e->buf_properties());
+                            fg->connect(hbe->src(), e->dst())->copy_settings(e);
                             
                             e->dst().port()->disconnect(e->src().port());
                             hbe->src().port()->disconnect(hbe->dst().port());
@@ -151,8 +148,7 @@ public:
                                 // then we have an internal connection that needs to be
                                 // replicated
                                 hbe->src().port()->disconnect(hbe->dst().port());
-                                fg->connect(hbe->src(), hbe->dst())
-                                    ->set_custom_buffer(hbe->buf_properties());
+                                fg->connect(hbe->src(), hbe->dst())->copy_settings(hbe);
                                     
                             }
                         }
@@ -160,8 +156,7 @@ public:
                     }
                 }
                 if (!src_hier_block && !dst_hier_block) {
-                    fg->connect(e->src(), e->dst())
-                        ->set_custom_buffer(e->buf_properties());
+                    fg->connect(e->src(), e->dst())->copy_settings(e);
                 }
             }
             else { // edge is a pathway into another domain
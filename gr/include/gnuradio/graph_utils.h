@@ -1,6 +1,7 @@
 #pragma once
 
 #include <gnuradio/domain.h>
+#include <gnuradio/flat_graph.h>
 #include <gnuradio/graph.h>
 #include <gnuradio/scheduler.h>
 
@@ -24,6 +25,17 @@ struct graph_partition_info {
 
 using graph_partition_info_vec = std::vector<graph_partition_info>;
 
+/**
+ * @brief Linear chain of sync blocks that can be run back to back on one thread
+ *
+ * blocks - the blocks of the chain, from upstream to downstream
+ * edges - edges[i] connects blocks[i] to blocks[i + 1]
+ */
+struct fused_chain {
+    std::vector<block_sptr> blocks;
+    edge_vector_t edges;
+};
+
 struct graph_utils {
     static std::pair<std::vector<graph_sptr>,
                      std::vector<std::tuple<edge_sptr, graph_sptr, graph_sptr>>>
@@ -32,5 +44,21 @@ struct graph_utils {
     static void connect_crossings(std::pair<std::vector<graph_sptr>,
                      std::vector<std::tuple<edge_sptr, graph_sptr, graph_sptr>>>&);
 
+    /**
+     * @brief Find the chains of blocks that can be fused
+     *
+     * A block can be part of a chain if it is a sync block with one stream input and one
+     * stream output, a relative rate of 1, no output multiple or history, and a tag
+     * propagation policy the scheduler carries out.  Two such blocks are chained when the
+     * output of the first feeds nothing but the input of the second, over an edge with
+     * the default buffer and no stride.
+     *
+     * @param fg
+     * @param blocks the blocks that may be fused, e.g. those not in a block group
+     * @return std::vector<fused_chain> maximal chains of two or more blocks
+     */
+    static std::vector<fused_chain> sync_chains(flat_graph_sptr fg,
+                                                const std::vector<block_sptr>& blocks);
+
 };
 } // namespace gr
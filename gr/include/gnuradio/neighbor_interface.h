@@ -1,6 +1,7 @@
 #pragma once
 
 #include <gnuradio/scheduler_message.h>
+#include <vector>
 
 namespace gr {
 
@@ -8,6 +9,17 @@ struct neighbor_interface {
     neighbor_interface() {}
     virtual ~neighbor_interface() {}
     virtual void push_message(scheduler_message_sptr msg) = 0;
+    /**
+     * @brief Queue several messages at once
+     *
+     * Implementations override it to hand the batch to their queue in one go
+     */
+    virtual void push_messages(const std::vector<scheduler_message_sptr>& msgs)
+    {
+        for (auto& msg : msgs) {
+            push_message(msg);
+        }
+    }
 };
 using neighbor_interface_sptr = std::shared_ptr<neighbor_interface>;
 
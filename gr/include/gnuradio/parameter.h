@@ -4,8 +4,10 @@
 #include <pmtf/string.hpp>
 #include <pmtf/vector.hpp>
 #include <pmtf/wrap.hpp>
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <vector>
@@ -87,6 +89,47 @@ public:
     }
 };
 
+/**
+ * @brief Typed copy of a parameter for use in work()
+ *
+ * Each set() bumps an epoch counter; get() only takes the lock and copies the new value
+ * when the epoch has moved since the last call, so reading an unchanged parameter is a
+ * single atomic load.  get() must only be called from the thread running the block.
+ *
+ * @tparam T
+ */
+template <typename T>
+class param_snapshot
+{
+public:
+    void set(const T& value)
+    {
+        std::scoped_lock l(_mutex);
+        _value = value;
+        _epoch.fetch_add(1, std::memory_order_release);
+    }
+
+    const T& get()
+    {
+        auto epoch = _epoch.load(std::memory_order_acquire);
+        if (epoch != _snapshot_epoch) {
+            std::scoped_lock l(_mutex);
+            _snapshot = _value;
+            _snapshot_epoch = _epoch.load(std::memory_order_relaxed);
+        }
+        return _snapshot;
+    }
+
+private:
+    std::mutex _mutex;
+    T _value{};
+    std::atomic<uint64_t> _epoch{ 0 };
+
+    // only touched by the reader
+    T _snapshot{};
+    uint64_t _snapshot_epoch = 0;
+};
+
 struct parameter_config {
     std::map<std::string, pmt_sptr> param_map;
     std::map<int, pmt_sptr> param_map_int;
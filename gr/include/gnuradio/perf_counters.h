@@ -0,0 +1,173 @@
+#pragma once
+
+#include <gnuradio/high_res_timer.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Always-on performance counters for blocks and edges
+//
+// Each set of counters has a single writer, the thread that runs the block at the time,
+// and sits on cache lines of its own so that updating it does not contend with anything
+// else.  The writer updates the counters with a relaxed load and store instead of an
+// atomic read-modify-write, which keeps the cost per work call to a few plain stores.
+// Any other thread can take a snapshot while the flowgraph runs, which is at most one
+// update behind.
+
+namespace gr {
+
+namespace detail {
+inline void perf_add(std::atomic<uint64_t>& counter, uint64_t n)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+inline uint64_t perf_get(const std::atomic<uint64_t>& counter)
+{
+    return counter.load(std::memory_order_relaxed);
+}
+} // namespace detail
+
+/**
+ * @brief Counters of a block at one point in time
+ *
+ */
+struct block_perf_snapshot {
+    uint64_t work_calls = 0;
+    uint64_t items_in = 0;
+    uint64_t items_out = 0;
+    // seconds spent in work
+    double work_time = 0;
+    // times the block could not run for lack of input items or output space
+    uint64_t blocked_in = 0;
+    uint64_t blocked_out = 0;
+    // fraction of the input buffers holding unread items, averaged over the work calls
+    double avg_input_fullness = 0;
+    // fraction of the output buffers not yet read downstream, averaged the same way
+    double avg_output_fullness = 0;
+};
+
+class alignas(64) block_perf_counters
+{
+private:
+    // fullness is accumulated in millionths
+    static constexpr double s_fullness_scale = 1e6;
+
+    std::atomic<uint64_t> _work_calls{ 0 };
+    std::atomic<uint64_t> _items_in{ 0 };
+    std::atomic<uint64_t> _items_out{ 0 };
+    std::atomic<uint64_t> _work_ticks{ 0 };
+    std::atomic<uint64_t> _blocked_in{ 0 };
+    std::atomic<uint64_t> _blocked_out{ 0 };
+    std::atomic<uint64_t> _input_fullness{ 0 };
+    std::atomic<uint64_t> _input_samples{ 0 };
+    std::atomic<uint64_t> _output_fullness{ 0 };
+    std::atomic<uint64_t> _output_samples{ 0 };
+
+public:
+    /**
+     * @brief Record one call to work
+     *
+     * @param items_in items consumed across the inputs
+     * @param items_out items produced across the outputs
+     * @param ticks time spent in work, in high_res_timer ticks
+     */
+    void add_work(uint64_t items_in, uint64_t items_out, high_res_timer_type ticks)
+    {
+        detail::perf_add(_work_calls, 1);
+        detail::perf_add(_items_in, items_in);
+        detail::perf_add(_items_out, items_out);
+        detail::perf_add(_work_ticks, ticks > 0 ? ticks : 0);
+    }
+    void add_blocked_in() { detail::perf_add(_blocked_in, 1); }
+    void add_blocked_out() { detail::perf_add(_blocked_out, 1); }
+
+    /**
+     * @brief Record the fullness of an input or output buffer seen by a work call
+     *
+     * @param fullness in [0, 1]
+     */
+    void add_input_fullness(double fullness)
+    {
+        detail::perf_add(_input_fullness,
+                         static_cast<uint64_t>(fullness * s_fullness_scale));
+        detail::perf_add(_input_samples, 1);
+    }
+    void add_output_fullness(double fullness)
+    {
+        detail::perf_add(_output_fullness,
+                         static_cast<uint64_t>(fullness * s_fullness_scale));
+        detail::perf_add(_output_samples, 1);
+    }
+
+    block_perf_snapshot snapshot() const
+    {
+        block_perf_snapshot s;
+        s.work_calls = detail::perf_get(_work_calls);
+        s.items_in = detail::perf_get(_items_in);
+        s.items_out = detail::perf_get(_items_out);
+        s.work_time = (double)detail::perf_get(_work_ticks) / high_res_timer_tps();
+        s.blocked_in = detail::perf_get(_blocked_in);
+        s.blocked_out = detail::perf_get(_blocked_out);
+
+        auto n_in = detail::perf_get(_input_samples);
+        if (n_in > 0) {
+            s.avg_input_fullness =
+                detail::perf_get(_input_fullness) / s_fullness_scale / n_in;
+        }
+        auto n_out = detail::perf_get(_output_samples);
+        if (n_out > 0) {
+            s.avg_output_fullness =
+                detail::perf_get(_output_fullness) / s_fullness_scale / n_out;
+        }
+        return s;
+    }
+};
+
+/**
+ * @brief Counters of an edge at one point in time
+ *
+ */
+struct edge_perf_snapshot {
+    static constexpr size_t occupancy_bins = 10;
+
+    // bytes read by the destination of the edge
+    uint64_t bytes = 0;
+    // how often the destination found the buffer filled to each tenth of its size
+    std::array<uint64_t, occupancy_bins> occupancy{};
+};
+
+class alignas(64) edge_perf_counters
+{
+private:
+    std::atomic<uint64_t> _bytes{ 0 };
+    std::array<std::atomic<uint64_t>, edge_perf_snapshot::occupancy_bins> _occupancy{};
+
+public:
+    void add_bytes(uint64_t bytes) { detail::perf_add(_bytes, bytes); }
+
+    /**
+     * @brief Record the occupancy of the buffer seen by the reader
+     *
+     * @param occupancy fraction of the buffer holding unread items, in [0, 1]
+     */
+    void add_occupancy(double occupancy)
+    {
+        auto bin = static_cast<size_t>(occupancy * edge_perf_snapshot::occupancy_bins);
+        if (bin >= edge_perf_snapshot::occupancy_bins) {
+            bin = edge_perf_snapshot::occupancy_bins - 1;
+        }
+        detail::perf_add(_occupancy[bin], 1);
+    }
+
+    edge_perf_snapshot snapshot() const
+    {
+        edge_perf_snapshot s;
+        s.bytes = detail::perf_get(_bytes);
+        for (size_t i = 0; i < s.occupancy.size(); i++) {
+            s.occupancy[i] = detail::perf_get(_occupancy[i]);
+        }
+        return s;
+    }
+};
+
+} // namespace gr
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace gr {
+
+/**
+ * @brief Allocator recycling single objects through a free list per thread
+ *
+ * Meant for objects that are allocated and released at a high rate, such as the nodes
+ * of messages handed from one block to the next.  A released object goes to the free
+ * list of the thread releasing it, which in a chain of blocks is the thread that
+ * allocates the next one.  Each list keeps at most s_max_cached objects, anything past
+ * that goes back to the heap.
+ *
+ * @tparam T
+ */
+template <typename T>
+class pool_allocator
+{
+private:
+    static constexpr size_t s_max_cached = 4096;
+
+    // Free objects hold the link to the next one themselves
+    struct free_node {
+        free_node* next;
+    };
+    static_assert(sizeof(T) >= sizeof(free_node), "pool_allocator: object too small");
+
+    struct free_list {
+        free_node* head = nullptr;
+        size_t count = 0;
+        ~free_list()
+        {
+            while (head) {
+                auto next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+            // Anything released while the thread winds down goes to the heap
+            count = s_max_cached;
+        }
+    };
+
+    static free_list& local_list()
+    {
+        thread_local free_list list;
+        return list;
+    }
+
+public:
+    using value_type = T;
+
+    pool_allocator() = default;
+    template <typename U>
+    pool_allocator(const pool_allocator<U>&)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if (n == 1) {
+            auto& list = local_list();
+            if (list.head) {
+                auto node = list.head;
+                list.head = node->next;
+                list.count--;
+                return reinterpret_cast<T*>(node);
+            }
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        if (n == 1) {
+            auto& list = local_list();
+            if (list.count < s_max_cached) {
+                auto node = reinterpret_cast<free_node*>(p);
+                node->next = list.head;
+                list.head = node;
+                list.count++;
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const pool_allocator<T>&, const pool_allocator<U>&)
+{
+    return true;
+}
+template <typename T, typename U>
+bool operator!=(const pool_allocator<T>&, const pool_allocator<U>&)
+{
+    return false;
+}
+
+} // namespace gr
@@ -11,6 +11,7 @@
 #include <typeindex>
 #include <typeinfo>
 #include <utility>
+#include <vector>
 
 
 namespace gr {
@@ -88,8 +89,9 @@ public:
     void notify_connected_ports(scheduler_message_sptr msg);
     // Inbound messages
     void push_message(scheduler_message_sptr msg) override;
-    void connect(port_interface_sptr other_port);
-    void disconnect(port_interface_sptr other_port);
+    void push_messages(const std::vector<scheduler_message_sptr>& msgs) override;
+    virtual void connect(port_interface_sptr other_port);
+    virtual void disconnect(port_interface_sptr other_port);
 
 protected:
     std::string _name;
@@ -178,6 +180,15 @@ class GR_RUNTIME_API message_port : public port_base
 private: //
     message_port_callback_fcn _callback_fcn;
 
+    // Ports an output delivers to, bound when they are connected.  callback is null for
+    // ports that are not message ports, e.g. proxies to another flowgraph.
+    struct destination {
+        port_interface* port;
+        const message_port_callback_fcn* callback;
+    };
+    std::vector<destination> _destinations;
+    void bind_destinations();
+
 public:
     using sptr = std::shared_ptr<message_port>;
     static sptr make(const std::string& name,
@@ -193,7 +204,17 @@ public:
     message_port_callback_fcn callback() { return _callback_fcn; }
     void register_callback(message_port_callback_fcn fcn) { _callback_fcn = fcn; }
     void post(pmtf::pmt msg);
+
+    /**
+     * @brief Post several messages, handing them to each destination in one batch
+     *
+     * @param msgs
+     */
+    void post_many(const std::vector<pmtf::pmt>& msgs);
     void push_message(scheduler_message_sptr msg) override;
+    void push_messages(const std::vector<scheduler_message_sptr>& msgs) override;
+    void connect(port_interface_sptr other_port) override;
+    void disconnect(port_interface_sptr other_port) override;
 };
 using message_port_sptr = message_port::sptr;
 
@@ -1,5 +1,6 @@
 #pragma once
 #include <gnuradio/scheduler_message.h>
+#include <vector>
 
 namespace gr {
 
@@ -8,6 +9,12 @@ class port_interface
 {
 public:
     virtual void push_message(scheduler_message_sptr msg) = 0;
+    virtual void push_messages(const std::vector<scheduler_message_sptr>& msgs)
+    {
+        for (auto& msg : msgs) {
+            push_message(msg);
+        }
+    }
     virtual ~port_interface() = default;
 };
 
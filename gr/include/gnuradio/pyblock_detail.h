@@ -1,15 +1,48 @@
 #pragma once
 
 #include <gnuradio/api.h>
+#include <gnuradio/block.h>
+#include <gnuradio/block_work_io.h>
 #include <pybind11/embed.h>
 #include <pybind11/pybind11.h> // must be first
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 namespace py = pybind11;
 
 namespace gr {
+
+/**
+ * @brief numpy views of the stream buffers, handed to work() implemented in Python
+ *
+ * The dtype and shape of each port are worked out on its first work call and kept,
+ * so later calls only wrap their items in a new array.  The GIL must be held.
+ */
+class GR_RUNTIME_API ndarray_views
+{
+private:
+    struct view {
+        py::dtype dtype;
+        std::vector<py::ssize_t> shape;
+    };
+    std::vector<view> d_inputs;
+    std::vector<view> d_outputs;
+
+    static py::array point(view& v, const port_sptr& p, void* items, size_t nitems);
+
+public:
+    ndarray_views() = default;
+    ~ndarray_views();
+    ndarray_views(const ndarray_views&) = delete;
+    ndarray_views& operator=(const ndarray_views&) = delete;
+
+    py::array input(block& b, block_work_input& w, size_t index);
+    py::array output(block& b, block_work_output& w, size_t index);
+};
+
 struct GR_RUNTIME_API pyblock_detail {
     py::handle d_py_handle = nullptr;
+    ndarray_views arrays;
     pyblock_detail(py::handle handle) { d_py_handle = handle; }
     py::handle handle() { return d_py_handle; }
 };
-} // namespace gr
\ No newline at end of file
+} // namespace gr
@@ -13,6 +13,7 @@
 
 #include <gnuradio/api.h>
 #include <gnuradio/block.h>
+#include <gnuradio/pyblock_detail.h>
 #include <gnuradio/sync_block.h>
 #include <string>
 
@@ -34,6 +35,7 @@ class GR_RUNTIME_API python_block : virtual public gr::block
 {
 private:
     py::handle d_py_handle;
+    ndarray_views d_arrays;
 
 public:
     using sptr = std::shared_ptr<python_block>;
@@ -50,12 +52,25 @@ public:
     bool stop(void) override;
 
     void add_port(port_sptr p) { node::add_port(p); }
+
+    /**
+     * @brief numpy view of the items of a stream input or output in this work call
+     */
+    py::array get_input_array(block_work_input& w, size_t index)
+    {
+        return d_arrays.input(*this, w, index);
+    }
+    py::array get_output_array(block_work_output& w, size_t index)
+    {
+        return d_arrays.output(*this, w, index);
+    }
 };
 
 class GR_RUNTIME_API python_sync_block : virtual public gr::sync_block
 {
 private:
     py::handle d_py_handle;
+    ndarray_views d_arrays;
 
 public:
     // gr::python_sync_block::sptr
@@ -73,6 +88,18 @@ public:
     bool stop(void) override;
 
     void add_port(port_sptr p) { node::add_port(p); }
+
+    /**
+     * @brief numpy view of the items of a stream input or output in this work call
+     */
+    py::array get_input_array(block_work_input& w, size_t index)
+    {
+        return d_arrays.input(*this, w, index);
+    }
+    py::array get_output_array(block_work_output& w, size_t index)
+    {
+        return d_arrays.output(*this, w, index);
+    }
 };
 
 } /* namespace gr */
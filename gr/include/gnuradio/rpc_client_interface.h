@@ -2,6 +2,7 @@
 
 #include <pmtf/base.hpp>
 #include <string>
+#include <vector>
 
 namespace gr {
 
@@ -28,6 +29,15 @@ public:
     virtual std::string block_parameter_query(const std::string& block_name,
                                             const std::string& parameter);
 
+    /**
+     * @brief Query several parameters of a remote block in a single request
+     *
+     * @return std::vector<std::string> base64 encoded values in the order of parameters
+     */
+    virtual std::vector<std::string>
+    block_parameters_query(const std::string& block_name,
+                           const std::vector<std::string>& parameters);
+
     virtual void block_parameter_change(const std::string& block_name,
                                         const std::string& parameter,
                                         const std::string& encoded_value);
@@ -6,6 +6,7 @@
 #include <mutex>
 
 #include <gnuradio/buffer.h>
+#include <gnuradio/buffer_management.h>
 #include <gnuradio/flat_graph.h>
 #include <gnuradio/logger.h>
 #include <gnuradio/runtime_monitor.h>
@@ -44,12 +45,35 @@ public:
         _default_buf_properties = bp;
     }
 
+    /**
+     * @brief Size the buffers created at initialize to hold at most max_latency seconds
+     * of items, see buffer_manager::set_latency_target
+     *
+     * @param sample_rate items per second produced by the source blocks
+     * @param max_latency seconds, 0 for no bound
+     */
+    void set_buffer_latency_target(double sample_rate, double max_latency)
+    {
+        _buffer_sample_rate = sample_rate;
+        _buffer_max_latency = max_latency;
+    }
+
+    /**
+     * @brief The sizes chosen for the buffers of this scheduler's edges, filled in by
+     * initialize
+     */
+    const std::vector<buffer_size_report>& buffer_sizes() const { return _buffer_sizes; }
+
 protected:
     logger_ptr d_logger;
     logger_ptr d_debug_logger;
 
     std::shared_ptr<buffer_properties> _default_buf_properties = nullptr;
 
+    double _buffer_sample_rate = 0;
+    double _buffer_max_latency = 0;
+    std::vector<buffer_size_report> _buffer_sizes;
+
 private:
     std::string _name;
     int _id;
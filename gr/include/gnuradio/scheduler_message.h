@@ -1,6 +1,9 @@
 #pragma once
 
+#include <gnuradio/pool_allocator.h>
 #include <pmtf/wrap.hpp>
+#include <functional>
+#include <memory>
 
 namespace gr {
 
@@ -54,23 +57,76 @@ using scheduler_action_sptr = std::shared_ptr<scheduler_action>;
 
 
 using message_port_callback_fcn = std::function<void(pmtf::pmt)>;
+
+/**
+ * @brief A message on its way to a message port
+ *
+ * Messages posted by message ports refer to the callback of the destination port, which
+ * is bound when the ports are connected, rather than carrying a copy of it.  They are
+ * allocated through a pool_allocator, see make().
+ */
 class msgport_message : public scheduler_message
 {
 public:
     msgport_message() {}
     msgport_message(pmtf::pmt msg, message_port_callback_fcn cb)
-        : scheduler_message(scheduler_message_t::MSGPORT_MESSAGE), _msg(msg), _cb(cb)
+        : scheduler_message(scheduler_message_t::MSGPORT_MESSAGE),
+          _msg(std::move(msg)),
+          _cb(std::move(cb))
+    {
+    }
+    msgport_message(pmtf::pmt msg, const message_port_callback_fcn* cb_ref)
+        : scheduler_message(scheduler_message_t::MSGPORT_MESSAGE),
+          _msg(std::move(msg)),
+          _cb_ref(cb_ref)
     {
     }
-    void set_callback(message_port_callback_fcn cb) { _cb = cb; }
-    message_port_callback_fcn callback() { return _cb; }
+
+    /**
+     * @brief Allocate a message from the pool of the calling thread
+     *
+     * @param msg
+     * @param cb_ref callback of the destination port, which must outlive the message
+     */
+    static std::shared_ptr<msgport_message>
+    make(pmtf::pmt msg, const message_port_callback_fcn* cb_ref = nullptr)
+    {
+        return std::allocate_shared<msgport_message>(
+            pool_allocator<msgport_message>(), std::move(msg), cb_ref);
+    }
+
+    void set_callback(message_port_callback_fcn cb)
+    {
+        _cb = std::move(cb);
+        _cb_ref = nullptr;
+    }
+    void bind_callback(const message_port_callback_fcn* cb_ref) { _cb_ref = cb_ref; }
+    bool has_callback() const { return _cb_ref || _cb; }
+    message_port_callback_fcn callback() { return _cb_ref ? *_cb_ref : _cb; }
     pmtf::pmt message() { return _msg; }
+
+    /**
+     * @brief Hand the message to the callback of its destination
+     *
+     * The message is moved out, so this is called once
+     */
+    void dispatch()
+    {
+        if (_cb_ref) {
+            (*_cb_ref)(std::move(_msg));
+        }
+        else {
+            _cb(std::move(_msg));
+        }
+    }
+
     std::string to_json() override;
     scheduler_message_sptr from_json(const std::string& str) override;
 
 private:
     pmtf::pmt _msg;
     message_port_callback_fcn _cb;
+    const message_port_callback_fcn* _cb_ref = nullptr;
 };
 using msgport_message_sptr = std::shared_ptr<msgport_message>;
 
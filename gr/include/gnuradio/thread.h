@@ -127,5 +127,12 @@ int GR_RUNTIME_API set_thread_priority(gr_thread_t thread, int priority);
 
 void GR_RUNTIME_API set_thread_name(gr_thread_t thread, const std::string& name);
 
+/*! \brief Get the NUMA node that a core belongs to
+ *
+ * Returns -1 if the node cannot be determined, which is always the case on systems
+ * other than Linux.
+ */
+int GR_RUNTIME_API numa_node_of_processor(unsigned int n);
+
 } /* namespace thread */
 } /* namespace gr */
@@ -66,6 +66,7 @@ void block::on_parameter_change(param_action_sptr action)
         "block {}: on_parameter_change param_id: {}", id(), action->id());
     auto param = d_parameters.get(action->id());
     *param = action->pmt_value();
+    update_param_snapshot(action->id());
 }
 
 void block::on_parameter_query(param_action_sptr action)
@@ -121,76 +122,138 @@ void block::handle_msg_system(pmtf::pmt msg)
     }
 }
 
-void block::request_parameter_change(int param_id, pmtf::pmt new_value, bool block)
+void block::request_parameter_change(int param_id,
+                                     pmtf::pmt new_value,
+                                     bool block,
+                                     uint64_t at_sample)
 {
+    auto fut = request_parameter_change_async(param_id, new_value, at_sample);
+    if (block) {
+        // block until confirmation that parameter has been set
+        fut.wait();
+    }
+}
+
+std::future<void> block::request_parameter_change_async(int param_id,
+                                                       pmtf::pmt new_value,
+                                                       uint64_t at_sample)
+{
+    // The callback has to be copyable, so the promise is shared with it
+    auto promise = std::make_shared<std::promise<void>>();
+    auto fut = promise->get_future();
+
     if (rpc_client() && !rpc_name().empty()) {
         rpc_client()->block_parameter_change(
             rpc_name(), get_param_str(param_id), new_value.to_base64());
+        promise->set_value();
     }
     else if (p_scheduler && d_running) {
-        std::condition_variable cv;
-        std::mutex m;
-        bool ready{ false };
-        auto lam = [&](param_action_sptr a) {
-            {
-                std::unique_lock<std::mutex> lk(m);
-                ready = true;
-            }
-            cv.notify_all();
-        };
+        auto lam = [promise](param_action_sptr a) { promise->set_value(); };
 
         p_scheduler->push_message(std::make_shared<param_change_action>(
-            id(), param_action::make(param_id, new_value, 0), lam));
-
-        if (block) {
-            // block until confirmation that parameter has been set
-            std::unique_lock<std::mutex> lk(m);
-            cv.wait(lk, [&ready]() { return ready == true; });
-        }
+            id(), param_action::make(param_id, new_value, at_sample), lam));
     }
     // else go ahead and update parameter value
     else {
         on_parameter_change(param_action::make(param_id, new_value, 0));
+        promise->set_value();
     }
+
+    return fut;
 }
 
 pmtf::pmt block::request_parameter_query(int param_id)
 {
+    return request_parameter_query_async(param_id).get();
+}
+
+std::future<pmtf::pmt> block::request_parameter_query_async(int param_id)
+{
+    auto promise = std::make_shared<std::promise<pmtf::pmt>>();
+    auto fut = promise->get_future();
 
     if (rpc_client() && !rpc_name().empty()) {
         auto encoded_str =
             rpc_client()->block_parameter_query(rpc_name(), get_param_str(param_id));
-        return pmtf::pmt::from_base64(encoded_str);
+        promise->set_value(pmtf::pmt::from_base64(encoded_str));
     }
     // call back to the scheduler if ptr is not null
     else if (p_scheduler && d_running) {
-        std::condition_variable cv;
-        std::mutex m;
-        pmtf::pmt newval;
-        bool ready{ false };
-        auto lam = [&](param_action_sptr a) {
-            {
-                std::unique_lock<std::mutex> lk(m);
-                newval = a->pmt_value();
-                ready = true;
-            }
-            cv.notify_all();
-        };
-
-        auto msg =
-            std::make_shared<param_query_action>(id(), param_action::make(param_id), lam);
-        p_scheduler->push_message(msg);
-
-        std::unique_lock<std::mutex> lk(m);
-        cv.wait(lk, [&ready]() { return ready == true; });
-        return newval;
+        auto lam = [promise](param_action_sptr a) { promise->set_value(a->pmt_value()); };
+
+        p_scheduler->push_message(std::make_shared<param_query_action>(
+            id(), param_action::make(param_id), lam));
     }
     // else go ahead and return parameter value
     else {
         auto action = param_action::make(param_id);
         on_parameter_query(action);
-        return action->pmt_value();
+        promise->set_value(action->pmt_value());
+    }
+
+    return fut;
+}
+
+std::future<std::vector<pmtf::pmt>>
+block::request_parameters_query_async(const std::vector<int>& param_ids)
+{
+    auto promise = std::make_shared<std::promise<std::vector<pmtf::pmt>>>();
+    auto fut = promise->get_future();
+
+    if (param_ids.empty()) {
+        promise->set_value({});
+        return fut;
+    }
+
+    // Runs on the thread that owns the block once the first parameter has been queried,
+    // so the rest can be read directly.  The message may outlive every other reference
+    // to the block.
+    auto query_rest = [self = base(), promise, param_ids](param_action_sptr first) {
+        std::vector<pmtf::pmt> values;
+        values.reserve(param_ids.size());
+        values.push_back(first->pmt_value());
+        for (size_t i = 1; i < param_ids.size(); i++) {
+            auto action = param_action::make(param_ids[i]);
+            self->on_parameter_query(action);
+            values.push_back(action->pmt_value());
+        }
+        promise->set_value(std::move(values));
+    };
+
+    if (rpc_client() && !rpc_name().empty()) {
+        // One round trip to the remote block for all of the parameters
+        std::vector<std::string> param_strs;
+        for (auto param_id : param_ids) {
+            param_strs.push_back(get_param_str(param_id));
+        }
+        std::vector<pmtf::pmt> values;
+        for (auto& encoded_str :
+             rpc_client()->block_parameters_query(rpc_name(), param_strs)) {
+            values.push_back(pmtf::pmt::from_base64(encoded_str));
+        }
+        promise->set_value(std::move(values));
+    }
+    else if (p_scheduler && d_running) {
+        p_scheduler->push_message(std::make_shared<param_query_action>(
+            id(), param_action::make(param_ids[0]), query_rest));
+    }
+    else {
+        auto action = param_action::make(param_ids[0]);
+        on_parameter_query(action);
+        query_rest(action);
+    }
+
+    return fut;
+}
+
+std::vector<pmtf::pmt>
+block::request_parameters_query(const std::vector<std::string>& param_strs)
+{
+    std::vector<int> param_ids;
+    for (auto& str : param_strs) {
+        param_ids.push_back(get_param_id(str));
     }
+    return request_parameters_query_async(param_ids).get();
 }
 
 void block::notify_scheduler()
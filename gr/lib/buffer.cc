@@ -1,27 +1,104 @@
 #include <gnuradio/buffer.h>
 
+#include <gnuradio/buffer_cpu_inplace.h>
+
+#include "pagesize.h"
+#include <fmt/core.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#if defined(HAVE_LINUX_MEMPOLICY_H)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace gr {
 
 size_t buffer::space_available()
+{
+    auto n_available = bytes_unread();
+
+    int space_in_items = (_num_items * _item_size - n_available) / _item_size - 1;
+
+    if (space_in_items < 0)
+        space_in_items = 0;
+
+    return fill_limit(space_in_items, n_available / _item_size);
+}
+
+uint64_t buffer::bytes_unread()
 {
     // Find the max number of bytes available across readers
-    uint64_t n_available = 0;
+    uint64_t n_unread = 0;
     for (auto& r : _readers) {
         auto n = r->bytes_available();
-        if (n > n_available) {
-            n_available = n;
+        n += r->inplace_bytes_unread();
+        if (n > n_unread) {
+            n_unread = n;
         }
     }
+    return n_unread;
+}
 
-    int space_in_items = (_num_items * _item_size - n_available) / _item_size - 1;
+size_t buffer::fill_limit(size_t space_in_items, uint64_t n_unread_items)
+{
+    size_t limit;
+    switch (_fill_policy) {
+    case buffer_fill_policy_t::FULL:
+        limit = _num_items;
+        break;
+    case buffer_fill_policy_t::ADAPTIVE: {
+        // When the readers drain the buffer between writes, the writer can use most of
+        // it; the more they lag, the closer this gets to double buffering
+        _avg_lag += 0.125 * ((double)n_unread_items - _avg_lag);
+        auto margin = static_cast<size_t>(2 * _avg_lag);
+        limit = margin >= _num_items / 2 ? _num_items / 2 : _num_items - margin;
+        break;
+    }
+    case buffer_fill_policy_t::FRACTION:
+    default:
+        limit = static_cast<size_t>(_fill_fraction * _num_items);
+        break;
+    }
 
-    if (space_in_items < 0)
-        space_in_items = 0;
-    space_in_items =
-        std::min(space_in_items, (int)(_num_items / 2)); // move to a max_fill parameter
+    return std::min(space_in_items, std::max(limit, (size_t)1));
+}
+
+bool buffer::set_numa_node(int node)
+{
+#if defined(HAVE_LINUX_MEMPOLICY_H) && defined(SYS_mbind)
+    if (node < 0 || node >= (int)(8 * sizeof(unsigned long))) {
+        return false;
+    }
+
+    // mbind works on whole pages, so only the pages entirely inside the buffer are bound
+    auto page = (uintptr_t)gr::pagesize();
+    auto start = ((uintptr_t)read_ptr(0) + page - 1) & ~(page - 1);
+    auto end = ((uintptr_t)read_ptr(0) + _buf_size) & ~(page - 1);
+    if (end <= start) {
+        return false;
+    }
 
-    return space_in_items;
+    unsigned long nodemask = 1UL << node;
+    if (syscall(SYS_mbind,
+                (void*)start,
+                end - start,
+                MPOL_PREFERRED,
+                &nodemask,
+                8 * sizeof(nodemask),
+                MPOL_MF_MOVE) != 0) {
+        if (d_debug_logger) {
+            d_debug_logger->debug("mbind to node {} failed: {}", node, strerror(errno));
+        }
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
 }
+
 bool buffer::write_info(buffer_info_t& info)
 {
     std::scoped_lock guard(_buf_mutex);
@@ -35,15 +112,66 @@ bool buffer::write_info(buffer_info_t& info)
 
     return true;
 }
+
+bool buffer::readers_done()
+{
+    if (_readers.empty()) {
+        return false;
+    }
+    return std::all_of(
+        _readers.begin(), _readers.end(), [](buffer_reader* r) { return r->done(); });
+}
+
+void buffer::insert_tag(tag_t&& tag)
+{
+    // Tags are almost always added in increasing offset order
+    if (_tags.empty() || _tags.back().offset() <= tag.offset()) {
+        _tags.push_back(std::move(tag));
+    }
+    else {
+        auto it = std::upper_bound(_tags.begin(),
+                                   _tags.end(),
+                                   tag.offset(),
+                                   [](uint64_t offset, const tag_t& t) {
+                                       return offset < t.offset();
+                                   });
+        _tags.insert(it, std::move(tag));
+    }
+}
+
+std::pair<tag_store::const_iterator, tag_store::const_iterator>
+buffer::tag_range(uint64_t start, uint64_t end, double relative_rate) const
+{
+    // Scaling by a positive rate keeps the store sorted, so both ends of the window can
+    // be found by binary search
+    auto scaled_before = [relative_rate](uint64_t bound) {
+        return [relative_rate, bound](const tag_t& t) {
+            uint64_t new_offset = t.offset();
+            if (relative_rate != 1.0) {
+                new_offset = t.offset() / relative_rate;
+            }
+            return new_offset < bound;
+        };
+    };
+
+    auto first = std::partition_point(_tags.begin(), _tags.end(), scaled_before(start));
+    auto last = std::partition_point(first, _tags.end(), scaled_before(end));
+    return std::make_pair(first, last);
+}
+
 void buffer::add_tags(size_t num_items, std::vector<tag_t>& tags)
 {
+    if (!_tags_needed) {
+        return;
+    }
+
     std::scoped_lock guard(_buf_mutex);
 
     for (auto tag : tags) {
         if (tag.offset() < _total_written - num_items || tag.offset() >= _total_written) {
         }
         else {
-            _tags.push_back(tag);
+            insert_tag(std::move(tag));
         }
     }
 }
@@ -51,40 +179,45 @@ void buffer::add_tags(size_t num_items, std::vector<tag_t>& tags)
 
 void buffer::add_tag(tag_t tag)
 {
+    if (!_tags_needed) {
+        return;
+    }
     std::scoped_lock guard(_buf_mutex);
-    _tags.push_back(tag);
+    insert_tag(std::move(tag));
 }
 void buffer::add_tag(uint64_t offset, tag_map map)
 {
+    if (!_tags_needed) {
+        return;
+    }
     std::scoped_lock guard(_buf_mutex);
-    _tags.emplace_back(offset, map);
+    insert_tag(tag_t(offset, map));
 }
 
 void buffer::add_tag(uint64_t offset, pmtf::map map)
 {
+    if (!_tags_needed) {
+        return;
+    }
     std::scoped_lock guard(_buf_mutex);
-    _tags.emplace_back(offset, map);
+    insert_tag(tag_t(offset, map));
 }
 
 void buffer::propagate_tags(std::shared_ptr<buffer_reader> p_in_buf, int n_consumed)
 {
-    double relative_rate =
-        (double)p_in_buf->item_size() / (double)p_in_buf->buffer_item_size();
-    std::scoped_lock guard(_buf_mutex);
-    for (auto& t : p_in_buf->tags()) {
-        uint64_t new_offset = t.offset();
-        if (relative_rate != 1.0) {
-            new_offset = t.offset() / relative_rate;
-        }
-        // Propagate the tags that occurred in the processed window
-        if (new_offset >= total_written() && new_offset < total_written() + n_consumed) {
-            // std::cout << "adding tag" << std::endl;
-            _tags.push_back(t);
+    if (!_tags_needed) {
+        return;
+    }
 
-            if (relative_rate != 1.0) {
-                _tags[_tags.size() - 1].set_offset(new_offset);
-            }
-        }
+    // Propagate the tags that occurred in the processed window
+    auto tags = p_in_buf->tags_in_range(total_written(), total_written() + n_consumed);
+    if (tags.empty()) {
+        return;
+    }
+
+    std::scoped_lock guard(_buf_mutex);
+    for (auto& t : tags) {
+        insert_tag(std::move(t));
     }
 }
 
@@ -92,30 +225,49 @@ void buffer::prune_tags()
 {
     std::scoped_lock guard(_buf_mutex);
 
-    // Find the min number of items available across readers
+    if (_tags.empty()) {
+        return;
+    }
+
+    // Find the min number of items available across readers.  A strided reader counts
+    // frames, and has read up to item offset of the frame it is on.
     auto n_read = total_written();
     for (auto& r : _readers) {
-        auto n = r->total_read();
+        auto n = r->total_read() * r->stride() + r->offset();
         if (n < n_read) {
             n_read = n;
         }
     }
 
-    auto t = std::begin(_tags);
-    while (t != std::end(_tags)) {
-        // Do some stuff
-        if (t->offset() < n_read) {
-            t = _tags.erase(t);
-            // std::cout << "removing tag" << std::endl;
-        }
-        else {
-            ++t;
-        }
+    // The store is sorted, so everything that has been read is at the front
+    while (!_tags.empty() && _tags.front().offset() < n_read) {
+        _tags.pop_front();
+    }
+}
+
+void buffer_reader::set_stride(size_t offset, size_t stride)
+{
+    if (stride == 0 || offset >= stride) {
+        throw std::invalid_argument(
+            fmt::format("Invalid strided reader: offset {}, stride {}", offset, stride));
+    }
+    if (_itemsize != _stride * _buffer->item_size()) {
+        throw std::invalid_argument(
+            "Strided readers need the item size of the buffer they read from");
     }
+
+    _offset = offset;
+    _stride = stride;
+    _itemsize = stride * _buffer->item_size();
 }
 
 size_t buffer_reader::items_available() { return bytes_available() / _itemsize; }
 
+uint64_t buffer_reader::inplace_bytes_unread()
+{
+    return _inplace_buffer ? _inplace_buffer->bytes_held() : 0;
+}
+
 size_t buffer_reader::bytes_available()
 {
     size_t w = _buffer->write_index();
@@ -130,7 +282,7 @@ bool buffer_reader::read_info(buffer_info_t& info)
 {
     // std::scoped_lock guard(_rdr_mutex);
 
-    info.ptr = _buffer->read_ptr(_read_index);
+    info.ptr = _buffer->read_ptr(_read_index + _offset * _buffer->item_size());
     info.n_items = items_available();
     info.item_size = _itemsize; //  _buffer->item_size();
     info.total_items = _total_read;
@@ -148,55 +300,45 @@ bool buffer_reader::read_info(buffer_info_t& info)
  */
 std::vector<tag_t> buffer_reader::get_tags(size_t num_items)
 {
-    std::scoped_lock guard(*(_buffer->mutex()));
-    double relative_rate = (double)_itemsize / (double)_buffer->item_size();
-
     // Find all the tags from total_read to total_read+offset
-    std::vector<tag_t> ret;
-    for (auto& t : _buffer->tags()) {
-        uint64_t new_offset = t.offset();
-        if (relative_rate != 1.0) {
-            new_offset = t.offset() / relative_rate;
-        }
-        if (new_offset >= total_read() && new_offset < total_read() + num_items) {
-            ret.push_back(t);
-
-            if (relative_rate != 1.0) {
-                ret[ret.size() - 1].set_offset(new_offset);
-            }
-        }
-    }
-
-    return ret;
+    return tags_in_range(total_read(), total_read() + num_items);
 }
 
 
 std::vector<tag_t> buffer_reader::tags_in_window(const uint64_t item_start,
                                                  const uint64_t item_end)
 {
-    std::scoped_lock guard(*(_buffer->mutex()));
+    return tags_in_range(total_read() + item_start, total_read() + item_end);
+}
 
+std::vector<tag_t> buffer_reader::tags_in_range(const uint64_t abs_start,
+                                                const uint64_t abs_end)
+{
+    std::vector<tag_t> ret;
+    tags_in_range(abs_start, abs_end, ret);
+    return ret;
+}
+
+void buffer_reader::tags_in_range(const uint64_t abs_start,
+                                  const uint64_t abs_end,
+                                  std::vector<tag_t>& tags)
+{
     double relative_rate = (double)_itemsize / (double)_buffer->item_size();
 
-    std::vector<tag_t> ret;
-    for (auto& t : _buffer->tags()) {
-        uint64_t new_offset = t.offset();
-        if (relative_rate != 1.0) {
-            new_offset = t.offset() / relative_rate;
-        }
-        if (new_offset >= total_read() + item_start &&
-            new_offset < total_read() + item_end) {
-            ret.push_back(t);
+    {
+        std::scoped_lock guard(*(_buffer->mutex()));
+        auto [first, last] = _buffer->tag_range(abs_start, abs_end, relative_rate);
+        tags.assign(first, last);
+    }
 
-            if (relative_rate != 1.0) {
-                ret[ret.size() - 1].set_offset(new_offset);
-            }
+    if (relative_rate != 1.0) {
+        for (auto& t : tags) {
+            t.set_offset(t.offset() / relative_rate);
         }
     }
-    return ret;
 }
 
-const std::vector<tag_t>& buffer_reader::tags() const
+const tag_store& buffer_reader::tags() const
 {
     std::scoped_lock guard(*(_buffer->mutex()));
     return _buffer->tags();
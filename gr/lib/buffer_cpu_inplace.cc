@@ -0,0 +1,125 @@
+#include <gnuradio/buffer_cpu_inplace.h>
+
+#include <gnuradio/buffer_cpu_lockfree.h>
+#include <gnuradio/buffer_cpu_vmcirc.h>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace gr {
+
+buffer_sptr buffer_cpu_inplace::make(std::shared_ptr<buffer_reader> src_reader,
+                                     buffer_sptr src_buffer)
+{
+    return buffer_sptr(new buffer_cpu_inplace(src_reader, src_buffer));
+}
+
+buffer_cpu_inplace::buffer_cpu_inplace(std::shared_ptr<buffer_reader> src_reader,
+                                       buffer_sptr src_buffer)
+    : buffer(src_buffer->num_items(), src_buffer->item_size(), nullptr),
+      _src_reader(src_reader),
+      _src_buffer(src_buffer),
+      _src_bytes_base(src_reader->total_read() * src_buffer->item_size())
+{
+    set_type("buffer_cpu_inplace");
+
+    if (src_reader->item_size() != src_buffer->item_size() || src_reader->stride() != 1) {
+        throw std::invalid_argument(
+            "In-place buffers need a reader with the item size of the buffer");
+    }
+
+    _buf_size = src_buffer->buf_size();
+    _write_index = src_reader->read_index();
+    _src_reader->set_inplace_buffer(this);
+}
+
+buffer_cpu_inplace::~buffer_cpu_inplace() { _src_reader->set_inplace_buffer(nullptr); }
+
+bool buffer_cpu_inplace::supports(buffer_sptr buf)
+{
+    return std::dynamic_pointer_cast<buffer_cpu_vmcirc>(buf) ||
+           std::dynamic_pointer_cast<buffer_cpu_lockfree>(buf) ||
+           std::dynamic_pointer_cast<buffer_cpu_inplace>(buf);
+}
+
+size_t buffer_cpu_inplace::space_available()
+{
+    // Every item that has been read can be written over, and no more
+    return _src_reader->items_available();
+}
+
+uint64_t buffer_cpu_inplace::bytes_held()
+{
+    // The block posts its read of the upstream buffer before its write to this one, so
+    // in between the items it wrote over are only accounted for by src_reader.  Load the
+    // readers first: they cannot read past what src_reader has read.
+    if (_readers.empty()) {
+        return 0;
+    }
+    uint64_t min_released = UINT64_MAX;
+    for (auto& r : _readers) {
+        auto ip_reader = static_cast<buffer_cpu_inplace_reader*>(r);
+        int64_t released = ip_reader->bytes_read();
+        released -= ip_reader->inplace_bytes_unread();
+        min_released = std::min<uint64_t>(min_released, std::max<int64_t>(released, 0));
+    }
+
+    uint64_t src_read = _src_reader->total_read() * _item_size - _src_bytes_base;
+    return src_read > min_released ? src_read - min_released : 0;
+}
+
+bool buffer_cpu_inplace::write_info(buffer_info_t& info)
+{
+    info.ptr = write_ptr();
+    info.n_items = space_available();
+    info.item_size = _item_size;
+    info.total_items = _total_written;
+
+    return true;
+}
+
+void buffer_cpu_inplace::post_write(int num_items)
+{
+    size_t bytes_written = num_items * _item_size;
+
+    _write_index += bytes_written;
+    if (_write_index >= _buf_size) {
+        _write_index -= _buf_size;
+    }
+    _total_written += num_items;
+
+    _bytes_written.store(_bytes_written.load(std::memory_order_relaxed) + bytes_written,
+                         std::memory_order_release);
+}
+
+std::shared_ptr<buffer_reader>
+buffer_cpu_inplace::add_reader(std::shared_ptr<buffer_properties> buf_props,
+                               size_t itemsize)
+{
+    std::shared_ptr<buffer_cpu_inplace_reader> r(new buffer_cpu_inplace_reader(
+        shared_from_this(), buf_props, itemsize, bytes_written()));
+    _readers.push_back(r.get());
+    return r;
+}
+
+uint64_t buffer_cpu_inplace_reader::bytes_available()
+{
+    return _inplace->bytes_written() - _bytes_read.load(std::memory_order_relaxed);
+}
+
+void buffer_cpu_inplace_reader::post_read(int num_items)
+{
+    size_t bytes_read = num_items * _itemsize;
+
+    _read_index += bytes_read;
+    if (_read_index >= _buffer->buf_size()) {
+        _read_index -= _buffer->buf_size();
+    }
+    _total_read += num_items;
+
+    // Hand the memory back to the writer of the upstream buffer
+    _bytes_read.store(_bytes_read.load(std::memory_order_relaxed) + bytes_read,
+                      std::memory_order_release);
+}
+
+} // namespace gr
@@ -0,0 +1,263 @@
+#include <gnuradio/buffer_cpu_lockfree.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdexcept>
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#include "pagesize.h"
+#include <fmt/core.h>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+
+namespace gr {
+
+namespace {
+
+/**
+ * @brief Open an anonymous shared memory object of the given size
+ *
+ * memfd_create is used where available, otherwise a named POSIX shared memory segment
+ * is created and immediately unlinked.  Huge pages are only available through memfd.
+ */
+int open_anonymous_shm(size_t size, bool hugepages)
+{
+    int fd = -1;
+#if defined(HAVE_MEMFD_CREATE)
+#if defined(MFD_HUGETLB)
+    fd = memfd_create("gnuradio-lockfree", hugepages ? MFD_HUGETLB : 0);
+#else
+    if (!hugepages) {
+        fd = memfd_create("gnuradio-lockfree", 0);
+    }
+#endif
+#endif
+    if (hugepages) {
+        if (fd != -1 && ftruncate(fd, (off_t)size) == -1) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+#if defined(HAVE_SHM_OPEN)
+    if (fd == -1) {
+        static std::mutex s_seg_mutex;
+        static int s_seg_counter = 0;
+        std::scoped_lock guard(s_seg_mutex);
+        while (fd == -1) {
+            auto seg_name =
+                fmt::format("/gnuradio-lockfree-{}-{}", getpid(), s_seg_counter++);
+            fd = shm_open(seg_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (fd == -1 && errno != EEXIST) {
+                return -1;
+            }
+            if (fd != -1) {
+                shm_unlink(seg_name.c_str());
+            }
+        }
+    }
+#endif
+    if (fd != -1 && ftruncate(fd, (off_t)size) == -1) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+buffer_sptr
+buffer_cpu_lockfree::make(size_t num_items,
+                          size_t item_size,
+                          std::shared_ptr<buffer_properties> buffer_properties)
+{
+    return buffer_sptr(new buffer_cpu_lockfree(num_items, item_size, buffer_properties));
+}
+
+buffer_cpu_lockfree::buffer_cpu_lockfree(
+    size_t num_items, size_t item_size, std::shared_ptr<buffer_properties> buf_properties)
+    : buffer(num_items, item_size, buf_properties)
+{
+    set_type("buffer_cpu_lockfree");
+    gr::configure_default_loggers(d_logger, d_debug_logger, "buffer_cpu_lockfree");
+
+#if !defined(HAVE_MMAP) || (!defined(HAVE_MEMFD_CREATE) && !defined(HAVE_SHM_OPEN))
+    d_logger->error("mmap with memfd_create or shm_open is not available");
+    throw std::runtime_error("gr::buffer_cpu_lockfree");
+#else
+    if (buf_properties && buf_properties->hugepages()) {
+        if (gr::hugepagesize() > 0 &&
+            map_buffer(num_items, item_size, gr::hugepagesize(), true)) {
+            _hugepages = true;
+            return;
+        }
+        d_logger->warn("could not allocate huge pages, falling back to regular pages");
+    }
+
+    if (!map_buffer(num_items, item_size, gr::pagesize(), false)) {
+        d_logger->error("could not map buffer: {}", strerror(errno));
+        throw std::runtime_error("gr::buffer_cpu_lockfree");
+    }
+#endif
+}
+
+bool buffer_cpu_lockfree::map_buffer(size_t num_items,
+                                     size_t item_size,
+                                     size_t granularity,
+                                     bool hugepages)
+{
+#if !defined(HAVE_MMAP)
+    return false;
+#else
+    // Force the buffer to align with both the items and the page size
+    auto min_buffer_items = granularity / std::gcd(item_size, granularity);
+    if (num_items % min_buffer_items != 0)
+        num_items = ((num_items / min_buffer_items) + 1) * min_buffer_items;
+
+    auto requested_size = num_items * item_size;
+    auto npages = requested_size / granularity;
+    if (requested_size != granularity * npages) {
+        npages++;
+    }
+    auto buf_size = granularity * npages;
+
+    int fd = open_anonymous_shm(buf_size, hugepages);
+    if (fd == -1) {
+        return false;
+    }
+
+    // Reserve a contiguous region twice the size of the buffer, then map the same
+    // memory object into both halves.  Huge page mappings have to start on a huge page
+    // boundary, so reserve an extra page to be able to align the start.
+    auto reserved_size = 2 * buf_size + (hugepages ? granularity : 0);
+    void* reserved =
+        mmap(nullptr, reserved_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    auto base = (uint8_t*)(((uintptr_t)reserved + granularity - 1) & ~(granularity - 1));
+
+    for (int i = 0; i < 2; i++) {
+        void* half = mmap(base + i * buf_size,
+                          buf_size,
+                          PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_FIXED,
+                          fd,
+                          0);
+        if (half == MAP_FAILED) {
+            d_debug_logger->debug("mmap ({}) failed: {}", i + 1, strerror(errno));
+            close(fd);
+            munmap(reserved, reserved_size);
+            return false;
+        }
+    }
+
+    close(fd); // the mappings keep the memory object alive
+
+    _buf_size = buf_size;
+    _num_items = _buf_size / item_size;
+    _write_index = 0;
+    _buffer = base;
+    _mapped_base = reserved;
+    _mapped_size = reserved_size;
+    return true;
+#endif
+}
+
+buffer_cpu_lockfree::~buffer_cpu_lockfree()
+{
+#if defined(HAVE_MMAP)
+    if (_mapped_base && munmap(_mapped_base, _mapped_size) == -1) {
+        d_logger->error("munmap failed");
+    }
+#endif
+}
+
+size_t buffer_cpu_lockfree::space_available()
+{
+    // Only the writer thread modifies the write count
+    auto written = _bytes_written.load(std::memory_order_relaxed);
+
+    // Find the max number of bytes not yet consumed across readers
+    uint64_t n_unread = 0;
+    for (auto& r : _lockfree_readers) {
+        auto n = written - r->bytes_read();
+        n += r->inplace_bytes_unread();
+        if (n > n_unread) {
+            n_unread = n;
+        }
+    }
+
+    // The counters are monotonic, so unlike the read/write index comparison a full
+    // buffer is distinguishable from an empty one and no item needs to be kept free
+    size_t space_in_items = (_buf_size - n_unread) / _item_size;
+    return fill_limit(space_in_items, n_unread / _item_size);
+}
+
+bool buffer_cpu_lockfree::write_info(buffer_info_t& info)
+{
+    info.ptr = write_ptr();
+    info.n_items = space_available();
+    info.item_size = _item_size;
+    info.total_items = _total_written;
+
+    return true;
+}
+
+void buffer_cpu_lockfree::post_write(int num_items)
+{
+    size_t bytes_written = num_items * _item_size;
+
+    // advance the write pointer
+    _write_index += bytes_written;
+    if (_write_index >= _buf_size) {
+        _write_index -= _buf_size;
+    }
+    _total_written += num_items;
+
+    // Publish the written items, the data stores must be visible to readers first
+    _bytes_written.store(_bytes_written.load(std::memory_order_relaxed) + bytes_written,
+                         std::memory_order_release);
+}
+
+std::shared_ptr<buffer_reader>
+buffer_cpu_lockfree::add_reader(std::shared_ptr<buffer_properties> buf_props,
+                                size_t itemsize)
+{
+    std::shared_ptr<buffer_cpu_lockfree_reader> r(new buffer_cpu_lockfree_reader(
+        shared_from_this(), buf_props, itemsize, bytes_written()));
+    _readers.push_back(r.get());
+    _lockfree_readers.push_back(r.get());
+    return r;
+}
+
+uint64_t buffer_cpu_lockfree_reader::bytes_available()
+{
+    return _lockfree_buffer->bytes_written() -
+           _bytes_read.load(std::memory_order_relaxed);
+}
+
+void buffer_cpu_lockfree_reader::post_read(int num_items)
+{
+    size_t bytes_read = num_items * _itemsize;
+
+    // advance the read pointer
+    _read_index += bytes_read;
+    if (_read_index >= _buffer->buf_size()) {
+        _read_index -= _buffer->buf_size();
+    }
+    _total_read += num_items;
+
+    // Hand the space back to the writer once we are done reading from it
+    _bytes_read.store(_bytes_read.load(std::memory_order_relaxed) + bytes_read,
+                      std::memory_order_release);
+}
+
+} // namespace gr
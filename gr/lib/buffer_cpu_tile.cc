@@ -0,0 +1,101 @@
+#include <gnuradio/buffer_cpu_tile.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+
+namespace {
+// Keep the start of every tile on a cache line, which also satisfies the alignment
+// the aligned volk kernels ask for
+constexpr size_t s_tile_alignment = 64;
+} // namespace
+
+buffer_sptr buffer_cpu_tile::make(size_t num_items,
+                                  size_t item_size,
+                                  std::shared_ptr<buffer_properties> buffer_properties)
+{
+    return buffer_sptr(new buffer_cpu_tile(num_items, item_size, buffer_properties));
+}
+
+buffer_cpu_tile::buffer_cpu_tile(size_t num_items,
+                                 size_t item_size,
+                                 std::shared_ptr<buffer_properties> buf_properties)
+    : buffer(num_items, item_size, buf_properties)
+{
+    set_type("buffer_cpu_tile");
+
+    _storage.resize(_buf_size + s_tile_alignment);
+    _buffer = (uint8_t*)(((uintptr_t)_storage.data() + s_tile_alignment - 1) &
+                         ~(s_tile_alignment - 1));
+    _write_index = 0;
+}
+
+size_t buffer_cpu_tile::space_available()
+{
+    rewind();
+    return (_buf_size - _write_index) / _item_size;
+}
+
+bool buffer_cpu_tile::write_info(buffer_info_t& info)
+{
+    info.n_items = space_available();
+    info.ptr = write_ptr();
+    info.item_size = _item_size;
+    info.total_items = _total_written;
+
+    return true;
+}
+
+void buffer_cpu_tile::post_write(int num_items)
+{
+    _write_index += num_items * _item_size;
+    _total_written += num_items;
+}
+
+void buffer_cpu_tile::rewind()
+{
+    if (!_tile_reader) {
+        // Nobody reads what is written, so nothing needs to be kept
+        _write_index = 0;
+        return;
+    }
+
+    auto read_index = _tile_reader->read_index();
+    if (read_index == 0) {
+        return;
+    }
+    auto unread = _write_index - read_index;
+    if (unread > 0) {
+        memmove(_buffer, _buffer + read_index, unread);
+    }
+    _write_index = unread;
+    _tile_reader->set_read_index(0);
+}
+
+std::shared_ptr<buffer_reader>
+buffer_cpu_tile::add_reader(std::shared_ptr<buffer_properties> buf_props,
+                            size_t itemsize)
+{
+    if (_tile_reader) {
+        throw std::runtime_error("buffer_cpu_tile supports a single reader");
+    }
+    std::shared_ptr<buffer_cpu_tile_reader> r(
+        new buffer_cpu_tile_reader(shared_from_this(), buf_props, itemsize));
+    _readers.push_back(r.get());
+    _tile_reader = r.get();
+    return r;
+}
+
+uint64_t buffer_cpu_tile_reader::bytes_available()
+{
+    return _buffer->write_index() - _read_index;
+}
+
+void buffer_cpu_tile_reader::post_read(int num_items)
+{
+    _read_index += num_items * _itemsize;
+    _total_read += num_items;
+}
+
+} // namespace gr
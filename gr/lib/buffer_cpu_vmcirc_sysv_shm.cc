@@ -14,14 +14,34 @@
 #include "pagesize.h"
 #include <gnuradio/logger.h>
 #include <cerrno>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 
 #define MAX_SYSV_SHM_ATTEMPTS 3
 
 namespace gr {
+
+namespace {
+
+bool wants_hugepages(const std::shared_ptr<buffer_properties>& buf_properties)
+{
+#if defined(SHM_HUGETLB)
+    return buf_properties && buf_properties->hugepages() && gr::hugepagesize() > 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
 buffer_cpu_vmcirc_sysv_shm::buffer_cpu_vmcirc_sysv_shm(
     size_t num_items, size_t item_size, std::shared_ptr<buffer_properties> buf_properties)
-    : buffer_cpu_vmcirc(num_items, item_size, gr::pagesize(), buf_properties)
+    : buffer_cpu_vmcirc(num_items,
+                        item_size,
+                        wants_hugepages(buf_properties) ? gr::hugepagesize()
+                                                        : gr::pagesize(),
+                        buf_properties)
 {
     set_type("buffer_cpu_vmcirc_sysv_shm");
 
@@ -39,6 +59,40 @@ buffer_cpu_vmcirc_sysv_shm::buffer_cpu_vmcirc_sysv_shm(
         throw std::runtime_error("gr::buffer_cpu_vmcirc_sysv_shm");
     }
 
+    // The size is already a multiple of the huge page size, and stays usable with
+    // regular pages if no huge pages can be had
+    if (wants_hugepages(buf_properties)) {
+        if (map_buffer(true)) {
+            _hugepages = true;
+            return;
+        }
+        d_logger->warn("could not allocate huge pages, falling back to regular pages");
+    }
+
+    if (!map_buffer(false)) {
+        throw std::runtime_error("gr::buffer_cpu_vmcirc_sysv_shm");
+    }
+#endif
+}
+
+bool buffer_cpu_vmcirc_sysv_shm::map_buffer(bool hugepages)
+{
+#if !defined(HAVE_SYS_SHM_H)
+    return false;
+#else
+    int pagesize = gr::pagesize();
+
+    // Huge page segments have to be attached on a huge page boundary, so room is
+    // reserved to move the first copy up to the next one
+    int shm_flags = 0;
+    size_t alignment = pagesize;
+#if defined(SHM_HUGETLB)
+    if (hugepages) {
+        shm_flags = SHM_HUGETLB;
+        alignment = gr::hugepagesize();
+    }
+#endif
+
     // Attempt to allocate buffers (handle bad_alloc errors)
     int attempts_remain(MAX_SYSV_SHM_ATTEMPTS);
     while (attempts_remain-- > 0) {
@@ -51,27 +105,33 @@ buffer_cpu_vmcirc_sysv_shm::buffer_cpu_vmcirc_sysv_shm(
         // buffer. Ideally we'd map it no access, but I don't think that's possible with
         // SysV
         if ((shmid_guard = shmget(IPC_PRIVATE, pagesize, IPC_CREAT | 0400)) == -1) {
-            d_logger->error("shmget (0): %s", strerror(errno));
+            d_logger->error("shmget (0): {}", strerror(errno));
             continue;
         }
 
-        if ((shmid2 = shmget(
-                 IPC_PRIVATE, 2 * _buf_size + 2 * pagesize, IPC_CREAT | 0700)) == -1) {
-            d_logger->error("shmget (1): %s", strerror(errno));
+        if ((shmid2 = shmget(IPC_PRIVATE,
+                             2 * _buf_size + 2 * pagesize + (alignment - pagesize),
+                             IPC_CREAT | 0700)) == -1) {
+            d_logger->error("shmget (1): {}", strerror(errno));
             shmctl(shmid_guard, IPC_RMID, 0);
             continue;
         }
 
-        if ((shmid1 = shmget(IPC_PRIVATE, _buf_size, IPC_CREAT | 0700)) == -1) {
-            d_logger->error("shmget (2): %s", strerror(errno));
+        if ((shmid1 = shmget(IPC_PRIVATE, _buf_size, IPC_CREAT | shm_flags | 0700)) ==
+            -1) {
             shmctl(shmid_guard, IPC_RMID, 0);
             shmctl(shmid2, IPC_RMID, 0);
+            if (hugepages) {
+                // not enough huge pages reserved, retrying will not help
+                return false;
+            }
+            d_logger->error("shmget (2): {}", strerror(errno));
             continue;
         }
 
-        void* first_copy = shmat(shmid2, 0, 0);
-        if (first_copy == (void*)-1) {
-            d_logger->error("shmat (1): %s", strerror(errno));
+        void* reserved = shmat(shmid2, 0, 0);
+        if (reserved == (void*)-1) {
+            d_logger->error("shmat (1): {}", strerror(errno));
             shmctl(shmid_guard, IPC_RMID, 0);
             shmctl(shmid2, IPC_RMID, 0);
             shmctl(shmid1, IPC_RMID, 0);
@@ -87,19 +147,23 @@ buffer_cpu_vmcirc_sysv_shm::buffer_cpu_vmcirc_sysv_shm(
         // some other segment to first_copy or first_copoy + _buf_size between
         // our detach and attach, the attaches below could fail [I've never
         // seen it fail for this reason].
-        shmdt(first_copy);
+        shmdt(reserved);
+
+        auto aligned = ((uintptr_t)reserved + pagesize + alignment - 1) / alignment;
+        auto buffer = (uint8_t*)(aligned * alignment);
+        auto first_copy = buffer - pagesize;
 
         // first read-only guard page
         if (shmat(shmid_guard, first_copy, SHM_RDONLY) == (void*)-1) {
-            d_logger->error("shmat (2): %s", strerror(errno));
+            d_logger->error("shmat (2): {}", strerror(errno));
             shmctl(shmid_guard, IPC_RMID, 0);
             shmctl(shmid1, IPC_RMID, 0);
             continue;
         }
 
         // first copy
-        if (shmat(shmid1, (uint8_t*)first_copy + pagesize, 0) == (void*)-1) {
-            d_logger->error("shmat (3): %s", strerror(errno));
+        if (shmat(shmid1, buffer, 0) == (void*)-1) {
+            d_logger->error("shmat (3): {}", strerror(errno));
             shmctl(shmid_guard, IPC_RMID, 0);
             shmctl(shmid1, IPC_RMID, 0);
             shmdt(first_copy);
@@ -107,24 +171,23 @@ buffer_cpu_vmcirc_sysv_shm::buffer_cpu_vmcirc_sysv_shm(
         }
 
         // second copy
-        if (shmat(shmid1, (uint8_t*)first_copy + pagesize + _buf_size, 0) == (void*)-1) {
-            d_logger->error("shmat (4): %s", strerror(errno));
+        if (shmat(shmid1, buffer + _buf_size, 0) == (void*)-1) {
+            d_logger->error("shmat (4): {}", strerror(errno));
             shmctl(shmid_guard, IPC_RMID, 0);
             shmctl(shmid1, IPC_RMID, 0);
-            shmdt((uint8_t*)first_copy + pagesize);
+            shmdt(first_copy);
+            shmdt(buffer);
             continue;
         }
 
         // second read-only guard page
-        if (shmat(shmid_guard,
-                  (uint8_t*)first_copy + pagesize + 2 * _buf_size,
-                  SHM_RDONLY) == (void*)-1) {
-            d_logger->error("shmat (5): %s", strerror(errno));
+        if (shmat(shmid_guard, buffer + 2 * _buf_size, SHM_RDONLY) == (void*)-1) {
+            d_logger->error("shmat (5): {}", strerror(errno));
             shmctl(shmid_guard, IPC_RMID, 0);
             shmctl(shmid1, IPC_RMID, 0);
             shmdt(first_copy);
-            shmdt((uint8_t*)first_copy + pagesize);
-            shmdt((uint8_t*)first_copy + pagesize + _buf_size);
+            shmdt(buffer);
+            shmdt(buffer + _buf_size);
             continue;
         }
 
@@ -132,13 +195,11 @@ buffer_cpu_vmcirc_sysv_shm::buffer_cpu_vmcirc_sysv_shm(
         shmctl(shmid_guard, IPC_RMID, 0);
 
         // Now remember the important stuff
-        _buffer = (uint8_t*)first_copy + pagesize;
+        _buffer = buffer;
 
-        break;
-    }
-    if (attempts_remain < 0) {
-        throw std::runtime_error("gr::buffer_cpu_vmcirc_sysv_shm");
+        return true;
     }
+    return false;
 #endif
 }
 
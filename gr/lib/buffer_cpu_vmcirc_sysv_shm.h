@@ -5,6 +5,8 @@
 namespace gr {
 class buffer_cpu_vmcirc_sysv_shm : public buffer_cpu_vmcirc
 {
+private:
+    bool map_buffer(bool hugepages);
 
 public:
     using sptr = std::shared_ptr<buffer_cpu_vmcirc>;
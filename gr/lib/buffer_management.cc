@@ -1,4 +1,13 @@
 #include <gnuradio/buffer_management.h>
+#include <gnuradio/buffer_cpu_inplace.h>
+#include <gnuradio/buffer_cpu_tile.h>
+
+#include <fmt/core.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <set>
+#include <stdexcept>
 
 namespace gr {
 
@@ -6,10 +15,13 @@ void buffer_manager::initialize_buffers(flat_graph_sptr fg,
                                         std::shared_ptr<buffer_properties> buf_props,
                                         neighbor_interface_sptr sched_intf)
 {
+    _size_report.clear();
+
     // not all edges may be used
     for (auto e : fg->stream_edges()) {
         // every edge needs a buffer
-        auto num_items = get_buffer_num_items(e, fg);
+        std::string reason;
+        auto num_items = get_buffer_num_items(e, fg, reason);
 
         if (e->src().port()) {
             // If buffer has not yet been created, e.g. 1:N block connection
@@ -19,8 +31,19 @@ void buffer_manager::initialize_buffers(flat_graph_sptr fg,
                 if (std::find(fg->nodes().begin(), fg->nodes().end(), e->src().node()) !=
                     fg->nodes().end()) {
 
+                    // Created on top of the reader of the block's input below
+                    auto src_block = std::dynamic_pointer_cast<block>(e->src().node());
+                    if (src_block && inplace_input(src_block, fg)) {
+                        continue;
+                    }
+
                     buffer_sptr buf;
-                    if (e->has_custom_buffer()) {
+                    if (_tile_edges.count(e)) {
+                        num_items = std::max<size_t>(_tile_bytes / e->itemsize(), 1);
+                        reason = "fused tile";
+                        buf = buffer_cpu_tile::make(num_items, e->itemsize(), nullptr);
+                    }
+                    else if (e->has_custom_buffer()) {
                         buf = e->buffer_factory()(
                             num_items, e->itemsize(), e->buf_properties());
                     }
@@ -30,12 +53,15 @@ void buffer_manager::initialize_buffers(flat_graph_sptr fg,
                     e->src().port()->set_buffer(buf);
 
                     d_debug_logger->debug(
-                                "Edge: {}, Buf: {}, {} bytes, {} items of size {}",
+                                "Edge: {}, Buf: {}, {} bytes, {} items of size {} ({})",
                                 e->identifier(),
                                 buf->type(),
                                 buf->buf_size(),
                                 buf->num_items(),
-                                buf->item_size());
+                                buf->item_size(),
+                                reason);
+                    _size_report.push_back(
+                        { e->identifier(), buf->num_items(), buf->item_size(), reason });
                 }
             }
             else {
@@ -51,11 +77,60 @@ void buffer_manager::initialize_buffers(flat_graph_sptr fg,
         }
     }
 
+    // The output of an in-place block reuses the memory its input reads from, so it can
+    // only be created once that reader exists.  The buffer upstream of it may be in-place
+    // as well, so they are created in the order of the chain.
+    std::vector<std::pair<block_sptr, edge_sptr>> pending;
+    std::set<edge_sptr> inplace_edges;
+    for (auto& b : fg->calc_used_blocks()) {
+        auto e = inplace_input(b, fg);
+        if (e) {
+            pending.emplace_back(b, e);
+        }
+    }
+    while (!pending.empty()) {
+        auto it = std::find_if(pending.begin(), pending.end(), [](auto& bp) {
+            return bp.second->src().port()->buffer() != nullptr;
+        });
+        if (it == pending.end()) {
+            throw std::runtime_error("In-place buffers form a cycle");
+        }
+        auto [b, e] = *it;
+        pending.erase(it);
+
+        auto src_buf = e->src().port()->buffer();
+        auto out_port = b->output_stream_ports()[0];
+        auto out_edge = fg->find_edge(out_port)[0];
+
+        std::string reason;
+        buffer_sptr buf;
+        if (buffer_cpu_inplace::supports(src_buf)) {
+            add_reader(e, sched_intf);
+            inplace_edges.insert(e);
+            buf = buffer_cpu_inplace::make(e->dst().port()->buffer_reader(), src_buf);
+            reason = fmt::format("in place over {}", e->identifier());
+        }
+        else {
+            auto num_items = get_buffer_num_items(out_edge, fg, reason);
+            buf = buf_props->factory()(num_items, out_edge->itemsize(), buf_props);
+        }
+        out_port->set_buffer(buf);
+
+        d_debug_logger->debug("Edge: {}, Buf: {}, {} bytes, {} items of size {} ({})",
+                              out_edge->identifier(),
+                              buf->type(),
+                              buf->buf_size(),
+                              buf->num_items(),
+                              buf->item_size(),
+                              reason);
+        _size_report.push_back(
+            { out_edge->identifier(), buf->num_items(), buf->item_size(), reason });
+    }
+
     // Assuming all the buffers that the readers will be attaching to have been created at
     // this point.  Will need to handle crossings separately if doing something complex
     for (auto& b : fg->calc_used_blocks()) {
         port_vector_t input_ports = b->input_stream_ports();
-        port_vector_t output_ports = b->output_stream_ports();
 
         for (auto p : input_ports) {
             edge_vector_t ed = fg->find_edge(p);
@@ -65,33 +140,184 @@ void buffer_manager::initialize_buffers(flat_graph_sptr fg,
 
             // TODO: more robust way of ensuring readers don't get double-added
             // If dst block is in this domain, then add the reader to the source port
-            if (std::find(fg->nodes().begin(), fg->nodes().end(), ed[0]->dst().node()) !=
-                fg->nodes().end()) {
+            if (!inplace_edges.count(ed[0]) &&
+                std::find(fg->nodes().begin(), fg->nodes().end(), ed[0]->dst().node()) !=
+                    fg->nodes().end()) {
+                add_reader(ed[0], sched_intf);
+            }
+        }
+    }
 
-                if (ed[0]->buf_properties() &&
-                    ed[0]->buf_properties()->reader_factory()) {
-                    d_debug_logger->debug(
-                                "Creating Buffer Reader for Edge: {}, Independently",
-                                ed[0]->identifier());
-                    p->set_buffer_reader(ed[0]->buf_properties()->reader_factory()(
-                        ed[0]->dst().port()->itemsize(), ed[0]->buf_properties()));
-                    p->buffer_reader()->set_parent_intf(sched_intf);
-                }
-                else {
-                    
-                        d_debug_logger->debug(
-                        "Adding Buffer Reader for Edge: {}, to buffer on Block {}",
-                        ed[0]->identifier(),
-                        ed[0]->src().identifier());
-                    p->set_buffer_reader(ed[0]->src().port()->buffer()->add_reader(
-                        ed[0]->buf_properties(), ed[0]->dst().port()->itemsize()));
+    mark_tag_consumers(fg);
+}
+
+void buffer_manager::add_reader(edge_sptr e, neighbor_interface_sptr sched_intf)
+{
+    auto p = e->dst().port();
+    if (e->stride() > 1) {
+        // A block that reads its input contiguously would see the wrong items
+        auto dst_block = std::dynamic_pointer_cast<block>(e->dst().node());
+        if (dst_block && !dst_block->strided_input()) {
+            throw std::invalid_argument(
+                fmt::format("Edge {} is strided, but block {} does not read strided "
+                            "inputs",
+                            e->identifier(),
+                            dst_block->alias()));
+        }
+    }
+
+    if (e->buf_properties() && e->buf_properties()->reader_factory()) {
+        d_debug_logger->debug("Creating Buffer Reader for Edge: {}, Independently",
+                              e->identifier());
+        p->set_buffer_reader(e->buf_properties()->reader_factory()(
+            e->dst().port()->itemsize(), e->buf_properties()));
+        p->buffer_reader()->set_parent_intf(sched_intf);
+    }
+    else {
+        d_debug_logger->debug("Adding Buffer Reader for Edge: {}, to buffer on Block {}",
+                              e->identifier(),
+                              e->src().identifier());
+        p->set_buffer_reader(e->src().port()->buffer()->add_reader(
+            e->buf_properties(), e->dst().port()->itemsize()));
+    }
+
+    if (e->stride() > 1) {
+        p->buffer_reader()->set_stride(e->stride_offset(), e->stride());
+    }
+}
+
+edge_sptr buffer_manager::inplace_input(block_sptr b, flat_graph_sptr fg)
+{
+    if (!_inplace || !b->inplace() || b->relative_rate() != 1.0 ||
+        b->input_stream_ports().size() != 1 || b->output_stream_ports().size() != 1 ||
+        std::find(fg->nodes().begin(), fg->nodes().end(), b) == fg->nodes().end()) {
+        return nullptr;
+    }
+
+    // The producer upstream has to have this block as its only reader, otherwise the
+    // other readers would see the results instead of the items they were given
+    auto in_edges = fg->find_edge(b->input_stream_ports()[0]);
+    if (in_edges.size() != 1) {
+        return nullptr;
+    }
+    auto e = in_edges[0];
+    if (std::find(fg->nodes().begin(), fg->nodes().end(), e->src().node()) ==
+            fg->nodes().end() ||
+        fg->find_edge(e->src().port()).size() != 1 || e->has_custom_buffer() ||
+        _tile_edges.count(e) || e->stride() != 1 ||
+        e->dst().port()->itemsize() != e->itemsize()) {
+        return nullptr;
+    }
+
+    auto out_edges = fg->find_edge(b->output_stream_ports()[0]);
+    if (out_edges.empty()) {
+        return nullptr;
+    }
+    for (auto& oe : out_edges) {
+        if (oe->has_custom_buffer() || _tile_edges.count(oe) ||
+            oe->itemsize() != e->itemsize()) {
+            return nullptr;
+        }
+    }
+
+    return e;
+}
+
+void buffer_manager::mark_tag_consumers(flat_graph_sptr fg)
+{
+    // A buffer needs its tags if a block downstream reads them, or propagates them on to
+    // a block that does.  Anything outside of this graph is assumed to need them.
+    std::map<block_sptr, bool> needs_tags;
+    std::function<bool(block_sptr)> block_needs_tags;
+    std::function<bool(port_sptr)> port_needs_tags;
+
+    port_needs_tags = [&](port_sptr port) {
+        for (auto& e : fg->find_edge(port)) {
+            if (e->src().port() != port) {
+                continue;
+            }
+            auto dst = std::dynamic_pointer_cast<block>(e->dst().node());
+            if (!dst ||
+                std::find(fg->nodes().begin(), fg->nodes().end(), e->dst().node()) ==
+                    fg->nodes().end() ||
+                block_needs_tags(dst)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    block_needs_tags = [&](block_sptr b) {
+        auto it = needs_tags.find(b);
+        if (it != needs_tags.end()) {
+            return it->second;
+        }
+
+        bool ret = b->consumes_tags();
+        auto tpp = b->tag_propagation_policy();
+        if (!ret && (tpp == tag_propagation_policy_t::TPP_ALL_TO_ALL ||
+                     tpp == tag_propagation_policy_t::TPP_ONE_TO_ONE)) {
+            for (auto& p : b->output_stream_ports()) {
+                if (port_needs_tags(p)) {
+                    ret = true;
+                    break;
                 }
             }
         }
+
+        needs_tags[b] = ret;
+        return ret;
+    };
+
+    for (auto& b : fg->calc_used_blocks()) {
+        for (auto& p : b->output_stream_ports()) {
+            auto buf = p->buffer();
+            if (buf && std::find(fg->nodes().begin(), fg->nodes().end(), b) !=
+                           fg->nodes().end()) {
+                buf->set_tags_needed(port_needs_tags(p));
+                d_debug_logger->debug("Buffer {}, tags needed: {}",
+                                      buf->name(),
+                                      buf->tags_needed());
+            }
+        }
     }
 }
 
-int buffer_manager::get_buffer_num_items(edge_sptr e, flat_graph_sptr fg)
+double buffer_manager::output_rate(block_sptr b,
+                                   flat_graph_sptr fg,
+                                   std::map<block_sptr, double>& rates)
+{
+    auto it = rates.find(b);
+    if (it != rates.end()) {
+        return it->second;
+    }
+    // Guards against cycles, which only message edges should be able to form
+    rates[b] = 0;
+
+    // Sources produce at the sample rate, everything else at the fastest of its inputs
+    // scaled by its own relative rate
+    double rate = 0;
+    bool has_inputs = false;
+    for (auto& p : b->input_stream_ports()) {
+        for (auto& e : fg->find_edge(p)) {
+            auto src = std::dynamic_pointer_cast<block>(e->src().node());
+            if (src && e->dst().port() == p) {
+                has_inputs = true;
+                rate = std::max(rate, output_rate(src, fg, rates));
+            }
+        }
+    }
+    if (!has_inputs) {
+        rate = _sample_rate;
+    }
+    rate *= b->relative_rate();
+
+    rates[b] = rate;
+    return rate;
+}
+
+size_t
+buffer_manager::get_buffer_num_items(edge_sptr e, flat_graph_sptr fg, std::string& reason)
 {
     size_t item_size = e->itemsize();
 
@@ -100,21 +326,25 @@ int buffer_manager::get_buffer_num_items(edge_sptr e, flat_graph_sptr fg)
     // (We're double buffering, where we used to single buffer)
 
     size_t buf_size = s_fixed_buf_size;
+    reason = "default size";
     if (e->has_custom_buffer()) {
 
         auto req_buf_size = e->buf_properties()->buffer_size();
 
         if (req_buf_size > 0) {
             buf_size = req_buf_size;
+            reason = "requested size";
         }
         else {
             auto max_buf_size = e->buf_properties()->max_buffer_size();
             auto min_buf_size = e->buf_properties()->min_buffer_size();
-            if (max_buf_size > 0) {
-                buf_size = std::min(buf_size, max_buf_size);
+            if (max_buf_size > 0 && max_buf_size < buf_size) {
+                buf_size = max_buf_size;
+                reason = "requested max size";
             }
-            if (min_buf_size > 0) {
-                buf_size = std::max(buf_size, min_buf_size);
+            if (min_buf_size > 0 && min_buf_size > buf_size) {
+                buf_size = min_buf_size;
+                reason = "requested min size";
             }
         }
     }
@@ -127,8 +357,34 @@ int buffer_manager::get_buffer_num_items(edge_sptr e, flat_graph_sptr fg)
         grblock = std::dynamic_pointer_cast<block>(e->dst().node());
     }
 
+    // Shrink to the latency target, unless the size was asked for explicitly
+    if (_max_latency > 0 && _sample_rate > 0 && reason == "default size") {
+        std::map<block_sptr, double> rates;
+        auto rate = e->src().node() == grblock ? output_rate(grblock, fg, rates)
+                                               : _sample_rate;
+        auto latency_items = static_cast<size_t>(_max_latency * rate);
+        if (rate > 0 && latency_items < nitems) {
+            nitems = std::max(latency_items, s_min_buf_items);
+            reason = "latency target";
+        }
+    }
+
+    // Whatever the target, the buffer has to hold twice what the blocks on either side
+    // need for a single call to work, otherwise the flowgraph can deadlock
+    auto require = [&](size_t n, const std::string& why) {
+        if (n > nitems) {
+            nitems = n;
+            reason = why;
+        }
+    };
+
     if (grblock->output_multiple_set()) {
-        nitems = std::max(nitems, static_cast<size_t>(2 * (grblock->output_multiple())));
+        require(2 * grblock->output_multiple(),
+                fmt::format("output multiple of {}", grblock->alias()));
+    }
+    if (grblock->min_work_items() > 0) {
+        require(2 * grblock->min_work_items(),
+                fmt::format("minimum work of {}", grblock->alias()));
     }
 
     // If any downstream blocks are decimators and/or have a large output_multiple,
@@ -138,15 +394,18 @@ int buffer_manager::get_buffer_num_items(edge_sptr e, flat_graph_sptr fg)
     auto blocks = fg->calc_downstream_blocks(grblock, e->src().port());
 
     for (auto& p : blocks) {
-        // block_sptr dgrblock = cast_to_block_sptr(*p);
-        // if (!dgrblock)
-        //     throw std::runtime_error("allocate_buffer found non-gr::block");
-
-        // double decimation = (1.0 / dgrblock->relative_rate());
         double decimation = (1.0 / p->relative_rate());
         int multiple = p->output_multiple();
-        nitems = std::max(nitems, static_cast<size_t>(2 * (decimation * multiple)));
-        // std::max(nitems, static_cast<int>(2 * (decimation * multiple)));
+        require(static_cast<size_t>(2 * (decimation * multiple)),
+                fmt::format("decimation of {}", p->alias()));
+        require(2 * p->min_input_items(),
+                fmt::format("minimum input of {}", p->alias()));
+        require(2 * p->min_work_items(), fmt::format("minimum work of {}", p->alias()));
+    }
+
+    if (e->has_custom_buffer()) {
+        require(2 * e->buf_properties()->min_buffer_read(), "requested min read");
+        require(2 * e->buf_properties()->min_buffer_fill(), "requested min fill");
     }
 
     return nitems;
@@ -153,12 +153,10 @@ size_t buffer_sm::space_available()
 
     if (space == 0)
         return space;
-    // Only half fill the buffer
-    // Leave extra space in case the reader gets stuck and needs realignment
 
-    space = std::min(space, _num_items / 2);
-
-    return space;
+    // The default of half filling the buffer also leaves extra space in case the reader
+    // gets stuck and needs realignment
+    return fill_limit(space, _readers.empty() ? 0 : total_written() - min_items_read);
 }
 
 bool buffer_sm::write_info(buffer_info_t& info)
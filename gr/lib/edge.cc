@@ -47,6 +47,30 @@ size_t edge::itemsize() const
         return _dst.port()->itemsize();
 }
 
+void edge::set_stride(size_t offset, size_t stride)
+{
+    if (stride == 0 || offset >= stride) {
+        throw std::invalid_argument("Invalid stride for edge " + identifier());
+    }
+    _stride_offset = offset;
+    _stride = stride;
+}
+
+void edge::copy_settings(const sptr& other)
+{
+    _buffer_properties = other->_buffer_properties;
+    _stride_offset = other->_stride_offset;
+    _stride = other->_stride;
+}
+
+edge_perf_snapshot edge::perf_counters() const
+{
+    if (!_dst.port() || !_dst.port()->buffer_reader()) {
+        return edge_perf_snapshot();
+    }
+    return _dst.port()->buffer_reader()->perf_counters().snapshot();
+}
+
 bool edge::has_custom_buffer()
 {
     if (_buffer_properties) {
@@ -2,6 +2,9 @@
 
 #include <gnuradio/block.h>
 #include <gnuradio/domain.h>
+#include <gnuradio/sync_block.h>
+#include <map>
+#include <set>
 
 namespace gr {
 
@@ -37,8 +40,7 @@ graph_utils::partition(graph_sptr input_graph,
                     // Is the other block in our current partition
                     if (std::find(nodes.begin(), nodes.end(), other_block) !=
                         nodes.end()) {
-                        g->connect(e->src(), e->dst())
-                            ->set_custom_buffer(e->buf_properties());
+                        g->connect(e->src(), e->dst())->copy_settings(e);
                     }
                     else {
                         // add this edge to the list of domain crossings
@@ -143,4 +145,72 @@ void graph_utils::connect_crossings(
 }
 
 
+namespace {
+
+bool fusable(const block_sptr& b)
+{
+    if (!std::dynamic_pointer_cast<sync_block>(b)) {
+        return false;
+    }
+    if (b->input_stream_ports().size() != 1 || b->output_stream_ports().size() != 1) {
+        return false;
+    }
+    if (b->relative_rate() != 1.0 || b->output_multiple_set() ||
+        b->min_input_items() > 0 || b->min_work_items() > 0) {
+        return false;
+    }
+    // Blocks forwarding tags themselves expect to see the whole of their buffers
+    return b->tag_propagation_policy() != tag_propagation_policy_t::TPP_CUSTOM;
+}
+
+} // namespace
+
+std::vector<fused_chain> graph_utils::sync_chains(flat_graph_sptr fg,
+                                                  const std::vector<block_sptr>& blocks)
+{
+    std::set<block_sptr> candidates;
+    for (auto& b : blocks) {
+        if (fusable(b)) {
+            candidates.insert(b);
+        }
+    }
+
+    // The one edge linking each candidate to the next block of its chain
+    std::map<block_sptr, edge_sptr> next;
+    std::set<block_sptr> has_prev;
+    for (auto& b : candidates) {
+        auto edges = fg->find_edge(b->output_stream_ports()[0]);
+        if (edges.size() != 1) {
+            continue;
+        }
+        auto& e = edges[0];
+        auto dst = std::dynamic_pointer_cast<block>(e->dst().node());
+        if (!dst || !candidates.count(dst) || e->has_custom_buffer() ||
+            e->stride() != 1) {
+            continue;
+        }
+        next[b] = e;
+        has_prev.insert(dst);
+    }
+
+    std::vector<fused_chain> ret;
+    for (auto& b : blocks) {
+        if (!next.count(b) || has_prev.count(b)) {
+            continue;
+        }
+        fused_chain chain;
+        chain.blocks.push_back(b);
+        auto it = next.find(b);
+        while (it != next.end()) {
+            chain.edges.push_back(it->second);
+            chain.blocks.push_back(
+                std::dynamic_pointer_cast<block>(it->second->dst().node()));
+            it = next.find(chain.blocks.back());
+        }
+        ret.push_back(std::move(chain));
+    }
+
+    return ret;
+}
+
 } // namespace gr
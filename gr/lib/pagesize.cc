@@ -16,6 +16,8 @@
 #include <gnuradio/logger.h>
 #include <unistd.h>
 #include <cstdio>
+#include <fstream>
+#include <string>
 
 namespace gr {
 
@@ -46,4 +48,22 @@ int pagesize()
     return s_pagesize;
 }
 
+size_t hugepagesize()
+{
+    static size_t s_hugepagesize = [] {
+        // e.g. "Hugepagesize:       2048 kB"
+        std::ifstream meminfo("/proc/meminfo");
+        std::string key;
+        size_t value;
+        while (meminfo >> key) {
+            if (key == "Hugepagesize:" && meminfo >> value) {
+                return value * 1024;
+            }
+            meminfo.ignore(256, '\n');
+        }
+        return (size_t)0;
+    }();
+    return s_hugepagesize;
+}
+
 } /* namespace gr */
@@ -91,6 +91,16 @@ void port_base::push_message(scheduler_message_sptr msg)
     }
 }
 
+void port_base::push_messages(const std::vector<scheduler_message_sptr>& msgs)
+{
+    if (_parent_intf) {
+        _parent_intf->push_messages(msgs);
+    }
+    else {
+        std::cout << "port has no parent interface" << std::endl;
+    }
+}
+
 void port_base::connect(port_interface_sptr other_port)
 {
 
@@ -106,7 +116,9 @@ void port_base::connect(port_interface_sptr other_port)
 
 void port_base::disconnect(port_interface_sptr other_port)
 {
-    std::remove(_connected_ports.begin(), _connected_ports.end(), other_port);
+    _connected_ports.erase(
+        std::remove(_connected_ports.begin(), _connected_ports.end(), other_port),
+        _connected_ports.end());
 }
 
 template <typename T>
@@ -173,22 +185,88 @@ message_port::message_port(const std::string& name,
 }
 
 
+void message_port::bind_destinations()
+{
+    _destinations.clear();
+    if (direction() != port_direction_t::OUTPUT) {
+        return;
+    }
+    for (auto& p : _connected_ports) {
+        if (!p) {
+            continue;
+        }
+        auto mp = dynamic_cast<message_port*>(p.get());
+        _destinations.push_back({ p.get(), mp ? &mp->_callback_fcn : nullptr });
+    }
+}
+
+void message_port::connect(port_interface_sptr other_port)
+{
+    port_base::connect(other_port);
+    bind_destinations();
+}
+
+void message_port::disconnect(port_interface_sptr other_port)
+{
+    port_base::disconnect(other_port);
+    bind_destinations();
+}
+
 void message_port::post(pmtf::pmt msg)
 {
-    if (direction() == port_direction_t::OUTPUT)
-        notify_connected_ports(std::make_shared<msgport_message>(msg, nullptr));
+    if (direction() == port_direction_t::OUTPUT) {
+        for (auto& d : _destinations) {
+            d.port->push_message(msgport_message::make(msg, d.callback));
+        }
+    }
     else {
-        push_message(std::make_shared<msgport_message>(msg, _callback_fcn));
+        port_base::push_message(msgport_message::make(std::move(msg), &_callback_fcn));
     }
 }
+
+void message_port::post_many(const std::vector<pmtf::pmt>& msgs)
+{
+    std::vector<scheduler_message_sptr> batch(msgs.size());
+    if (direction() == port_direction_t::OUTPUT) {
+        for (auto& d : _destinations) {
+            for (size_t i = 0; i < msgs.size(); i++) {
+                batch[i] = msgport_message::make(msgs[i], d.callback);
+            }
+            d.port->push_messages(batch);
+        }
+    }
+    else {
+        for (size_t i = 0; i < msgs.size(); i++) {
+            batch[i] = msgport_message::make(msgs[i], &_callback_fcn);
+        }
+        port_base::push_messages(batch);
+    }
+}
+
 void message_port::push_message(scheduler_message_sptr msg)
 {
+    // Messages posted by another message port already know their callback, those
+    // arriving from elsewhere are bound to this port here
     auto m = std::static_pointer_cast<msgport_message>(msg);
-    m->set_callback(callback());
+    if (!m->has_callback()) {
+        m->bind_callback(&_callback_fcn);
+    }
 
     port_base::push_message(msg);
 }
 
+void message_port::push_messages(const std::vector<scheduler_message_sptr>& msgs)
+{
+    for (auto& msg : msgs) {
+        auto m = std::static_pointer_cast<msgport_message>(msg);
+        if (!m->has_callback()) {
+            m->bind_callback(&_callback_fcn);
+        }
+    }
+
+    port_base::push_messages(msgs);
+}
+
 template class port<float>;
 template class port<double>;
 template class port<gr_complex>;
@@ -1 +1,71 @@
 #include <gnuradio/pyblock_detail.h>
+
+#include <stdexcept>
+
+namespace gr {
+
+ndarray_views::~ndarray_views()
+{
+    if (!Py_IsInitialized()) {
+        // The interpreter has already freed whatever the views refer to
+        for (auto* views : { &d_inputs, &d_outputs }) {
+            for (auto& v : *views) {
+                v.dtype.release();
+            }
+        }
+        return;
+    }
+    py::gil_scoped_acquire acquire;
+    d_inputs.clear();
+    d_outputs.clear();
+}
+
+py::array ndarray_views::point(view& v, const port_sptr& p, void* items, size_t nitems)
+{
+    if (!v.dtype) {
+        if (!p) {
+            throw std::out_of_range("ndarray_views: no such stream port");
+        }
+        v.dtype = py::dtype(p->format_descriptor());
+        v.shape = { 0 };
+        auto shape = p->shape();
+        if (!shape.empty() && shape.back() == 1) {
+            shape.pop_back();
+        }
+        v.shape.insert(v.shape.end(), shape.begin(), shape.end());
+    }
+
+    // A new array every call, so that numpy works out its flags (e.g. whether it is
+    // also Fortran contiguous) for this number of items.  The base keeps pybind11 from
+    // copying the items.
+    v.shape[0] = static_cast<py::ssize_t>(nitems);
+    return py::array(v.dtype, v.shape, items, py::none());
+}
+
+py::array ndarray_views::input(block& b, block_work_input& w, size_t index)
+{
+    if (index >= d_inputs.size()) {
+        d_inputs.resize(index + 1);
+    }
+    auto& v = d_inputs[index];
+    port_sptr p;
+    if (!v.array) {
+        p = b.get_port(index, port_type_t::STREAM, port_direction_t::INPUT);
+    }
+    return point(v, p, const_cast<void*>(w.raw_items()), w.n_items);
+}
+
+py::array ndarray_views::output(block& b, block_work_output& w, size_t index)
+{
+    if (index >= d_outputs.size()) {
+        d_outputs.resize(index + 1);
+    }
+    auto& v = d_outputs[index];
+    port_sptr p;
+    if (!v.array) {
+        p = b.get_port(index, port_type_t::STREAM, port_direction_t::OUTPUT);
+    }
+    return point(v, p, w.raw_items(), w.n_items);
+}
+
+} // namespace gr
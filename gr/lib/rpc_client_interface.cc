@@ -44,6 +44,21 @@ std::string rpc_client_interface::block_parameter_query(const std::string& block
     }
 }
 
+std::vector<std::string>
+rpc_client_interface::block_parameters_query(const std::string& block_name,
+                                             const std::vector<std::string>& parameters)
+{
+    if (pb_detail()) {
+        py::gil_scoped_acquire acquire;
+
+        py::object ret = this->pb_detail()->handle().attr("block_parameters_query")(
+            block_name, parameters);
+
+        return ret.cast<std::vector<std::string>>();
+    }
+    return {};
+}
+
 void rpc_client_interface::block_parameter_change(const std::string& block_name,
                                                   const std::string& parameter,
                                                   const std::string& payload)
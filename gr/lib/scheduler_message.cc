@@ -19,7 +19,7 @@ scheduler_message_sptr msgport_message::from_json(const std::string& str)
         throw std::runtime_error("Invalid message type for msgport_message");
     }
     auto msg = pmtf::pmt::from_base64(str);
-    return std::make_shared<msgport_message>(msg, nullptr);
+    return msgport_message::make(msg);
 }
 
 } // namespace gr
@@ -127,6 +127,12 @@ void set_thread_name(gr_thread_t thread, const std::string& name)
 }
 #endif /* !__MINGW32__ */
 
+int numa_node_of_processor(unsigned int n)
+{
+    // Not implemented on Windows
+    return -1;
+}
+
 } /* namespace thread */
 } /* namespace gr */
 
@@ -199,6 +205,12 @@ void set_thread_name(gr_thread_t thread, const std::string& name)
     // Not implemented on OSX
 }
 
+int numa_node_of_processor(unsigned int n)
+{
+    // Not implemented on OSX
+    return -1;
+}
+
 } /* namespace thread */
 } /* namespace gr */
 
@@ -206,6 +218,8 @@ void set_thread_name(gr_thread_t thread, const std::string& name)
 
 #include <pthread.h>
 #include <sys/prctl.h>
+#include <cctype>
+#include <filesystem>
 #include <sstream>
 #include <stdexcept>
 
@@ -321,6 +335,21 @@ void set_thread_name(gr_thread_t thread, const std::string& name)
     prctl(PR_SET_NAME, name.c_str(), 0, 0, 0);
 }
 
+int numa_node_of_processor(unsigned int n)
+{
+    // Each cpu directory holds a nodeN link to the node it belongs to
+    std::error_code ec;
+    auto cpu_dir = std::filesystem::path(fmt::format("/sys/devices/system/cpu/cpu{}", n));
+    for (auto& entry : std::filesystem::directory_iterator(cpu_dir, ec)) {
+        auto name = entry.path().filename().string();
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+            std::isdigit(name[4])) {
+            return std::stoi(name.substr(4));
+        }
+    }
+    return -1;
+}
+
 } /* namespace thread */
 } /* namespace gr */
 
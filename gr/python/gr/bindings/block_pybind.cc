@@ -16,13 +16,52 @@ namespace py = pybind11;
 #include <gnuradio/block.h>
 #include <gnuradio/pyblock_detail.h>
 
+#include <chrono>
+#include <future>
+
 // pydoc.h is automatically generated in the build directory
 // #include <block_pydoc.h>
 
+namespace {
+
+// Futures of the asynchronous parameter requests, waited on without holding the GIL
+template <typename T>
+void bind_future(py::module& m, const char* name)
+{
+    using future = std::shared_future<T>;
+
+    py::class_<future>(m, name)
+        .def(
+            "get",
+            [](const future& f) { return f.get(); },
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "wait",
+            [](const future& f) { f.wait(); },
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "wait_for",
+            [](const future& f, double timeout) {
+                return f.wait_for(std::chrono::duration<double>(timeout)) ==
+                       std::future_status::ready;
+            },
+            py::arg("timeout"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("ready", [](const future& f) {
+            return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+}
+
+} // namespace
+
 void bind_block(py::module& m)
 {
     using block = ::gr::block;
 
+    bind_future<pmtf::pmt>(m, "parameter_query_future");
+    bind_future<std::vector<pmtf::pmt>>(m, "parameters_query_future");
+    bind_future<void>(m, "parameter_change_future");
+
     py::class_<block, gr::node, std::shared_ptr<block>>(m, "block")
         .def("work",
              &block::work,
@@ -31,6 +70,9 @@ void bind_block(py::module& m)
         .def("base", &block::base)
         .def_static("cast", &block::cast)
         .def("set_pyblock_detail", &block::set_pyblock_detail)
+        .def("pb_detail", &block::pb_detail)
+        .def("set_min_work_items", &block::set_min_work_items, py::arg("min_items"))
+        .def("min_work_items", &block::min_work_items)
         .def("produce_each", &block::produce_each)
         .def("consume_each", &block::consume_each)
         .def("request_parameter_query",
@@ -38,10 +80,73 @@ void bind_block(py::module& m)
         .def("request_parameter_query",
              py::overload_cast<const std::string&>(&block::request_parameter_query))
         .def("request_parameter_change",
-             py::overload_cast<int, pmtf::pmt, bool>(&block::request_parameter_change))
+             py::overload_cast<int, pmtf::pmt, bool, uint64_t>(
+                 &block::request_parameter_change),
+             py::arg("param_id"),
+             py::arg("new_value"),
+             py::arg("block") = true,
+             py::arg("at_sample") = 0)
         .def("request_parameter_change",
-             py::overload_cast<const std::string&, pmtf::pmt, bool>(
-                 &block::request_parameter_change))
+             py::overload_cast<const std::string&, pmtf::pmt, bool, uint64_t>(
+                 &block::request_parameter_change),
+             py::arg("param_str"),
+             py::arg("new_value"),
+             py::arg("block") = true,
+             py::arg("at_sample") = 0)
+        .def("request_parameters_query",
+             &block::request_parameters_query,
+             py::arg("param_strs"),
+             py::call_guard<py::gil_scoped_release>())
+        .def(
+            "request_parameter_query_async",
+            [](block& b, int param_id) {
+                return b.request_parameter_query_async(param_id).share();
+            },
+            py::arg("param_id"))
+        .def(
+            "request_parameter_query_async",
+            [](block& b, const std::string& param_str) {
+                return b.request_parameter_query_async(param_str).share();
+            },
+            py::arg("param_str"))
+        .def(
+            "request_parameters_query_async",
+            [](block& b, const std::vector<int>& param_ids) {
+                return b.request_parameters_query_async(param_ids).share();
+            },
+            py::arg("param_ids"))
+        .def(
+            "request_parameters_query_async",
+            [](block& b, const std::vector<std::string>& param_strs) {
+                std::vector<int> param_ids;
+                for (auto& str : param_strs) {
+                    param_ids.push_back(b.get_param_id(str));
+                }
+                return b.request_parameters_query_async(param_ids).share();
+            },
+            py::arg("param_strs"))
+        .def(
+            "request_parameter_change_async",
+            [](block& b, int param_id, pmtf::pmt new_value, uint64_t at_sample) {
+                return b.request_parameter_change_async(param_id, new_value, at_sample)
+                    .share();
+            },
+            py::arg("param_id"),
+            py::arg("new_value"),
+            py::arg("at_sample") = 0)
+        .def(
+            "request_parameter_change_async",
+            [](block& b,
+               const std::string& param_str,
+               pmtf::pmt new_value,
+               uint64_t at_sample) {
+                return b.request_parameter_change_async(param_str, new_value, at_sample)
+                    .share();
+            },
+            py::arg("param_str"),
+            py::arg("new_value"),
+            py::arg("at_sample") = 0)
         .def_static("deserialize_param_to_pmt", &block::deserialize_param_to_pmt)
+        .def("perf_counters", [](block& b) { return b.perf_counters().snapshot(); })
         .def("to_json", &block::to_json);
 }
@@ -0,0 +1,26 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/buffer_cpu_lockfree.h>
+
+void bind_buffer_cpu_lockfree(py::module& m)
+{
+    using buffer_cpu_lockfree_properties = ::gr::buffer_cpu_lockfree_properties;
+
+    py::class_<buffer_cpu_lockfree_properties,
+               gr::buffer_properties,
+               std::shared_ptr<buffer_cpu_lockfree_properties>>(
+        m, "buffer_cpu_lockfree_properties")
+        .def_static("make", &buffer_cpu_lockfree_properties::make);
+}
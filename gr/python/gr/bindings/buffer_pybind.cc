@@ -21,6 +21,12 @@ void bind_buffer(py::module& m)
 {
     using buffer_properties = ::gr::buffer_properties;
 
+    py::enum_<gr::buffer_fill_policy_t>(m, "buffer_fill_policy_t")
+        .value("FRACTION", gr::buffer_fill_policy_t::FRACTION)
+        .value("FULL", gr::buffer_fill_policy_t::FULL)
+        .value("ADAPTIVE", gr::buffer_fill_policy_t::ADAPTIVE)
+        .export_values();
+
     py::class_<buffer_properties, std::shared_ptr<buffer_properties>>(m,
                                                                       "buffer_properties")
         .def("set_buffer_size", &buffer_properties::set_buffer_size)
@@ -29,5 +35,10 @@ void bind_buffer(py::module& m)
         .def("set_max_buffer_fill", &buffer_properties::set_max_buffer_fill)
         .def("set_min_buffer_fill", &buffer_properties::set_min_buffer_fill)
         .def("set_max_buffer_read", &buffer_properties::set_max_buffer_read)
-        .def("set_min_buffer_read", &buffer_properties::set_min_buffer_read);
+        .def("set_min_buffer_read", &buffer_properties::set_min_buffer_read)
+        .def("set_hugepages", &buffer_properties::set_hugepages)
+        .def("set_fill_policy",
+             &buffer_properties::set_fill_policy,
+             py::arg("policy"),
+             py::arg("fraction") = 0.5);
 }
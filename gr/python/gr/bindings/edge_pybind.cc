@@ -32,7 +32,9 @@ void bind_edge(py::module& m)
                 return ::gr::edge::make(a, b, c, d);
             }))
         .def("set_custom_buffer", &edge::set_custom_buffer)
+        .def("set_stride", &edge::set_stride, py::arg("offset"), py::arg("stride"))
         .def("identifier", &edge::identifier)
+        .def("perf_counters", &edge::perf_counters)
         .def("src", &edge::src)
         .def("dst", &edge::dst);
 }
@@ -24,6 +24,7 @@ void bind_port(py::module&);
 void bind_block_work_io(py::module&);
 void bind_node(py::module&);
 void bind_pyblock_detail(py::module&);
+void bind_perf_counters(py::module&);
 void bind_block(py::module&);
 void bind_sync_block(py::module&);
 void bind_edge(py::module&);
@@ -33,6 +34,7 @@ void bind_flowgraph(py::module&);
 void bind_scheduler(py::module&);
 void bind_buffer(py::module&);
 void bind_vmcircbuf(py::module&);
+void bind_buffer_cpu_lockfree(py::module&);
 void bind_domain(py::module&);
 void bind_constants(py::module&);
 void bind_python_block(py::module&);
@@ -72,6 +74,7 @@ PYBIND11_MODULE(gr_python, m)
     bind_port(m);
     bind_node(m);
     bind_pyblock_detail(m);
+    bind_perf_counters(m);
     bind_block(m);
     bind_sync_block(m);
     bind_edge(m);
@@ -83,6 +86,7 @@ PYBIND11_MODULE(gr_python, m)
     bind_buffer(m);
     bind_buffer_net_zmq(m);
     bind_vmcircbuf(m);
+    bind_buffer_cpu_lockfree(m);
     bind_constants(m);
     bind_python_block(m);
     bind_runtime(m);
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/perf_counters.h>
+
+void bind_perf_counters(py::module& m)
+{
+    using block_perf_snapshot = ::gr::block_perf_snapshot;
+    using edge_perf_snapshot = ::gr::edge_perf_snapshot;
+
+    py::class_<block_perf_snapshot>(m, "block_perf_snapshot")
+        .def_readonly("work_calls", &block_perf_snapshot::work_calls)
+        .def_readonly("items_in", &block_perf_snapshot::items_in)
+        .def_readonly("items_out", &block_perf_snapshot::items_out)
+        .def_readonly("work_time", &block_perf_snapshot::work_time)
+        .def_readonly("blocked_in", &block_perf_snapshot::blocked_in)
+        .def_readonly("blocked_out", &block_perf_snapshot::blocked_out)
+        .def_readonly("avg_input_fullness", &block_perf_snapshot::avg_input_fullness)
+        .def_readonly("avg_output_fullness", &block_perf_snapshot::avg_output_fullness);
+
+    py::class_<edge_perf_snapshot>(m, "edge_perf_snapshot")
+        .def_readonly("bytes", &edge_perf_snapshot::bytes)
+        .def_readonly("occupancy", &edge_perf_snapshot::occupancy);
+}
@@ -74,7 +74,8 @@ void bind_port(py::module& m)
                port_base,
                gr::port_interface,
                std::shared_ptr<message_port>>(m, "message_port")
-        .def("post", &message_port::post);
+        .def("post", &message_port::post)
+        .def("post_many", &message_port::post_many);
 
     py::class_<untyped_port, port_base, std::shared_ptr<untyped_port>>(m, "untyped_port")
         .def(py::init(&untyped_port::make),
@@ -20,5 +20,29 @@ void bind_pyblock_detail(py::module& m)
     using pyblock_detail = ::gr::pyblock_detail;
 
     py::class_<pyblock_detail, std::shared_ptr<pyblock_detail>>(m, "pyblock_detail")
-        .def(py::init<py::handle>());
+        .def(py::init<py::handle>())
+        .def(
+            "get_input_array",
+            [](pyblock_detail& self,
+               gr::block& b,
+               const py::sequence& work_input,
+               size_t index) {
+                return self.arrays.input(
+                    b, work_input[index].cast<gr::block_work_input&>(), index);
+            },
+            py::arg("block"),
+            py::arg("work_input"),
+            py::arg("index"))
+        .def(
+            "get_output_array",
+            [](pyblock_detail& self,
+               gr::block& b,
+               const py::sequence& work_output,
+               size_t index) {
+                return self.arrays.output(
+                    b, work_output[index].cast<gr::block_work_output&>(), index);
+            },
+            py::arg("block"),
+            py::arg("work_output"),
+            py::arg("index"));
 }
@@ -26,7 +26,23 @@ void bind_python_block(py::module& m)
 
         .def(py::init(&python_block::make), py::arg("p"), py::arg("name"))
 
-        .def("add_port", &python_block::add_port);
+        .def("add_port", &python_block::add_port)
+        .def(
+            "get_input_array",
+            [](python_block& self, const py::sequence& work_input, size_t index) {
+                return self.get_input_array(
+                    work_input[index].cast<gr::block_work_input&>(), index);
+            },
+            py::arg("work_input"),
+            py::arg("index"))
+        .def(
+            "get_output_array",
+            [](python_block& self, const py::sequence& work_output, size_t index) {
+                return self.get_output_array(
+                    work_output[index].cast<gr::block_work_output&>(), index);
+            },
+            py::arg("work_output"),
+            py::arg("index"));
 
     using python_sync_block = gr::python_sync_block;
     py::class_<python_sync_block,
@@ -36,7 +52,23 @@ void bind_python_block(py::module& m)
 
         .def(py::init(&python_sync_block::make), py::arg("p"), py::arg("name"))
 
-        .def("add_port", &python_sync_block::add_port);
+        .def("add_port", &python_sync_block::add_port)
+        .def(
+            "get_input_array",
+            [](python_sync_block& self, const py::sequence& work_input, size_t index) {
+                return self.get_input_array(
+                    work_input[index].cast<gr::block_work_input&>(), index);
+            },
+            py::arg("work_input"),
+            py::arg("index"))
+        .def(
+            "get_output_array",
+            [](python_sync_block& self, const py::sequence& work_output, size_t index) {
+                return self.get_output_array(
+                    work_output[index].cast<gr::block_work_output&>(), index);
+            },
+            py::arg("work_output"),
+            py::arg("index"));
 
 
     py::enum_<gr::py_block_t>(m, "py_block_t")
@@ -13,5 +13,16 @@ void bind_scheduler(py::module& m)
 {
     using scheduler = ::gr::scheduler;
 
-    py::class_<scheduler, std::shared_ptr<scheduler>>(m, "scheduler");
+    py::class_<gr::buffer_size_report>(m, "buffer_size_report")
+        .def_readonly("edge", &gr::buffer_size_report::edge)
+        .def_readonly("num_items", &gr::buffer_size_report::num_items)
+        .def_readonly("item_size", &gr::buffer_size_report::item_size)
+        .def_readonly("reason", &gr::buffer_size_report::reason);
+
+    py::class_<scheduler, std::shared_ptr<scheduler>>(m, "scheduler")
+        .def("set_buffer_latency_target",
+             &scheduler::set_buffer_latency_target,
+             py::arg("sample_rate"),
+             py::arg("max_latency"))
+        .def("buffer_sizes", &scheduler::buffer_sizes);
 }
@@ -49,7 +49,6 @@ class block(python_block):
         python_block.__init__(self, self, name)
 
     def handle_work(self, *args, **kwargs):
-        print ('handle_work')
         return self.work(*args, *kwargs)
 
     def work(self, *args, **kwargs):
@@ -68,7 +67,6 @@ class sync_block(python_sync_block):
         python_sync_block.__init__(self, self, name)
 
     def handle_work(self, *args, **kwargs):
-        print ('handle_work')
         return self.work(*args, *kwargs)
 
     def work(self, *args, **kwargs):
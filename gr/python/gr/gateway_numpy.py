@@ -10,45 +10,24 @@
 
 
 
-import numpy
-import ctypes
-
 from . import gr_python as gr
 from .gr_python import python_block, python_sync_block
 
 
-########################################################################
-# Magic to turn pointers into numpy arrays
-# http://docs.scipy.org/doc/numpy/reference/arrays.interface.html
-########################################################################
-
-def pointer_to_ndarray(addr, typestr, shape, nitems):
-
-    if len(shape) > 0 and shape[-1] == 1:
-        shape = shape[:-1]
-    shape = (nitems,) + tuple(shape)
-    class array_like(object):
-        __array_interface__ = {
-            'data': (int(addr), False),
-            'typestr': typestr,
-            'descr': None,
-            'shape': shape,
-            'strides': None,
-            'version': 3
-        }
-    return numpy.asarray(array_like()).view()
-
 ########################################################################
 # io_signature for Python
 ########################################################################
 
 class block(python_block):
 
-    def __init__(self, name):
+    def __init__(self, name, min_work_items=0):
         python_block.__init__(self, self, name)
+        # Every work call takes the GIL, so Python blocks that can wait for more
+        # items per call run faster
+        if min_work_items:
+            self.set_min_work_items(min_work_items)
 
     def handle_work(self, *args, **kwargs):
-        print ('handle_work')
         return self.work(*args, *kwargs)
 
     def work(self, *args, **kwargs):
@@ -63,11 +42,12 @@ class block(python_block):
 
 class sync_block(python_sync_block):
 
-    def __init__(self, name):
+    def __init__(self, name, min_work_items=0):
         python_sync_block.__init__(self, self, name)
+        if min_work_items:
+            self.set_min_work_items(min_work_items)
 
     def handle_work(self, *args, **kwargs):
-        print ('handle_work')
         return self.work(*args, *kwargs)
 
     def work(self, *args, **kwargs):
@@ -79,28 +59,3 @@ class sync_block(python_sync_block):
 
     def stop(self):
         return True
-
-    def get_input_array(self, work_input, index):
-        ctypes.pythonapi.PyCapsule_GetPointer.restype = ctypes.c_void_p
-        ctypes.pythonapi.PyCapsule_GetPointer.argtypes = [
-            ctypes.py_object, ctypes.c_char_p]
-
-        port = self.get_port(index, gr.STREAM, gr.INPUT)
-        return pointer_to_ndarray(
-                ctypes.pythonapi.PyCapsule_GetPointer(work_input[index].raw_items(), None),
-                port.format_descriptor(),
-                port.shape(),
-                work_input[index].n_items)
-
-    def get_output_array(self, work_output, index):
-        ctypes.pythonapi.PyCapsule_GetPointer.restype = ctypes.c_void_p
-        ctypes.pythonapi.PyCapsule_GetPointer.argtypes = [
-            ctypes.py_object, ctypes.c_char_p]
-
-        port = self.get_port(index, gr.STREAM, gr.OUTPUT)
-
-        return pointer_to_ndarray(
-                ctypes.pythonapi.PyCapsule_GetPointer(work_output[index].raw_items(), None),
-                port.format_descriptor(),
-                port.shape(),
-                work_output[index].n_items)
\ No newline at end of file
@@ -37,6 +37,15 @@ def pointer_to_ndarray(addr, typestr, shape, nitems):
 
 
 def get_input_array(self, work_input, index):
+    """numpy view of the items of input `index` in this work call
+
+    The dtype and shape are cached by the pyblock_detail of the block and the array is
+    built in C++, so only blocks without one go through ctypes
+    """
+    detail = self.pb_detail()
+    if detail:
+        return detail.get_input_array(self, work_input, index)
+
     ctypes.pythonapi.PyCapsule_GetPointer.restype = ctypes.c_void_p
     ctypes.pythonapi.PyCapsule_GetPointer.argtypes = [
         ctypes.py_object, ctypes.c_char_p]
@@ -49,6 +58,11 @@ def get_input_array(self, work_input, index):
             work_input[index].n_items)
 
 def get_output_array(self, work_output, index):
+    """numpy view of the items of output `index` in this work call"""
+    detail = self.pb_detail()
+    if detail:
+        return detail.get_output_array(self, work_output, index)
+
     ctypes.pythonapi.PyCapsule_GetPointer.restype = ctypes.c_void_p
     ctypes.pythonapi.PyCapsule_GetPointer.argtypes = [
         ctypes.py_object, ctypes.c_char_p]
@@ -59,4 +73,4 @@ def get_output_array(self, work_output, index):
             ctypes.pythonapi.PyCapsule_GetPointer(work_output[index].raw_items(), None),
             port.format_descriptor(),
             port.shape(),
-            work_output[index].n_items)
\ No newline at end of file
+            work_output[index].n_items)
@@ -0,0 +1,68 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <gnuradio/kernel/fft/fftw_fft.h>
+
+#include <chrono>
+#include <iostream>
+
+#include "CLI/App.hpp"
+#include "CLI/Config.hpp"
+#include "CLI/Formatter.hpp"
+
+using namespace gr::kernel::fft;
+
+// Generates FFTW wisdom offline, so that flowgraphs with many fft based blocks do not
+// spend their startup measuring plans.  By default all powers of two from 16 to 65536
+// are planned, which covers the transform sizes fft_filter picks.
+int main(int argc, char* argv[])
+{
+    std::vector<int> sizes;
+    std::string rigor = "patient";
+    int nthreads = 1;
+
+    CLI::App app{ "Generate FFTW wisdom for GNU Radio" };
+
+    app.add_option("--sizes", sizes, "Transform sizes to plan");
+    app.add_option("--rigor", rigor, "Planner rigor (measure, patient, exhaustive)");
+    app.add_option("--nthreads", nthreads, "Number of threads to plan for");
+
+    CLI11_PARSE(app, argc, argv);
+
+    plan_rigor r;
+    if (rigor == "measure") {
+        r = plan_rigor::MEASURE;
+    }
+    else if (rigor == "patient") {
+        r = plan_rigor::PATIENT;
+    }
+    else if (rigor == "exhaustive") {
+        r = plan_rigor::EXHAUSTIVE;
+    }
+    else {
+        std::cerr << "Unknown rigor: " << rigor << std::endl;
+        return 1;
+    }
+
+    if (sizes.empty()) {
+        for (int size = 16; size <= 65536; size *= 2) {
+            sizes.push_back(size);
+        }
+    }
+
+    std::cout << "Writing wisdom to " << wisdom_filename() << std::endl;
+    for (auto size : sizes) {
+        auto t1 = std::chrono::steady_clock::now();
+        generate_wisdom({ size }, r, nthreads);
+        auto t2 = std::chrono::steady_clock::now();
+        std::cout << "size " << size << ": "
+                  << std::chrono::duration<double>(t2 - t1).count() << " s" << std::endl;
+    }
+}
@@ -13,6 +13,9 @@ namespace math {
 }
 namespace filter {
 
+}
+namespace streamops {
+
 }
 } // namespace kernel
 } // namespace gr
@@ -19,7 +19,10 @@
 #include <gnuradio/logger.h>
 #include <volk/volk_alloc.hh>
 
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace gr {
 namespace kernel {
@@ -55,6 +58,44 @@ public:
     static std::mutex& mutex();
 };
 
+/*!
+ * \brief Counters of the process-wide plan cache
+ */
+struct plan_cache_stats {
+    size_t plans_created = 0; ///< transforms that had to be planned by FFTW
+    size_t plans_shared = 0;  ///< transforms that reused an existing plan
+};
+
+/*!
+ * \brief Snapshot of the plan cache counters since the process started
+ */
+plan_cache_stats get_plan_cache_stats();
+
+/*!
+ * \brief Path of the FFTW wisdom file shared by all GNU Radio processes
+ */
+std::string wisdom_filename();
+
+/*!
+ * \brief How hard FFTW searches for the fastest plan, see the FFTW planner flags
+ */
+enum class plan_rigor { MEASURE, PATIENT, EXHAUSTIVE };
+
+/*!
+ * \brief Plan transforms ahead of time and add what FFTW learned to the wisdom file
+ *
+ * Complex transforms in both directions and real transforms in both directions are
+ * planned for every size, so that later plans of those sizes come straight from the
+ * wisdom file instead of being measured at flowgraph startup.
+ *
+ * \param sizes     transform sizes to plan
+ * \param rigor     planner rigor, plans made at startup use MEASURE
+ * \param nthreads  number of threads the plans are for
+ */
+void generate_wisdom(const std::vector<int>& sizes,
+                     plan_rigor rigor = plan_rigor::PATIENT,
+                     int nthreads = 1);
+
 
 /*!
   \brief FFT: templated
@@ -83,16 +124,25 @@ struct fft_outbuf<float, true> {
     using type = gr_complex;
 };
 
+/*!
+ * \brief FFTW transform with its own aligned input and output buffers
+ *
+ * Plans are shared process wide: every fftw_fft of the same size, type, number of
+ * threads and buffer alignment executes the same FFTW plan on its own buffers through
+ * the new-array execute functions, so only the first one pays for planning and for
+ * touching the wisdom file.
+ */
 template <class T, bool forward>
 class fftw_fft
 {
     int d_nthreads;
     volk::vector<typename fft_inbuf<T, forward>::type> d_inbuf;
     volk::vector<typename fft_outbuf<T, forward>::type> d_outbuf;
-    void* d_plan;
+    std::shared_ptr<void> d_plan;
     gr::logger_ptr d_logger;
     gr::logger_ptr d_debug_logger;
-    void initialize_plan(int fft_size);
+    void* initialize_plan(int fft_size);
+    std::shared_ptr<void> acquire_plan();
 
 public:
     fftw_fft(int fft_size, int nthreads = 1);
@@ -134,6 +184,52 @@ using fft_complex_rev = fftw_fft<gr_complex, false>;
 using fft_real_fwd = fftw_fft<float, true>;
 using fft_real_rev = fftw_fft<float, false>;
 
+/*!
+ * \brief Many complex FFTs of one size executed by a single FFTW plan
+ *
+ * The buffers hold \p howmany transforms side by side: element k of transform t is at
+ * index k * howmany + t, in the input as well as in the output.  Each row of the input
+ * is one input element over all the transforms, so a producer that computes a row at a
+ * time, such as a filterbank branch filtered over a block of time steps, writes it
+ * contiguously, and each row of the output is one bin over all the transforms.
+ *
+ * Plans are shared process wide in the same way as the ones of fftw_fft.
+ */
+template <bool forward>
+class fftw_fft_many
+{
+    int d_fft_size;
+    int d_howmany;
+    int d_nthreads;
+    volk::vector<gr_complex> d_inbuf;
+    volk::vector<gr_complex> d_outbuf;
+    std::shared_ptr<void> d_plan;
+    gr::logger_ptr d_logger;
+    gr::logger_ptr d_debug_logger;
+
+public:
+    fftw_fft_many(int fft_size, int howmany, int nthreads = 1);
+    // Copy disabled due to d_plan.
+    fftw_fft_many(const fftw_fft_many&) = delete;
+    fftw_fft_many& operator=(const fftw_fft_many&) = delete;
+
+    gr_complex* get_inbuf() { return d_inbuf.data(); }
+    gr_complex* get_outbuf() { return d_outbuf.data(); }
+
+    int fft_size() const { return d_fft_size; }
+    int howmany() const { return d_howmany; }
+    int nthreads() const { return d_nthreads; }
+
+    /*!
+     * compute all the FFTs. The input comes from inbuf, the output is placed in
+     * outbuf.
+     */
+    void execute();
+};
+
+using fft_complex_many_fwd = fftw_fft_many<true>;
+using fft_complex_many_rev = fftw_fft_many<false>;
+
 } // namespace fft
 } // namespace kernel
 } // namespace gr
\ No newline at end of file
@@ -134,6 +134,18 @@ public:
     int filter(int nitems, const T* input, T* output);
 };
 
+/*!
+ * \brief Whether overlap-save is expected to be cheaper than direct convolution
+ *
+ * Compares the multiply-accumulates per output of a direct form (polyphase when
+ * decimating) filter against the cost per output of the forward and inverse
+ * transforms and the spectral product that fft_filter computes for the same taps.
+ *
+ * \param ntaps      Number of taps in the filter
+ * \param decimation Decimation rate of the filter
+ */
+bool fft_filter_preferred(size_t ntaps, size_t decimation);
+
 } /* namespace filter */
 } /* namespace kernel */
 } /* namespace gr */
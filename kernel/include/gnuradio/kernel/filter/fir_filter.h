@@ -20,6 +20,18 @@ namespace gr {
 namespace kernel {
 namespace filter {
 
+/*!
+ * \brief Direct form FIR filter
+ *
+ * \details
+ * filter() computes a single output with a VOLK dot product.  filterN() and
+ * filterNdec() compute blocks of outputs at a time: for longer filters each tap is
+ * applied to a whole block of outputs at once so the inner loop runs over outputs
+ * rather than taps, and decimating filters are split into one polyphase branch per
+ * input phase so that only the outputs that are kept get computed.  Large calls can
+ * additionally be split across a small pool of threads shared by all filters, see
+ * set_nthreads().
+ */
 template <class IN_T, class OUT_T, class TAP_T>
 class fir_filter
 {
@@ -47,6 +59,15 @@ public:
                     unsigned long n,
                     unsigned int decimate);
 
+    /*!
+     * \brief Split filterN() and filterNdec() calls across up to \p nthreads threads
+     *
+     * Only calls that are large enough to amortize waking up the other threads are
+     * split, everything else runs on the calling thread.
+     */
+    void set_nthreads(unsigned int nthreads);
+    unsigned int nthreads() const { return d_nthreads; }
+
 protected:
     std::vector<TAP_T> d_taps;
     unsigned int d_ntaps;
@@ -54,6 +75,20 @@ protected:
     volk::vector<OUT_T> d_output;
     int d_align;
     int d_naligned;
+    unsigned int d_nthreads = 1;
+
+    // d_taps split by input phase for the decimation they were computed for
+    unsigned int d_poly_decimate = 0;
+    std::vector<std::vector<TAP_T>> d_poly_taps;
+
+    void filter_range(OUT_T output[],
+                      const IN_T input[],
+                      unsigned long n,
+                      unsigned int decimate);
+    void filter_block(OUT_T output[],
+                      const IN_T input[],
+                      unsigned long n,
+                      unsigned int decimate) const;
 };
 using fir_filter_fff = fir_filter<float, float, float>;
 using fir_filter_ccf = fir_filter<gr_complex, gr_complex, float>;
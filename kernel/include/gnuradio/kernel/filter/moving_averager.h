@@ -11,25 +11,86 @@
 #pragma once
 
 #include <gnuradio/kernel/api.h>
-#include <deque>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace gr {
 namespace kernel {
 namespace filter {
 
+/*!
+ * \brief Scaled sum of the last D samples
+ *
+ * \details
+ * filter() takes one sample at a time and filterN() a block of items.  The last D
+ * inputs are kept in a power-of-two ring buffer, so filterN() computes the differences
+ * in[i] - in[i - D] with VOLK straight from its input wherever the sample leaving the
+ * window is part of the same block, and only the running sum itself is left to a serial
+ * loop.  Items can be vectors of vlen samples, each averaged on its own.
+ *
+ * A running sum of floats picks up rounding error with every sample, so the sums are
+ * recomputed from the ring buffer every so often to keep the error bounded.
+ */
 template <class T>
 class moving_averager
 {
 public:
+    /*!
+     * \param D      number of samples averaged
+     */
     moving_averager(int D);
+    /*!
+     * \param D      number of samples summed
+     * \param scale  factor the sum is multiplied with
+     * \param vlen   samples per item
+     */
+    moving_averager(int D, T scale, size_t vlen = 1);
 
     T filter(T x);
+
+    /*!
+     * \brief Filter n items
+     *
+     * \param output   n items, must not overlap input
+     * \param input    n items
+     * \param n        number of items
+     * \param delayed  if not null, receives the input delayed by D - 1 items
+     */
+    void filterN(T output[], const T input[], size_t n, T delayed[] = nullptr);
+
     T delayed_sig() { return d_out; }
 
+    /*!
+     * \brief Change the number of samples summed
+     *
+     * The items the ring buffer still holds stay in the window, so the output carries
+     * on from the history instead of starting over from zero.  When the window grows
+     * past the old ring buffer, the items it did not hold count as zero.
+     */
+    void set_length(int D);
+    void set_scale(T scale) { d_scale = scale; }
+
+    int length() const { return d_length; }
+    T scale() const { return d_scale; }
+    size_t vlen() const { return d_vlen; }
+
 private:
     int d_length;
-    T d_out, d_out_d1, d_out_d2;
-    std::deque<T> d_delay_line;
+    T d_scale;
+    size_t d_vlen;
+    T d_out;
+
+    // Last d_mask + 1 items, item k at (k & d_mask) * d_vlen
+    std::vector<T> d_ring;
+    uint64_t d_mask;
+    uint64_t d_nitems = 0;
+
+    std::vector<T> d_sum;
+    uint64_t d_since_recompute = 0;
+
+    T* ring_item(uint64_t k) { return &d_ring[(k & d_mask) * d_vlen]; }
+    void recompute();
 };
 
 
@@ -13,6 +13,7 @@
 #include <gnuradio/kernel/api.h>
 #include <gnuradio/kernel/fft/fftw_fft.h>
 #include <gnuradio/kernel/filter/fir_filter.h>
+#include <memory>
 
 namespace gr {
 namespace kernel {
@@ -95,6 +96,12 @@ protected:
     // The FFT to handle the output de-spinning of the channels.
     gr::kernel::fft::fft_complex_rev d_fft;
 
+    // Block form of the same, for channelize(): row k of the input holds FFT input k
+    // for each time step of a tile of d_tile_steps steps
+    std::unique_ptr<gr::kernel::fft::fft_complex_many_rev> d_tile_fft;
+    unsigned int d_tile_steps = 0;
+    volk::vector<gr_complex> d_branch_out;
+
 public:
     /*!
      * Build the polyphase filterbank decimator.
@@ -116,6 +123,36 @@ public:
      */
     virtual void set_taps(const std::vector<float>& taps);
 
+    /*!
+     * \brief Filter and de-spin a block of time steps of the channelizer
+     *
+     * Equivalent to computing one output of every branch filter per time step into an
+     * FFT and de-spinning it, but done a tile of time steps at a time: each branch is
+     * filtered over the whole tile with one filterN() call (filterNdec() when
+     * oversampling) into a row of a matrix, all the FFTs of the tile run through one
+     * batched plan, and each output receives its bin for the whole tile with one copy.
+     *
+     * When oversampling, time step s reads sample n_s of the branches that have moved
+     * on to the next input sample and n_s - 1 of the others, starting at n_0 = 1.
+     *
+     * \param out          outputs, each receiving one item per time step
+     * \param noutputs     number of outputs
+     * \param in           d_nfilts deinterleaved branch inputs, each holding ninput
+     *                     samples plus the filter history
+     * \param ninput       number of new samples of each branch to go through
+     * \param rate_ratio   d_nfilts divided by the oversample rate
+     * \param idxlut       FFT input each branch goes to
+     * \param channel_map  FFT bin each output comes from
+     * \return number of time steps written to each output
+     */
+    size_t channelize(gr_complex* const out[],
+                      size_t noutputs,
+                      const gr_complex* const in[],
+                      size_t ninput,
+                      unsigned int rate_ratio,
+                      const std::vector<int>& idxlut,
+                      const std::vector<int>& channel_map);
+
     /*!
      * Print all of the filterbank taps to screen.
      */
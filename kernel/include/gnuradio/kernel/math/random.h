@@ -13,6 +13,7 @@
 #include <gnuradio/kernel/api.h>
 #include <gnuradio/gr_complex.h>
 #include <gnuradio/kernel/math/xoroshiro128p.h>
+#include <volk/volk_alloc.hh>
 
 #include <limits>
 #include <random>
@@ -76,6 +77,24 @@ protected:
         d_uniform; // choose uniform distribution, default is [0,1)
     std::uniform_int_distribution<int64_t> d_integer_dis;
 
+    // Bulk generation: s_lanes XOROSHIRO128+ generators, each on its own
+    // non-overlapping subsequence, stepped side by side so that the compiler can keep
+    // them all in vector registers.  Every step yields two floats per lane.
+    static constexpr size_t s_lanes = 8;
+    static constexpr size_t s_step = 2 * s_lanes;
+    static constexpr size_t s_gauss_block = 512;
+
+    alignas(64) uint64_t d_lane_state[2][s_lanes];
+    float d_uniform_buf[s_step];
+    size_t d_uniform_pos;
+    volk::vector<float> d_gauss_buf;
+    size_t d_gauss_pos;
+    volk::vector<float> d_radius;
+
+    void seed_lanes(uint64_t seed);
+    void uniform_steps(float* out, size_t nsteps);
+    void gaussian_block(float* out);
+
 public:
     random(uint64_t seed = 0, int64_t min_integer = 0, int64_t max_integer = 2);
     ~random();
@@ -133,6 +152,27 @@ public:
      * an uniform distribution for the phase.
      */
     gr_complex rayleigh_complex();
+
+    /*!
+     * \brief Fill out with n uniformly distributed numbers in [minimum, maximum)
+     *
+     * Bulk counterpart of ran1() for generating noise at high rates.  The numbers come
+     * from a separate set of generators, so they do not share a sequence with ran1().
+     * For a given seed the numbers are the same on every platform and do not depend on
+     * how they are split across calls: filling 1000 numbers is the same as filling 10
+     * and then 990.
+     */
+    void fill_uniform(float* out, size_t n, float minimum = 0, float maximum = 1);
+
+    /*!
+     * \brief Fill out with n normally distributed numbers with zero mean
+     *
+     * Bulk counterpart of gasdev(), computed with the Box-Muller transform over blocks
+     * of numbers from fill_uniform() using VOLK.  As with fill_uniform(), the numbers
+     * do not depend on how they are split across calls, but their last bits can differ
+     * between machines that run different VOLK kernels.
+     */
+    void fill_gaussian(float* out, size_t n, float stddev = 1);
 };
 
 } /* namespace gr */
@@ -0,0 +1,150 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <gnuradio/kernel/api.h>
+#include <volk/volk.h>
+#include <cstdint>
+#include <cstring>
+
+namespace gr {
+namespace kernel {
+namespace streamops {
+
+namespace detail {
+
+// Items are moved as a type of the same size so that the compiler can turn the copy
+// loops into vector loads, shuffles and stores instead of calls to memcpy
+template <size_t ITEMSIZE>
+struct item_type {
+    struct type {
+        uint8_t bytes[ITEMSIZE];
+    };
+};
+template <>
+struct item_type<1> {
+    using type = uint8_t;
+};
+template <>
+struct item_type<2> {
+    using type = uint16_t;
+};
+template <>
+struct item_type<4> {
+    using type = uint32_t;
+};
+template <>
+struct item_type<8> {
+    using type = uint64_t;
+};
+
+} // namespace detail
+
+/**
+ * @brief Split a stream of interleaved items into nstreams contiguous streams
+ *
+ * Item i of stream j is read from in[i * nstreams + j].  Deinterleaving in blocks of b
+ * items is the same as deinterleaving items of size b * ITEMSIZE.
+ *
+ * @param out nstreams output pointers, each with room for nitems items
+ * @param in nitems * nstreams interleaved items
+ * @param nstreams number of output streams
+ * @param nitems number of items to write to each output stream
+ */
+template <size_t ITEMSIZE>
+void deinterleave(void* const out[], const void* in, size_t nstreams, size_t nitems)
+{
+    using T = typename detail::item_type<ITEMSIZE>::type;
+    auto src = static_cast<const T*>(in);
+
+    if (nstreams == 2) {
+        if constexpr (ITEMSIZE == 4) {
+            // a complex float is a pair of interleaved floats
+            volk_32fc_deinterleave_32f_x2(static_cast<float*>(out[0]),
+                                          static_cast<float*>(out[1]),
+                                          static_cast<const lv_32fc_t*>(in),
+                                          nitems);
+            return;
+        }
+        else if constexpr (ITEMSIZE == 2) {
+            volk_16ic_deinterleave_16i_x2(static_cast<int16_t*>(out[0]),
+                                          static_cast<int16_t*>(out[1]),
+                                          static_cast<const lv_16sc_t*>(in),
+                                          nitems);
+            return;
+        }
+        auto out0 = static_cast<T*>(out[0]);
+        auto out1 = static_cast<T*>(out[1]);
+        for (size_t i = 0; i < nitems; i++) {
+            out0[i] = src[2 * i];
+            out1[i] = src[2 * i + 1];
+        }
+        return;
+    }
+
+    if (nstreams == 4) {
+        auto out0 = static_cast<T*>(out[0]);
+        auto out1 = static_cast<T*>(out[1]);
+        auto out2 = static_cast<T*>(out[2]);
+        auto out3 = static_cast<T*>(out[3]);
+        for (size_t i = 0; i < nitems; i++) {
+            out0[i] = src[4 * i];
+            out1[i] = src[4 * i + 1];
+            out2[i] = src[4 * i + 2];
+            out3[i] = src[4 * i + 3];
+        }
+        return;
+    }
+
+    // Walk the input in order, every output stream is written sequentially as well
+    for (size_t i = 0; i < nitems; i++) {
+        for (size_t j = 0; j < nstreams; j++) {
+            static_cast<T*>(out[j])[i] = *src++;
+        }
+    }
+}
+
+/**
+ * @brief Split a stream of interleaved items of a size only known at runtime
+ *
+ * Dispatches to the compile time specialization for the common item sizes and falls
+ * back to copying each item with memcpy otherwise.
+ */
+inline void deinterleave(
+    void* const out[], const void* in, size_t nstreams, size_t nitems, size_t itemsize)
+{
+    switch (itemsize) {
+    case 1:
+        return deinterleave<1>(out, in, nstreams, nitems);
+    case 2:
+        return deinterleave<2>(out, in, nstreams, nitems);
+    case 4:
+        return deinterleave<4>(out, in, nstreams, nitems);
+    case 8:
+        return deinterleave<8>(out, in, nstreams, nitems);
+    case 16:
+        return deinterleave<16>(out, in, nstreams, nitems);
+    default:
+        break;
+    }
+
+    auto src = static_cast<const uint8_t*>(in);
+    for (size_t i = 0; i < nitems; i++) {
+        for (size_t j = 0; j < nstreams; j++) {
+            memcpy(static_cast<uint8_t*>(out[j]) + i * itemsize, src, itemsize);
+            src += itemsize;
+        }
+    }
+}
+
+} // namespace streamops
+} // namespace kernel
+} // namespace gr
@@ -35,7 +35,10 @@ static int my_fftw_read_char(void* f) { return fgetc((FILE*)f); }
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
+#include <map>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
 
 #include <gnuradio/file_lock.h>
 #include <gnuradio/prefs.h>
@@ -49,6 +52,48 @@ static std::mutex wisdom_thread_mutex;
 gr::file_lock wisdom_lock;
 static bool wisdom_lock_init_done = false; // Modify while holding 'wisdom_thread_mutex'
 
+namespace {
+
+// Everything that has to match for two fftw_fft objects to be able to share a plan
+struct plan_key {
+    int size;
+    int type; // index of the fftw_fft specialization
+    int nthreads;
+    int in_alignment;
+    int out_alignment;
+    int howmany; // transforms per execution, see fftw_fft_many
+
+    bool operator<(const plan_key& other) const
+    {
+        return std::tie(size, type, nthreads, in_alignment, out_alignment, howmany) <
+               std::tie(other.size,
+                        other.type,
+                        other.nthreads,
+                        other.in_alignment,
+                        other.out_alignment,
+                        other.howmany);
+    }
+};
+
+// All of these are guarded by planner::mutex()
+std::map<plan_key, std::weak_ptr<void>> s_plan_cache;
+plan_cache_stats s_plan_cache_stats;
+bool s_wisdom_imported = false;
+
+template <class T, bool forward>
+constexpr int plan_type()
+{
+    return (std::is_same_v<T, float> ? 2 : 0) + (forward ? 0 : 1);
+}
+
+template <bool forward>
+constexpr int many_plan_type()
+{
+    return 4 + (forward ? 0 : 1);
+}
+
+} // namespace
+
 gr_complex* malloc_complex(int size)
 {
     return (gr_complex*)volk_malloc(sizeof(gr_complex) * size, volk_get_alignment());
@@ -74,7 +119,13 @@ std::mutex& planner::mutex()
     return s_planning_mutex;
 }
 
-static std::string wisdom_filename()
+plan_cache_stats get_plan_cache_stats()
+{
+    std::scoped_lock lock(planner::mutex());
+    return s_plan_cache_stats;
+}
+
+std::string wisdom_filename()
 {
     static fs::path path;
     path = fs::path(gr::prefs::appdata_path()) / ".gr_fftw_wisdom";
@@ -157,6 +208,90 @@ static void export_wisdom()
     }
 }
 
+// Returns the cached plan for key if there is one, otherwise makes it with make_plan and
+// adds it to the cache.  Returns nullptr if FFTW could not make the plan.
+template <class F>
+static std::shared_ptr<void> acquire_cached_plan(const plan_key& key, F&& make_plan)
+{
+    // Hold global mutex during plan construction and destruction.
+    std::scoped_lock lock(planner::mutex());
+
+    auto& cached = s_plan_cache[key];
+    if (auto plan = cached.lock()) {
+        s_plan_cache_stats.plans_shared++;
+        return plan;
+    }
+
+    config_threading(key.nthreads);
+    lock_wisdom();
+    if (!s_wisdom_imported) {
+        import_wisdom(); // load prior wisdom from disk once per process
+        s_wisdom_imported = true;
+    }
+
+    void* raw_plan = make_plan();
+    if (raw_plan == NULL) {
+        unlock_wisdom();
+        return nullptr;
+    }
+    export_wisdom(); // store new wisdom to disk
+    unlock_wisdom();
+
+    std::shared_ptr<void> plan(raw_plan, [](void* p) {
+        // Hold global mutex during plan construction and destruction.
+        std::scoped_lock lock(planner::mutex());
+        fftwf_destroy_plan((fftwf_plan)p);
+    });
+    cached = plan;
+    s_plan_cache_stats.plans_created++;
+    return plan;
+}
+
+void generate_wisdom(const std::vector<int>& sizes, plan_rigor rigor, int nthreads)
+{
+    unsigned int flags = FFTW_MEASURE;
+    if (rigor == plan_rigor::PATIENT) {
+        flags = FFTW_PATIENT;
+    }
+    else if (rigor == plan_rigor::EXHAUSTIVE) {
+        flags = FFTW_EXHAUSTIVE;
+    }
+
+    std::scoped_lock lock(planner::mutex());
+    config_threading(nthreads);
+    lock_wisdom();
+    if (!s_wisdom_imported) {
+        import_wisdom();
+        s_wisdom_imported = true;
+    }
+
+    for (auto size : sizes) {
+        if (size <= 0) {
+            unlock_wisdom();
+            throw std::out_of_range("generate_wisdom: invalid fft_size");
+        }
+        volk::vector<gr_complex> cbuf_in(size), cbuf_out(size);
+        volk::vector<float> fbuf(size);
+        auto cin = reinterpret_cast<fftwf_complex*>(cbuf_in.data());
+        auto cout = reinterpret_cast<fftwf_complex*>(cbuf_out.data());
+
+        fftwf_plan plans[] = {
+            fftwf_plan_dft_1d(size, cin, cout, FFTW_FORWARD, flags),
+            fftwf_plan_dft_1d(size, cin, cout, FFTW_BACKWARD, flags),
+            fftwf_plan_dft_r2c_1d(size, fbuf.data(), cout, flags),
+            fftwf_plan_dft_c2r_1d(size, cin, fbuf.data(), flags),
+        };
+        for (auto plan : plans) {
+            if (plan) {
+                fftwf_destroy_plan(plan);
+            }
+        }
+    }
+
+    export_wisdom();
+    unlock_wisdom();
+}
+
 // ----------------------------------------------------------------
 
 
@@ -165,8 +300,6 @@ fftw_fft<T, forward>::fftw_fft(int fft_size, int nthreads)
     : d_nthreads(nthreads), d_inbuf(fft_size), d_outbuf(fft_size)
 {
     gr::configure_default_loggers(d_logger, d_debug_logger, "fft_complex");
-    // Hold global mutex during plan construction and destruction.
-    std::scoped_lock lock(planner::mutex());
 
     static_assert(sizeof(fftwf_complex) == sizeof(gr_complex),
                   "The size of fftwf_complex is not equal to gr_complex");
@@ -175,23 +308,34 @@ fftw_fft<T, forward>::fftw_fft(int fft_size, int nthreads)
         throw std::out_of_range("fft_impl_fftw: invalid fft_size");
     }
 
-    config_threading(nthreads);
-    lock_wisdom();
-    import_wisdom(); // load prior wisdom from disk
+    d_plan = acquire_plan();
+}
 
-    initialize_plan(fft_size);
-    if (d_plan == NULL) {
+template <class T, bool forward>
+std::shared_ptr<void> fftw_fft<T, forward>::acquire_plan()
+{
+    // FFTW only requires buffers passed to the new-array execute functions to have the
+    // same alignment as the ones the plan was made for
+    plan_key key{ (int)d_inbuf.size(),
+                  plan_type<T, forward>(),
+                  d_nthreads,
+                  fftwf_alignment_of(reinterpret_cast<float*>(d_inbuf.data())),
+                  fftwf_alignment_of(reinterpret_cast<float*>(d_outbuf.data())),
+                  1 };
+
+    auto plan =
+        acquire_cached_plan(key, [this] { return initialize_plan(d_inbuf.size()); });
+    if (!plan) {
         d_logger->error("creating plan failed");
         throw std::runtime_error("Creating fftw plan failed");
     }
-    export_wisdom(); // store new wisdom to disk
-    unlock_wisdom();
+    return plan;
 }
 
 template <>
-void fftw_fft<gr_complex, true>::initialize_plan(int fft_size)
+void* fftw_fft<gr_complex, true>::initialize_plan(int fft_size)
 {
-    d_plan = fftwf_plan_dft_1d(fft_size,
+    return fftwf_plan_dft_1d(fft_size,
                                reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
                                reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
                                FFTW_FORWARD,
@@ -199,9 +343,9 @@ void fftw_fft<gr_complex, true>::initialize_plan(int fft_size)
 }
 
 template <>
-void fftw_fft<gr_complex, false>::initialize_plan(int fft_size)
+void* fftw_fft<gr_complex, false>::initialize_plan(int fft_size)
 {
-    d_plan = fftwf_plan_dft_1d(fft_size,
+    return fftwf_plan_dft_1d(fft_size,
                                reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
                                reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
                                FFTW_BACKWARD,
@@ -210,18 +354,18 @@ void fftw_fft<gr_complex, false>::initialize_plan(int fft_size)
 
 
 template <>
-void fftw_fft<float, true>::initialize_plan(int fft_size)
+void* fftw_fft<float, true>::initialize_plan(int fft_size)
 {
-    d_plan = fftwf_plan_dft_r2c_1d(fft_size,
+    return fftwf_plan_dft_r2c_1d(fft_size,
                                    d_inbuf.data(),
                                    reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
                                    FFTW_MEASURE);
 }
 
 template <>
-void fftw_fft<float, false>::initialize_plan(int fft_size)
+void* fftw_fft<float, false>::initialize_plan(int fft_size)
 {
-    d_plan = fftwf_plan_dft_c2r_1d(fft_size,
+    return fftwf_plan_dft_c2r_1d(fft_size,
                                    reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
                                    d_outbuf.data(),
                                    FFTW_MEASURE);
@@ -231,10 +375,7 @@ void fftw_fft<float, false>::initialize_plan(int fft_size)
 template <class T, bool forward>
 fftw_fft<T, forward>::~fftw_fft()
 {
-    // Hold global mutex during plan construction and destruction.
-    std::scoped_lock lock(planner::mutex());
-
-    fftwf_destroy_plan((fftwf_plan)d_plan);
+    // The plan is destroyed, under the planner mutex, once its last user is gone
 }
 
 template <class T, bool forward>
@@ -243,17 +384,99 @@ void fftw_fft<T, forward>::set_nthreads(int n)
     if (n <= 0) {
         throw std::out_of_range("gr::fft: invalid number of threads");
     }
+    if (n == d_nthreads) {
+        return;
+    }
     d_nthreads = n;
 
-#ifdef FFTW3F_THREADS
-    fftwf_plan_with_nthreads(d_nthreads);
-#endif
+    // Plans are made for a number of threads, so look up the one for the new count
+    d_plan = acquire_plan();
 }
 
-template <class T, bool forward>
-void fftw_fft<T, forward>::execute()
+template <>
+void fftw_fft<gr_complex, true>::execute()
+{
+    fftwf_execute_dft((fftwf_plan)d_plan.get(),
+                      reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                      reinterpret_cast<fftwf_complex*>(d_outbuf.data()));
+}
+
+template <>
+void fftw_fft<gr_complex, false>::execute()
+{
+    fftwf_execute_dft((fftwf_plan)d_plan.get(),
+                      reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                      reinterpret_cast<fftwf_complex*>(d_outbuf.data()));
+}
+
+template <>
+void fftw_fft<float, true>::execute()
+{
+    fftwf_execute_dft_r2c((fftwf_plan)d_plan.get(),
+                          d_inbuf.data(),
+                          reinterpret_cast<fftwf_complex*>(d_outbuf.data()));
+}
+
+template <>
+void fftw_fft<float, false>::execute()
+{
+    fftwf_execute_dft_c2r((fftwf_plan)d_plan.get(),
+                          reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                          d_outbuf.data());
+}
+
+// ----------------------------------------------------------------
+
+template <bool forward>
+fftw_fft_many<forward>::fftw_fft_many(int fft_size, int howmany, int nthreads)
+    : d_fft_size(fft_size),
+      d_howmany(howmany),
+      d_nthreads(nthreads),
+      d_inbuf(fft_size > 0 && howmany > 0 ? fft_size * howmany : 0),
+      d_outbuf(d_inbuf.size())
+{
+    gr::configure_default_loggers(d_logger, d_debug_logger, "fft_complex_many");
+
+    if (fft_size <= 0 || howmany <= 0) {
+        throw std::out_of_range("fftw_fft_many: invalid fft_size or howmany");
+    }
+
+    plan_key key{ fft_size,
+                  many_plan_type<forward>(),
+                  d_nthreads,
+                  fftwf_alignment_of(reinterpret_cast<float*>(d_inbuf.data())),
+                  fftwf_alignment_of(reinterpret_cast<float*>(d_outbuf.data())),
+                  howmany };
+
+    d_plan = acquire_cached_plan(key, [this]() -> void* {
+        // Element k of transform t at k * howmany + t, in and out
+        int n = d_fft_size;
+        return fftwf_plan_many_dft(1,
+                                   &n,
+                                   d_howmany,
+                                   reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                                   nullptr,
+                                   d_howmany,
+                                   1,
+                                   reinterpret_cast<fftwf_complex*>(d_outbuf.data()),
+                                   nullptr,
+                                   d_howmany,
+                                   1,
+                                   forward ? FFTW_FORWARD : FFTW_BACKWARD,
+                                   FFTW_MEASURE);
+    });
+    if (!d_plan) {
+        d_logger->error("creating plan failed");
+        throw std::runtime_error("Creating fftw plan failed");
+    }
+}
+
+template <bool forward>
+void fftw_fft_many<forward>::execute()
 {
-    fftwf_execute((fftwf_plan)d_plan);
+    fftwf_execute_dft((fftwf_plan)d_plan.get(),
+                      reinterpret_cast<fftwf_complex*>(d_inbuf.data()),
+                      reinterpret_cast<fftwf_complex*>(d_outbuf.data()));
 }
 
 
@@ -261,6 +484,8 @@ template class fftw_fft<gr_complex, true>;
 template class fftw_fft<gr_complex, false>;
 template class fftw_fft<float, true>;
 template class fftw_fft<float, false>;
+template class fftw_fft_many<true>;
+template class fftw_fft_many<false>;
 } /* namespace fft */
 } // namespace kernel
 } // namespace gr
\ No newline at end of file
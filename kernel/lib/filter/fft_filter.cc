@@ -11,6 +11,7 @@
 #include <gnuradio/kernel/filter/fft_filter.h>
 #include <gnuradio/logger.h>
 #include <volk/volk.h>
+#include <cmath>
 #include <cstring>
 #include <memory>
 
@@ -418,6 +419,24 @@ int fft_filter<T, TAPS_T>::filter(int nitems, const T* input, T* output)
 }
 
 
+bool fft_filter_preferred(size_t ntaps, size_t decimation)
+{
+    if (ntaps < 2) {
+        return false;
+    }
+
+    // Same sizes as compute_sizes()
+    double fftsize = 2 * std::pow(2.0, std::ceil(std::log2(double(ntaps))));
+    double nsamples = fftsize - ntaps + 1;
+
+    // A complex radix-2 transform is roughly fftsize * log2(fftsize) multiply-adds,
+    // and every input sample passes through the transforms whether or not the output
+    // it lines up with is kept.  The transforms make several passes over memory while
+    // the direct form keeps its accumulators in registers, so weigh them double.
+    double fft_cost = 2 * (2 * fftsize * std::log2(fftsize) + fftsize) / nsamples;
+    return fft_cost * decimation < ntaps;
+}
+
 template class fft_filter<float, float>;
 template class fft_filter<gr_complex, gr_complex>;
 template class fft_filter<gr_complex, float>;
@@ -11,13 +11,178 @@
 #include <gnuradio/kernel/filter/fir_filter.h>
 #include <volk/volk.h>
 #include <algorithm>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 namespace gr {
 namespace kernel {
 namespace filter {
 
+namespace {
+
+// Number of outputs accumulated together by the block form
+constexpr unsigned int s_block_size = 64;
+
+// Below this many taps the per output VOLK dot product is as fast as the block form
+constexpr unsigned int s_min_block_taps = 32;
+
+// Decimating filters with fewer taps per phase than this are not worth deinterleaving
+constexpr unsigned int s_min_phase_taps = 4;
+
+// Multiply-accumulates a thread has to be given for waking it up to pay off
+constexpr unsigned long s_min_macs_per_thread = 1 << 20;
+
+template <class T>
+struct accum_type {
+    using type = T;
+};
+template <>
+struct accum_type<std::int16_t> {
+    using type = float;
+};
+
+inline void mac(float& acc, float tap, float x) { acc += tap * x; }
+inline void mac(gr_complex& acc, float tap, gr_complex x) { acc += tap * x; }
+inline void mac(gr_complex& acc, gr_complex tap, float x) { acc += tap * x; }
+inline void mac(gr_complex& acc, gr_complex tap, std::int16_t x)
+{
+    acc += tap * float(x);
+}
+inline void mac(gr_complex& acc, gr_complex tap, gr_complex x)
+{
+    // Spelled out since the std::complex product checks for inf/nan and won't vectorize
+    acc = gr_complex(acc.real() + tap.real() * x.real() - tap.imag() * x.imag(),
+                     acc.imag() + tap.real() * x.imag() + tap.imag() * x.real());
+}
+
+// acc[i] += sum_m taps[m] * x[i * stride + m] for i < n
+//
+// This is the transposed form of the dot product per output: every tap is applied to
+// the whole block before moving on to the next, so the inner loop is over independent
+// accumulators and the block of inputs stays in L1
+template <class ACC_T, class IN_T, class TAP_T>
+void accumulate(ACC_T acc[],
+                const IN_T x[],
+                const TAP_T taps[],
+                unsigned int ntaps,
+                unsigned int n,
+                unsigned int stride)
+{
+    for (unsigned int m = 0; m < ntaps; m++) {
+        const TAP_T t = taps[m];
+        const IN_T* xm = x + m;
+        if (stride == 1) {
+            for (unsigned int i = 0; i < n; i++) {
+                mac(acc[i], t, xm[i]);
+            }
+        }
+        else {
+            for (unsigned int i = 0; i < n; i++) {
+                mac(acc[i], t, xm[i * stride]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Small pool of threads shared by every fir_filter that calls set_nthreads
+ *
+ * The calling thread takes part in running its own job, so a job always completes
+ * even when all of the workers are busy with other filters.
+ */
+class filter_pool
+{
+public:
+    static filter_pool& instance()
+    {
+        static filter_pool pool;
+        return pool;
+    }
+
+    // Runs task(0) ... task(ntasks - 1) and returns once all of them are done
+    void run(size_t ntasks, const std::function<void(size_t)>& task)
+    {
+        job j{ &task, ntasks, 0, ntasks, {} };
+        std::unique_lock<std::mutex> lk(d_mutex);
+        d_jobs.push_back(&j);
+        d_cv.notify_all();
+
+        while (j.next < j.ntasks) {
+            run_one(j, lk);
+        }
+        j.done.wait(lk, [&j] { return j.remaining == 0; });
+    }
+
+    ~filter_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lk(d_mutex);
+            d_stop = true;
+        }
+        d_cv.notify_all();
+        for (auto& t : d_threads) {
+            t.join();
+        }
+    }
+
+private:
+    struct job {
+        const std::function<void(size_t)>* task;
+        size_t ntasks;
+        size_t next;
+        size_t remaining;
+        std::condition_variable done;
+    };
+
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    std::deque<job*> d_jobs;
+    std::vector<std::thread> d_threads;
+    bool d_stop = false;
+
+    filter_pool()
+    {
+        auto nworkers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        for (unsigned int i = 0; i < nworkers; i++) {
+            d_threads.emplace_back([this] { worker_body(); });
+        }
+    }
+
+    // Claims and runs the next task of a job, lk is held on entry and on return
+    void run_one(job& j, std::unique_lock<std::mutex>& lk)
+    {
+        auto idx = j.next++;
+        if (j.next == j.ntasks) {
+            d_jobs.erase(std::find(d_jobs.begin(), d_jobs.end(), &j));
+        }
+        lk.unlock();
+        (*j.task)(idx);
+        lk.lock();
+        if (--j.remaining == 0) {
+            j.done.notify_one();
+        }
+    }
+
+    void worker_body()
+    {
+        std::unique_lock<std::mutex> lk(d_mutex);
+        while (true) {
+            d_cv.wait(lk, [this] { return d_stop || !d_jobs.empty(); });
+            if (d_stop) {
+                return;
+            }
+            run_one(*d_jobs.front(), lk);
+        }
+    }
+};
+
+} // namespace
+
 template <class IN_T, class OUT_T, class TAP_T>
 fir_filter<IN_T, OUT_T, TAP_T>::fir_filter(const std::vector<TAP_T>& taps) : d_output(1)
 {
@@ -40,6 +205,8 @@ void fir_filter<IN_T, OUT_T, TAP_T>::set_taps(const std::vector<TAP_T>& taps)
         for (unsigned int j = 0; j < d_ntaps; j++)
             d_aligned_taps[i][i + j] = d_taps[j];
     }
+
+    d_poly_decimate = 0;
 }
 
 template <class IN_T, class OUT_T, class TAP_T>
@@ -49,6 +216,8 @@ void fir_filter<IN_T, OUT_T, TAP_T>::update_tap(TAP_T t, unsigned int index)
     for (int i = 0; i < d_naligned; i++) {
         d_aligned_taps[i][i + index] = t;
     }
+
+    d_poly_decimate = 0;
 }
 
 template <class IN_T, class OUT_T, class TAP_T>
@@ -65,14 +234,18 @@ unsigned int fir_filter<IN_T, OUT_T, TAP_T>::ntaps() const
     return d_ntaps;
 }
 
+template <class IN_T, class OUT_T, class TAP_T>
+void fir_filter<IN_T, OUT_T, TAP_T>::set_nthreads(unsigned int nthreads)
+{
+    d_nthreads = std::max(1u, nthreads);
+}
+
 template <class IN_T, class OUT_T, class TAP_T>
 void fir_filter<IN_T, OUT_T, TAP_T>::filterN(OUT_T output[],
                                              const IN_T input[],
                                              unsigned long n)
 {
-    for (unsigned long i = 0; i < n; i++) {
-        output[i] = filter(&input[i]);
-    }
+    filter_range(output, input, n, 1);
 }
 
 template <class IN_T, class OUT_T, class TAP_T>
@@ -81,10 +254,89 @@ void fir_filter<IN_T, OUT_T, TAP_T>::filterNdec(OUT_T output[],
                                                 unsigned long n,
                                                 unsigned int decimate)
 {
-    unsigned long j = 0;
-    for (unsigned long i = 0; i < n; i++) {
-        output[i] = filter(&input[j]);
-        j += decimate;
+    // Phase p of the taps only ever multiplies inputs p, p + decimate, ...
+    if (decimate > 1 && d_poly_decimate != decimate) {
+        d_poly_taps.assign(decimate, {});
+        for (unsigned int k = 0; k < d_ntaps; k++) {
+            d_poly_taps[k % decimate].push_back(d_taps[k]);
+        }
+        d_poly_decimate = decimate;
+    }
+
+    filter_range(output, input, n, decimate);
+}
+
+template <class IN_T, class OUT_T, class TAP_T>
+void fir_filter<IN_T, OUT_T, TAP_T>::filter_range(OUT_T output[],
+                                                  const IN_T input[],
+                                                  unsigned long n,
+                                                  unsigned int decimate)
+{
+    // filter() shares its result buffer, so only the block form can be split
+    unsigned long nchunks = 1;
+    if (d_nthreads > 1 && d_ntaps >= s_min_block_taps) {
+        nchunks =
+            std::min<unsigned long>(d_nthreads, n * d_ntaps / s_min_macs_per_thread);
+    }
+
+    if (nchunks < 2) {
+        filter_block(output, input, n, decimate);
+        return;
+    }
+
+    filter_pool::instance().run(nchunks, [&](size_t c) {
+        auto begin = n * c / nchunks;
+        auto end = n * (c + 1) / nchunks;
+        filter_block(output + begin, input + begin * decimate, end - begin, decimate);
+    });
+}
+
+template <class IN_T, class OUT_T, class TAP_T>
+void fir_filter<IN_T, OUT_T, TAP_T>::filter_block(OUT_T output[],
+                                                  const IN_T input[],
+                                                  unsigned long n,
+                                                  unsigned int decimate) const
+{
+    if (d_ntaps < s_min_block_taps) {
+        unsigned long j = 0;
+        for (unsigned long i = 0; i < n; i++) {
+            output[i] = filter(&input[j]);
+            j += decimate;
+        }
+        return;
+    }
+
+    using acc_t = typename accum_type<OUT_T>::type;
+    bool polyphase = decimate > 1 && d_ntaps >= s_min_phase_taps * decimate;
+    static thread_local std::vector<IN_T> phase_input;
+
+    acc_t acc[s_block_size];
+    for (unsigned long i = 0; i < n; i += s_block_size) {
+        auto nb = (unsigned int)std::min<unsigned long>(s_block_size, n - i);
+        auto in = input + i * decimate;
+        std::fill_n(acc, nb, acc_t(0));
+
+        if (!polyphase) {
+            accumulate(acc, in, d_taps.data(), d_ntaps, nb, decimate);
+        }
+        else {
+            // Deinterleave each phase so it can be run as an undecimated filter
+            for (unsigned int p = 0; p < decimate; p++) {
+                auto& taps = d_poly_taps[p];
+                auto len = nb + taps.size() - 1;
+                if (phase_input.size() < len) {
+                    phase_input.resize(len);
+                }
+                for (size_t j = 0; j < len; j++) {
+                    phase_input[j] = in[j * decimate + p];
+                }
+                accumulate(acc, phase_input.data(), taps.data(), taps.size(), nb, 1);
+            }
+        }
+
+        for (unsigned int k = 0; k < nb; k++) {
+            output[i + k] = static_cast<OUT_T>(acc[k]);
+        }
     }
 }
 
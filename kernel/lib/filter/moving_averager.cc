@@ -10,33 +10,186 @@
 
 #include <gnuradio/kernel/filter/moving_averager.h>
 #include <gnuradio/gr_complex.h>
+#include <volk/volk.h>
 
-#include <cstdio>
-#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 
 namespace gr {
 namespace kernel {
 namespace filter {
 
+namespace {
+
+// Items between recomputations of the running sums, or the length of the average if
+// that is longer, so that recomputing costs at most one more addition per sample
+constexpr uint64_t s_recompute_interval = 65536;
+
+uint64_t ring_size(int D)
+{
+    uint64_t size = 1;
+    while (size < (uint64_t)D) {
+        size <<= 1;
+    }
+    return size;
+}
+
+void subtract(float* out, const float* a, const float* b, size_t n)
+{
+    volk_32f_x2_subtract_32f(out, a, b, n);
+}
+
+void subtract(gr_complex* out, const gr_complex* a, const gr_complex* b, size_t n)
+{
+    volk_32f_x2_subtract_32f((float*)out, (const float*)a, (const float*)b, 2 * n);
+}
+
+void multiply_const(float* out, float k, size_t n)
+{
+    volk_32f_s32f_multiply_32f(out, out, k, n);
+}
+
+void multiply_const(gr_complex* out, gr_complex k, size_t n)
+{
+    volk_32fc_s32fc_multiply_32fc(out, out, k, n);
+}
+
+} // namespace
+
+template <class T>
+moving_averager<T>::moving_averager(int D) : moving_averager(D, T(1) / (T)(D))
+{
+}
 
 template <class T>
-moving_averager<T>::moving_averager(int D)
-    : d_length(D), d_out(0), d_out_d1(0), d_out_d2(0), d_delay_line(d_length - 1, 0)
+moving_averager<T>::moving_averager(int D, T scale, size_t vlen)
+    : d_length(D),
+      d_scale(scale),
+      d_vlen(vlen),
+      d_out(0),
+      d_ring(ring_size(D) * vlen, 0),
+      d_mask(ring_size(D) - 1),
+      d_sum(vlen, 0)
 {
+    if (D < 1 || vlen < 1) {
+        throw std::invalid_argument("moving_averager: length and vlen must be positive");
+    }
 }
 
 template <class T>
 T moving_averager<T>::filter(T x)
 {
-    d_out_d1 = d_out;
-    d_delay_line.push_back(x);
-    d_out = d_delay_line[0];
-    d_delay_line.pop_front();
+    d_sum[0] += x - *ring_item(d_nitems - d_length);
+    *ring_item(d_nitems) = x;
+    d_nitems++;
+    d_out = *ring_item(d_nitems - d_length);
+
+    if (++d_since_recompute >= std::max<uint64_t>(s_recompute_interval, d_length)) {
+        recompute();
+    }
+
+    return d_sum[0] * d_scale;
+}
+
+template <class T>
+void moving_averager<T>::filterN(T output[], const T input[], size_t n, T delayed[])
+{
+    const size_t D = d_length;
+    const size_t vlen = d_vlen;
+
+    // output[i] = input[i] - input[i - D], taking input[i - D] from the ring buffer for
+    // the first D items and from the input for the rest
+    size_t nhead = std::min(n, D);
+    for (size_t i = 0; i < nhead; i++) {
+        const T* old = ring_item(d_nitems + i - D);
+        for (size_t e = 0; e < vlen; e++) {
+            output[i * vlen + e] = input[i * vlen + e] - old[e];
+        }
+    }
+    if (n > D) {
+        subtract(output + D * vlen, input + D * vlen, input, (n - D) * vlen);
+    }
+
+    if (delayed) {
+        size_t nring = std::min(n, D - 1);
+        for (size_t i = 0; i < nring; i++) {
+            memcpy(
+                &delayed[i * vlen], ring_item(d_nitems + i - (D - 1)), vlen * sizeof(T));
+        }
+        if (n > D - 1) {
+            memcpy(&delayed[(D - 1) * vlen], input, (n - (D - 1)) * vlen * sizeof(T));
+        }
+    }
+
+    // The running sum is the only part that has to go one sample after the other
+    if (vlen == 1) {
+        T sum = d_sum[0];
+        for (size_t i = 0; i < n; i++) {
+            sum += output[i];
+            output[i] = sum;
+        }
+        d_sum[0] = sum;
+    }
+    else {
+        for (size_t i = 0; i < n; i++) {
+            for (size_t e = 0; e < vlen; e++) {
+                d_sum[e] += output[i * vlen + e];
+                output[i * vlen + e] = d_sum[e];
+            }
+        }
+    }
+    multiply_const(output, d_scale, n * vlen);
+
+    // Keep the last items of the block, which are all the ring can hold
+    size_t nkeep = std::min<uint64_t>(n, d_mask + 1);
+    const T* src = input + (n - nkeep) * vlen;
+    size_t start = (d_nitems + n - nkeep) & d_mask;
+    size_t nfirst = std::min<size_t>(nkeep, d_mask + 1 - start);
+    memcpy(&d_ring[start * vlen], src, nfirst * vlen * sizeof(T));
+    memcpy(&d_ring[0], src + nfirst * vlen, (nkeep - nfirst) * vlen * sizeof(T));
+    d_nitems += n;
+    d_out = *ring_item(d_nitems - D);
+
+    d_since_recompute += n;
+    if (d_since_recompute >= std::max<uint64_t>(s_recompute_interval, D)) {
+        recompute();
+    }
+}
+
+template <class T>
+void moving_averager<T>::set_length(int D)
+{
+    if (D < 1) {
+        throw std::invalid_argument("moving_averager: length must be positive");
+    }
+
+    // Move the items the old ring holds to where the new one expects them
+    auto size = ring_size(D);
+    std::vector<T> ring(size * d_vlen, 0);
+    uint64_t nkeep = std::min({ d_nitems, size, d_mask + 1 });
+    for (uint64_t k = d_nitems - nkeep; k < d_nitems; k++) {
+        memcpy(&ring[(k & (size - 1)) * d_vlen], ring_item(k), d_vlen * sizeof(T));
+    }
+    d_ring.swap(ring);
+    d_mask = size - 1;
+    d_length = D;
 
-    T y = x - d_out_d1 + d_out_d2;
-    d_out_d2 = y;
+    recompute();
+    d_out = *ring_item(d_nitems - D);
+}
 
-    return (y / (T)(d_length));
+template <class T>
+void moving_averager<T>::recompute()
+{
+    std::fill(d_sum.begin(), d_sum.end(), T(0));
+    for (uint64_t k = d_nitems - d_length; k != d_nitems; k++) {
+        const T* item = ring_item(k);
+        for (size_t e = 0; e < d_vlen; e++) {
+            d_sum[e] += item[e];
+        }
+    }
+    d_since_recompute = 0;
 }
 
 
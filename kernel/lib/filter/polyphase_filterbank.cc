@@ -13,12 +13,22 @@
 #endif
 
 #include <gnuradio/kernel/filter/polyphase_filterbank.h>
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 
 namespace gr {
 namespace kernel {
 namespace filter {
 
+namespace {
+// Size of the FFT input matrix of a tile.  Small enough for it, the output matrix and
+// the branch inputs being read to stay in the L2 cache, while still giving the batched
+// FFT a fair number of transforms at a time.
+constexpr size_t s_tile_bytes = 65536;
+constexpr size_t s_min_tile_steps = 8;
+} // namespace
+
 polyphase_filterbank::polyphase_filterbank(unsigned int nfilts,
                                            const std::vector<float>& taps)
     : d_nfilts(nfilts), d_fft(nfilts)
@@ -67,6 +77,93 @@ void polyphase_filterbank::set_taps(const std::vector<float>& taps)
     }
 }
 
+size_t polyphase_filterbank::channelize(gr_complex* const out[],
+                                        size_t noutputs,
+                                        const gr_complex* const in[],
+                                        size_t ninput,
+                                        unsigned int rate_ratio,
+                                        const std::vector<int>& idxlut,
+                                        const std::vector<int>& channel_map)
+{
+    const int nfilts = d_nfilts;
+
+    // Which branches have moved on to the next input sample repeats every nphases time
+    // steps, over which the input advances by nadvance samples.  For each phase, keep
+    // the filter branch 0 uses and how far the input is ahead of the start of the period.
+    unsigned int nphases = 1;
+    while ((nphases * rate_ratio) % d_nfilts != 0) {
+        nphases++;
+    }
+    const unsigned int nadvance = nphases * rate_ratio / d_nfilts;
+
+    std::vector<int> last(nphases);
+    std::vector<size_t> offset(nphases);
+    int i = -1;
+    size_t n = 0;
+    for (unsigned int p = 0; p < nphases; p++) {
+        i = (i + rate_ratio) % nfilts;
+        last[p] = i;
+        offset[p] = n;
+        n += (i + (int)rate_ratio) >= nfilts;
+    }
+
+    // Step until the input sample of the step is past the new samples
+    size_t nsteps = 0;
+    while (1 + nsteps / nphases * nadvance + offset[nsteps % nphases] <= ninput) {
+        nsteps++;
+    }
+
+    // Tiles hold whole periods so that every tile starts with phase 0
+    if (!d_tile_fft || d_tile_steps % nphases != 0) {
+        auto steps = std::max(s_tile_bytes / (d_nfilts * sizeof(gr_complex)),
+                              s_min_tile_steps);
+        d_tile_steps = (steps + nphases - 1) / nphases * nphases;
+        d_tile_fft = std::make_unique<fft::fft_complex_many_rev>(d_nfilts, d_tile_steps);
+        d_branch_out.resize(d_tile_steps / nphases);
+    }
+
+    auto fft_in = d_tile_fft->get_inbuf();
+    auto fft_out = d_tile_fft->get_outbuf();
+
+    for (size_t s0 = 0; s0 < nsteps; s0 += d_tile_steps) {
+        auto nstep = std::min<size_t>(d_tile_steps, nsteps - s0);
+        auto n0 = 1 + s0 / nphases * nadvance;
+
+        for (int j = 0; j < nfilts; j++) {
+            auto row = fft_in + (size_t)idxlut[j] * d_tile_steps;
+            for (unsigned int p = 0; p < nphases && p < nstep; p++) {
+                // Branches past the one of the last filter still read the previous
+                // input sample
+                bool behind = j > last[p];
+                auto& fir = d_fir_filters[behind ? nfilts + last[p] - j : last[p] - j];
+                auto src = in[j] + n0 + offset[p] - (behind ? 1 : 0);
+                auto count = (nstep - p + nphases - 1) / nphases;
+
+                if (nphases == 1) {
+                    fir.filterN(row, src, count);
+                }
+                else {
+                    fir.filterNdec(d_branch_out.data(), src, count, nadvance);
+                    for (size_t k = 0; k < count; k++) {
+                        row[p + k * nphases] = d_branch_out[k];
+                    }
+                }
+            }
+        }
+
+        // despin the whole tile at once
+        d_tile_fft->execute();
+
+        for (size_t nn = 0; nn < noutputs; nn++) {
+            memcpy(out[nn] + s0,
+                   fft_out + (size_t)channel_map[nn] * d_tile_steps,
+                   nstep * sizeof(gr_complex));
+        }
+    }
+
+    return nsteps;
+}
+
 void polyphase_filterbank::print_taps()
 {
     unsigned int i, j;
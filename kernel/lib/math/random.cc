@@ -26,6 +26,7 @@
 
 #include <gnuradio/kernel/math/math.h>
 #include <gnuradio/kernel/math/random.h>
+#include <volk/volk.h>
 
 #include <chrono>
 #include <cmath>
@@ -35,9 +36,13 @@ namespace kernel {
 namespace math {
 
 random::random(uint64_t seed, int64_t min_integer, int64_t max_integer)
-    : d_rng(seed), d_integer_dis(0, 1)
+    : d_rng(seed),
+      d_integer_dis(0, 1),
+      d_gauss_buf(s_gauss_block),
+      d_radius(s_gauss_block / 2)
 {
     d_gauss_stored = false; // set gasdev (gauss distributed numbers) on calculation state
+    seed_lanes(seed);
 
     // Setup random number generators
     set_integer_limits(min_integer, max_integer);
@@ -56,11 +61,29 @@ void random::reseed(uint64_t seed)
         auto now = std::chrono::system_clock::now().time_since_epoch();
         auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
         d_rng.seed(ns);
+        seed_lanes(ns);
     } else {
         d_rng.seed(d_seed);
+        seed_lanes(d_seed);
     }
 }
 
+void random::seed_lanes(uint64_t seed)
+{
+    // Every lane starts 2^64 steps after the one before, so their sequences never meet
+    uint64_t state[2];
+    xoroshiro128p_seed(state, seed);
+    for (size_t l = 0; l < s_lanes; l++) {
+        xoroshiro128p_jump(state);
+        d_lane_state[0][l] = state[0];
+        d_lane_state[1][l] = state[1];
+    }
+
+    // Nothing generated before the seed was set is handed out after it
+    d_uniform_pos = s_step;
+    d_gauss_pos = s_gauss_block;
+}
+
 void random::set_integer_limits(int64_t minimum, int64_t maximum)
 {
     // boost expects integer limits defined as [minimum, maximum] which is unintuitive.
@@ -129,6 +152,119 @@ gr_complex kernel::math::random::rayleigh_complex() { return gr_complex(gasdev()
 
 float random::rayleigh() { return sqrtf(-2.0 * logf(ran1())); }
 
+/*
+ * The same steps as xoroshiro128p_next() for all lanes at once.  The top 24 bits of
+ * each half of a 64 bit output make a float in [0, 1); the lowest bits, which are the
+ * weak ones of XOROSHIRO128+, are never used.
+ */
+void random::uniform_steps(float* out, size_t nsteps)
+{
+    constexpr float scale = 1.0f / (1 << 24);
+
+    uint64_t s0[s_lanes], s1[s_lanes];
+    for (size_t l = 0; l < s_lanes; l++) {
+        s0[l] = d_lane_state[0][l];
+        s1[l] = d_lane_state[1][l];
+    }
+
+    for (size_t step = 0; step < nsteps; step++) {
+        float* o = out + step * s_step;
+        for (size_t l = 0; l < s_lanes; l++) {
+            const uint64_t result = s0[l] + s1[l];
+            o[l] = (uint32_t)(result >> 40) * scale;
+            o[s_lanes + l] = (uint32_t)((result >> 8) & 0xffffff) * scale;
+
+            const uint64_t x = s1[l] ^ s0[l];
+            s0[l] = rotl(s0[l], 55) ^ x ^ (x << 14);
+            s1[l] = rotl(x, 36);
+        }
+    }
+
+    for (size_t l = 0; l < s_lanes; l++) {
+        d_lane_state[0][l] = s0[l];
+        d_lane_state[1][l] = s1[l];
+    }
+}
+
+void random::fill_uniform(float* out, size_t n, float minimum, float maximum)
+{
+    // Numbers left over from the last call come first
+    size_t i = 0;
+    while (i < n && d_uniform_pos < s_step) {
+        out[i++] = d_uniform_buf[d_uniform_pos++];
+    }
+
+    size_t nsteps = (n - i) / s_step;
+    uniform_steps(out + i, nsteps);
+    i += nsteps * s_step;
+
+    if (i < n) {
+        uniform_steps(d_uniform_buf, 1);
+        d_uniform_pos = 0;
+        while (i < n) {
+            out[i++] = d_uniform_buf[d_uniform_pos++];
+        }
+    }
+
+    if (minimum != 0 || maximum != 1) {
+        const float range = maximum - minimum;
+        for (i = 0; i < n; i++) {
+            out[i] = minimum + range * out[i];
+        }
+    }
+}
+
+/*
+ * Box-Muller on s_gauss_block / 2 pairs of uniform numbers: the first half of the
+ * block gets the cosine and the second half the sine of each pair.
+ */
+void random::gaussian_block(float* out)
+{
+    const size_t npairs = s_gauss_block / 2;
+    float* radius = d_radius.data();
+    float* angle = out + npairs;
+
+    // 1 - u is in (0, 1], which keeps the logarithm finite
+    fill_uniform(radius, npairs, 1, 0);
+    fill_uniform(angle, npairs, -GR_M_PI, GR_M_PI);
+
+    volk_32f_log2_32f(radius, radius, npairs);
+    volk_32f_s32f_multiply_32f(radius, radius, -2 * M_LN2, npairs);
+    volk_32f_sqrt_32f(radius, radius, npairs);
+
+    volk_32f_cos_32f(out, angle, npairs);
+    volk_32f_sin_32f(angle, angle, npairs);
+    volk_32f_x2_multiply_32f(out, out, radius, npairs);
+    volk_32f_x2_multiply_32f(angle, angle, radius, npairs);
+}
+
+void random::fill_gaussian(float* out, size_t n, float stddev)
+{
+    // Whole blocks are generated at a time, so that the numbers do not depend on how
+    // they are split across calls
+    size_t i = 0;
+    while (i < n && d_gauss_pos < s_gauss_block) {
+        out[i++] = d_gauss_buf[d_gauss_pos++];
+    }
+
+    while (n - i >= s_gauss_block) {
+        gaussian_block(out + i);
+        i += s_gauss_block;
+    }
+
+    if (i < n) {
+        gaussian_block(d_gauss_buf.data());
+        d_gauss_pos = 0;
+        while (i < n) {
+            out[i++] = d_gauss_buf[d_gauss_pos++];
+        }
+    }
+
+    if (stddev != 1) {
+        volk_32f_s32f_multiply_32f(out, out, stddev, n);
+    }
+}
+
 }
 }
 } /* namespace gr */
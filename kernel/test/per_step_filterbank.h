@@ -0,0 +1,70 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <gnuradio/kernel/filter/polyphase_filterbank.h>
+
+namespace gr {
+namespace kernel {
+namespace filter {
+
+/**
+ * @brief Runs the filters and FFT of the filterbank the way the channelizer block did
+ * before it went through channelize(): one filter call per branch and one FFT per
+ * time step
+ *
+ * Reference for qa_polyphase_filterbank and baseline for bm_pfb_channelizer.  Writes
+ * the unmapped FFT outputs and returns the number of time steps.
+ */
+class per_step_filterbank : public polyphase_filterbank
+{
+public:
+    using polyphase_filterbank::polyphase_filterbank;
+
+    size_t channelize_per_step(gr_complex* const out[],
+                               const gr_complex* const in[],
+                               int ninput,
+                               int rate_ratio,
+                               const std::vector<int>& idxlut)
+    {
+        int n = 1, i = -1, j, last;
+        size_t oo = 0;
+        while (n <= ninput) {
+            j = 0;
+            i = (i + rate_ratio) % d_nfilts;
+            last = i;
+            while (i >= 0) {
+                d_fft.get_inbuf()[idxlut[j]] = d_fir_filters[i].filter(&in[j][n]);
+                j++;
+                i--;
+            }
+
+            i = d_nfilts - 1;
+            while (i > last) {
+                d_fft.get_inbuf()[idxlut[j]] = d_fir_filters[i].filter(&in[j][n - 1]);
+                j++;
+                i--;
+            }
+
+            n += (i + rate_ratio) >= (int)d_nfilts;
+
+            d_fft.execute();
+            for (unsigned int k = 0; k < d_nfilts; k++) {
+                out[k][oo] = d_fft.get_outbuf()[k];
+            }
+            oo++;
+        }
+        return oo;
+    }
+};
+
+} // namespace filter
+} // namespace kernel
+} // namespace gr
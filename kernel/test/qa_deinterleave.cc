@@ -0,0 +1,56 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <gnuradio/kernel/streamops/deinterleave.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace gr::kernel::streamops;
+
+namespace {
+
+// Every output byte has to come from the matching position of the interleaved input
+void check_deinterleave(size_t itemsize, size_t nstreams)
+{
+    size_t nitems = 1037;
+    std::vector<uint8_t> input(nitems * nstreams * itemsize);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    std::vector<std::vector<uint8_t>> outputs(nstreams,
+                                              std::vector<uint8_t>(nitems * itemsize));
+    std::vector<void*> out(nstreams);
+    for (size_t j = 0; j < nstreams; j++) {
+        out[j] = outputs[j].data();
+    }
+
+    deinterleave(out.data(), input.data(), nstreams, nitems, itemsize);
+
+    for (size_t j = 0; j < nstreams; j++) {
+        for (size_t i = 0; i < nitems; i++) {
+            for (size_t b = 0; b < itemsize; b++) {
+                ASSERT_EQ(outputs[j][i * itemsize + b],
+                          input[(i * nstreams + j) * itemsize + b])
+                    << "itemsize " << itemsize << " nstreams " << nstreams;
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(Deinterleave, itemsizes)
+{
+    for (size_t itemsize : { 1, 2, 3, 4, 8, 12, 16, 24 }) {
+        for (size_t nstreams : { 1, 2, 3, 4, 8 }) {
+            check_deinterleave(itemsize, nstreams);
+        }
+    }
+}
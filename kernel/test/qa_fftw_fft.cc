@@ -0,0 +1,54 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <gnuradio/kernel/fft/fftw_fft.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace gr::kernel::fft;
+
+TEST(FftwFft, shared_plans)
+{
+    const int size = 1024;
+    auto before = get_plan_cache_stats();
+
+    fft_complex_fwd fft1(size);
+    fft_complex_fwd fft2(size);
+
+    auto after = get_plan_cache_stats();
+    EXPECT_EQ(after.plans_created - before.plans_created, 1u);
+    EXPECT_EQ(after.plans_shared - before.plans_shared, 1u);
+
+    // Both run the same plan on their own buffers
+    for (int i = 0; i < size; i++) {
+        fft1.get_inbuf()[i] = i == 0 ? 1 : 0;
+        fft2.get_inbuf()[i] = i == 1 ? 1 : 0;
+    }
+    fft1.execute();
+    fft2.execute();
+    for (int i = 0; i < size; i++) {
+        EXPECT_NEAR(std::abs(fft1.get_outbuf()[i]), 1.0, 1e-5);
+        EXPECT_NEAR(fft2.get_outbuf()[i].real(), std::cos(2 * M_PI * i / size), 1e-4);
+        EXPECT_NEAR(fft2.get_outbuf()[i].imag(), -std::sin(2 * M_PI * i / size), 1e-4);
+    }
+}
+
+TEST(FftwFft, plan_per_type)
+{
+    const int size = 96;
+    auto before = get_plan_cache_stats();
+
+    fft_complex_fwd cfwd(size);
+    fft_complex_rev crev(size);
+    fft_real_fwd rfwd(size);
+    fft_real_rev rrev(size);
+
+    auto after = get_plan_cache_stats();
+    EXPECT_EQ(after.plans_created - before.plans_created, 4u);
+}
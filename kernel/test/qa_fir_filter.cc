@@ -0,0 +1,86 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <gnuradio/kernel/filter/fft_filter.h>
+#include <gnuradio/kernel/filter/fir_filter.h>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace gr::kernel::filter;
+
+namespace {
+
+// filterNdec in every configuration has to match one dot product per output
+void check_filterNdec(unsigned int ntaps, unsigned int decimate, unsigned int nthreads)
+{
+    std::mt19937 gen(ntaps * 31 + decimate);
+    std::uniform_real_distribution<float> dist(-1, 1);
+
+    std::vector<gr_complex> taps(ntaps);
+    for (auto& t : taps) {
+        t = gr_complex(dist(gen), dist(gen));
+    }
+    unsigned long n = 1000000 / ntaps / decimate + 7;
+    std::vector<gr_complex> input(n * decimate + ntaps);
+    for (auto& x : input) {
+        x = gr_complex(dist(gen), dist(gen));
+    }
+
+    fir_filter_ccc fir(taps);
+    fir.set_nthreads(nthreads);
+    std::vector<gr_complex> output(n);
+    if (decimate == 1) {
+        fir.filterN(output.data(), input.data(), n);
+    }
+    else {
+        fir.filterNdec(output.data(), input.data(), n, decimate);
+    }
+
+    for (unsigned long i = 0; i < n; i++) {
+        auto expected = fir.filter(&input[i * decimate]);
+        EXPECT_NEAR(output[i].real(), expected.real(), 1e-4 * ntaps);
+        EXPECT_NEAR(output[i].imag(), expected.imag(), 1e-4 * ntaps);
+    }
+}
+
+} // namespace
+
+TEST(FirFilter, filterN)
+{
+    for (unsigned int ntaps : { 1, 11, 32, 129, 1000 }) {
+        check_filterNdec(ntaps, 1, 1);
+    }
+}
+
+TEST(FirFilter, filterNdec)
+{
+    for (unsigned int ntaps : { 1, 11, 32, 129, 1000 }) {
+        for (unsigned int decimate : { 2, 3, 8, 100 }) {
+            check_filterNdec(ntaps, decimate, 1);
+        }
+    }
+}
+
+TEST(FirFilter, threaded)
+{
+    for (unsigned int ntaps : { 32, 1000 }) {
+        for (unsigned int decimate : { 1, 4 }) {
+            check_filterNdec(ntaps, decimate, 4);
+        }
+    }
+}
+
+TEST(FirFilter, fft_filter_preferred)
+{
+    EXPECT_FALSE(fft_filter_preferred(1, 1));
+    EXPECT_FALSE(fft_filter_preferred(8, 1));
+    EXPECT_TRUE(fft_filter_preferred(1024, 1));
+    // Decimating by more than the filter length leaves nothing for the transform to share
+    EXPECT_FALSE(fft_filter_preferred(64, 100));
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/kernel/filter/moving_averager.h>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace gr::kernel::filter;
+
+namespace {
+
+// filterN over blocks of varying size has to match the plain sum of the last D items
+void check_filterN(int D, size_t vlen)
+{
+    std::mt19937 gen(D * 7 + vlen);
+    std::uniform_real_distribution<float> dist(-1, 1);
+
+    const size_t n = 20000;
+    std::vector<float> input(n * vlen);
+    for (auto& x : input) {
+        x = dist(gen);
+    }
+
+    moving_averager<float> ma(D, 1.0f, vlen);
+    std::vector<float> output(n * vlen), delayed(n * vlen);
+    size_t pos = 0;
+    for (size_t block = 1; pos < n; block++) {
+        auto count = std::min(n - pos, block * 37 % 500 + 1);
+        ma.filterN(&output[pos * vlen], &input[pos * vlen], count, &delayed[pos * vlen]);
+        pos += count;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        for (size_t e = 0; e < vlen; e++) {
+            double sum = 0;
+            for (int k = 0; k < D && k <= (int)i; k++) {
+                sum += input[(i - k) * vlen + e];
+            }
+            ASSERT_NEAR(output[i * vlen + e], sum, 1e-3) << "item " << i;
+
+            float expected = i >= (size_t)D - 1 ? input[(i - D + 1) * vlen + e] : 0;
+            ASSERT_EQ(delayed[i * vlen + e], expected) << "item " << i;
+        }
+    }
+}
+
+} // namespace
+
+TEST(MovingAverager, filterN)
+{
+    for (int D : { 1, 2, 7, 8, 100, 1000 }) {
+        check_filterN(D, 1);
+        check_filterN(D, 3);
+    }
+}
+
+TEST(MovingAverager, filter_matches_filterN)
+{
+    const int D = 33;
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dist(-1, 1);
+
+    std::vector<gr_complex> input(5000), output(input.size());
+    for (auto& x : input) {
+        x = gr_complex(dist(gen), dist(gen));
+    }
+
+    moving_averager<gr_complex> block(D), single(D);
+    block.filterN(output.data(), input.data(), input.size());
+    for (size_t i = 0; i < input.size(); i++) {
+        auto y = single.filter(input[i]);
+        EXPECT_NEAR(y.real(), output[i].real(), 1e-5);
+        EXPECT_NEAR(y.imag(), output[i].imag(), 1e-5);
+    }
+    EXPECT_EQ(single.delayed_sig(), block.delayed_sig());
+}
+
+TEST(MovingAverager, bounded_drift)
+{
+    // A large offset makes every update of the running sum round
+    const int D = 64;
+    const size_t n = 4000000;
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dist(-1, 1);
+
+    moving_averager<float> ma(D);
+    std::vector<float> input(4096), output(input.size());
+    for (size_t pos = 0; pos < n; pos += input.size()) {
+        for (auto& x : input) {
+            x = 1000 + dist(gen);
+        }
+        ma.filterN(output.data(), input.data(), input.size());
+    }
+
+    double sum = 0;
+    for (size_t k = input.size() - D; k < input.size(); k++) {
+        sum += input[k];
+    }
+    EXPECT_NEAR(output.back(), sum / D, 1e-3);
+}
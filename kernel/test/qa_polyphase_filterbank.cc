@@ -0,0 +1,101 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <gnuradio/kernel/filter/polyphase_filterbank.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+#include "per_step_filterbank.h"
+
+using namespace gr::kernel::filter;
+
+namespace {
+
+void check_channelize(unsigned int nfilts, float oversample_rate, size_t ninput)
+{
+    std::mt19937 gen(nfilts);
+    std::uniform_real_distribution<float> dist(-1, 1);
+
+    std::vector<float> taps(nfilts * 12 - 3);
+    for (auto& t : taps) {
+        t = dist(gen);
+    }
+    per_step_filterbank ref(nfilts, taps);
+    per_step_filterbank batched(nfilts, taps);
+
+    int rate_ratio = (int)rintf(nfilts / oversample_rate);
+    std::vector<int> idxlut(nfilts), channel_map(nfilts);
+    for (unsigned int i = 0; i < nfilts; i++) {
+        idxlut[i] = nfilts - ((i + rate_ratio) % nfilts) - 1;
+        channel_map[i] = nfilts - 1 - i;
+    }
+
+    std::vector<std::vector<gr_complex>> in(nfilts);
+    std::vector<const gr_complex*> in_ptrs(nfilts);
+    for (unsigned int j = 0; j < nfilts; j++) {
+        in[j].resize(ninput + taps.size() / nfilts + 2);
+        for (auto& x : in[j]) {
+            x = gr_complex(dist(gen), dist(gen));
+        }
+        in_ptrs[j] = in[j].data();
+    }
+
+    // at most ceil(nfilts / rate_ratio) time steps per input sample
+    auto max_steps = ninput * ((nfilts + rate_ratio - 1) / rate_ratio);
+    std::vector<std::vector<gr_complex>> expected(nfilts,
+                                                  std::vector<gr_complex>(max_steps));
+    std::vector<gr_complex*> expected_ptrs(nfilts);
+    for (unsigned int k = 0; k < nfilts; k++) {
+        expected_ptrs[k] = expected[k].data();
+    }
+    auto nsteps = ref.channelize_per_step(
+        expected_ptrs.data(), in_ptrs.data(), ninput, rate_ratio, idxlut);
+
+    std::vector<std::vector<gr_complex>> out(nfilts, std::vector<gr_complex>(nsteps));
+    std::vector<gr_complex*> out_ptrs(nfilts);
+    for (unsigned int k = 0; k < nfilts; k++) {
+        out_ptrs[k] = out[k].data();
+    }
+
+    // The second call runs on the plan and tile of the first
+    for (int pass = 0; pass < 2; pass++) {
+        ASSERT_EQ(batched.channelize(out_ptrs.data(),
+                                     nfilts,
+                                     in_ptrs.data(),
+                                     ninput,
+                                     rate_ratio,
+                                     idxlut,
+                                     channel_map),
+                  nsteps);
+        for (unsigned int k = 0; k < nfilts; k++) {
+            for (size_t s = 0; s < nsteps; s++) {
+                EXPECT_NEAR(out[k][s].real(), expected[channel_map[k]][s].real(), 1e-3)
+                    << "output " << k << " step " << s;
+                EXPECT_NEAR(out[k][s].imag(), expected[channel_map[k]][s].imag(), 1e-3)
+                    << "output " << k << " step " << s;
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(PolyphaseFilterbank, channelize_critically_sampled)
+{
+    check_channelize(16, 1.0, 1000);
+    check_channelize(5, 1.0, 100);
+}
+
+TEST(PolyphaseFilterbank, channelize_oversampled)
+{
+    check_channelize(16, 2.0, 1000);
+    // input advances three samples every four time steps
+    check_channelize(8, 4.0 / 3, 999);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <gnuradio/kernel/math/random.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+using rng_t = gr::kernel::math::random;
+
+TEST(Random, fill_uniform_range)
+{
+    rng_t rng(1);
+    std::vector<float> out(100003);
+    rng.fill_uniform(out.data(), out.size());
+
+    double mean = 0;
+    for (auto x : out) {
+        EXPECT_GE(x, 0.0f);
+        EXPECT_LT(x, 1.0f);
+        mean += x;
+    }
+    EXPECT_NEAR(mean / out.size(), 0.5, 0.01);
+
+    rng.fill_uniform(out.data(), out.size(), -3, 5);
+    for (auto x : out) {
+        EXPECT_GE(x, -3.0f);
+        EXPECT_LE(x, 5.0f);
+    }
+}
+
+TEST(Random, fill_gaussian_moments)
+{
+    rng_t rng(2);
+    std::vector<float> out(1000000);
+    rng.fill_gaussian(out.data(), out.size(), 2);
+
+    double mean = 0, power = 0;
+    for (auto x : out) {
+        ASSERT_TRUE(std::isfinite(x));
+        mean += x;
+        power += x * x;
+    }
+    mean /= out.size();
+    EXPECT_NEAR(mean, 0, 0.01);
+    EXPECT_NEAR(power / out.size() - mean * mean, 4, 0.04);
+}
+
+// The same seed gives the same numbers however they are split across calls
+TEST(Random, reproducible_per_seed)
+{
+    const size_t n = 5000;
+    rng_t whole(42), split(42), other(43);
+    std::vector<float> a(n), b(n), c(n);
+
+    whole.fill_uniform(a.data(), n);
+    size_t pos = 0;
+    for (size_t len = 1; pos < n; len = len * 3 + 1) {
+        auto count = std::min(len, n - pos);
+        split.fill_uniform(&b[pos], count);
+        pos += count;
+    }
+    EXPECT_EQ(a, b);
+
+    other.fill_uniform(c.data(), n);
+    EXPECT_NE(a, c);
+
+    whole.fill_gaussian(a.data(), n);
+    split.fill_gaussian(b.data(), 7);
+    split.fill_gaussian(&b[7], 1000);
+    split.fill_gaussian(&b[1007], n - 1007);
+    EXPECT_EQ(a, b);
+
+    // reseeding starts the sequence over
+    whole.reseed(42);
+    whole.fill_uniform(b.data(), n);
+    split.reseed(42);
+    split.fill_uniform(c.data(), n);
+    EXPECT_EQ(b, c);
+}
@@ -74,10 +74,25 @@ class client(gr.rpc_client_interface):
     def block_parameter_query(self, block_name, parameter_name):
         pass
 
+    @rpc_return
+    @rpc_execute()
+    def block_parameters_query(self, block_name, parameter_names):
+        pass
+
     @rpc_execute()
     def block_parameter_change(self, block_name, parameter_name, encoded_value):
         pass
 
+    @rpc_return
+    @rpc_execute()
+    def block_perf_counters(self, block_name):
+        pass
+
+    @rpc_return
+    @rpc_execute()
+    def edge_perf_counters(self, edge_name):
+        pass
+
     @rpc_return
     @rpc_execute()
     def flowgraph_connect(self, fg_name, src, dst, edge_name):
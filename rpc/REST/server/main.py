@@ -171,6 +171,14 @@ class Session:
         ret['result'] = b64str
         return ret
 
+    def block_parameters_query(self, **kwargs): #block_name, parameters
+
+        # serviced by the thread running the block in a single round trip
+        fut = self.blocks[kwargs['block_name']].request_parameters_query_async(
+            kwargs['parameter_names'])
+
+        return {'result': [v.to_base64() for v in fut.get()]}
+
     def block_parameter_change(self, **kwargs): #block_name, parameter, payload):
 
         newvalue = pmtf.pmt.from_base64(kwargs['encoded_value'])
@@ -181,6 +189,16 @@ class Session:
         self.blocks[kwargs['block_name']].request_parameter_change(kwargs['parameter_name'], newvalue, False)
         return {}
 
+    def block_perf_counters(self, **kwargs): #block_name
+        pc = self.blocks[kwargs['block_name']].perf_counters()
+        fields = ['work_calls', 'items_in', 'items_out', 'work_time', 'blocked_in',
+                  'blocked_out', 'avg_input_fullness', 'avg_output_fullness']
+        return {'result': {f: getattr(pc, f) for f in fields}}
+
+    def edge_perf_counters(self, **kwargs): #edge_name
+        pc = self.edges[kwargs['edge_name']].perf_counters()
+        return {'result': {'bytes': pc.bytes, 'occupancy': list(pc.occupancy)}}
+
     def block_create_message_port_proxy(self, block_name, port_name, payload):
         upstream = payload['upstream']
         proxy_name = ''.join(random.SystemRandom().choice(string.ascii_letters + string.digits) for _ in range(10))
@@ -10,38 +10,165 @@
 namespace gr {
 namespace schedulers {
 
+/**
+ * @brief Precomputed execution state for a single block
+ *
+ * Holds the stream ports and the work_io objects that are handed to the block on every
+ * work call, so that they are only allocated once per flowgraph run
+ *
+ */
+struct block_execution_plan {
+    block_sptr blk;
+    std::vector<port_sptr> input_ports;
+    std::vector<port_sptr> output_ports;
+    std::vector<block_work_input_sptr> work_input;
+    std::vector<block_work_output_sptr> work_output;
+    // the block forwards tags and at least one output buffer keeps them
+    bool propagate_tags = false;
+    // the block will not be called again, see graph_executor::finish_block
+    bool finished = false;
+    // parameter changes waiting for the block to reach their sample, by sample
+    std::multimap<uint64_t, std::shared_ptr<param_change_action>> param_changes;
+    // the last work call was shortened to stop at the next parameter change
+    bool param_split = false;
+    // the input or output is an edge inside a fused chain, which needs no notification
+    bool fused_input = false;
+    bool fused_output = false;
+};
+
 /**
  * @brief Responsible for the execution of a graph
  *
  * Maintains the list of blocks for a particular thread and executes the workflow when
  * run_one_iteration is called
  *
+ * End of stream is propagated along the edges: a block is finished once its work
+ * returns DONE, once every input has reached end of stream and been drained, or once
+ * every reader of its outputs is finished.  Finishing marks the output buffers as end of
+ * stream and the input readers as done, and notifies the neighbors, so the flowgraph
+ * drains as soon as the last item has been consumed.
+ *
  */
 class graph_executor : public executor
 {
 private:
     std::vector<block_sptr> d_blocks;
 
+    // Built on the first iteration, once the buffers have been attached to the ports
+    std::vector<block_execution_plan> d_plan;
+    bool d_plan_built = false;
+    std::vector<executor_iteration_status> d_status;
+
+    // Notifications carry no per-call state, so the same message can be pushed every time
+    scheduler_message_sptr d_notify_input_msg;
+    scheduler_message_sptr d_notify_output_msg;
+
     // Move to buffer management
     const int s_fixed_buf_size;
     static const int s_min_items_to_process = 1;
     const size_t s_min_buf_items = 1;
+    // passes of a fused chain per iteration, each moving at most one tile
+    static const size_t s_max_fused_passes = 64;
 
     buffer_manager::sptr _bufman;
 
+    bool d_flushing = false;
+    bool d_fused = false;
+
+    void build_plan();
+    void finish_block(block_execution_plan& plan);
+    executor_iteration_status run_block(block_execution_plan& plan);
+    void run_all_blocks();
+    bool chain_progressed() const;
+
+    /**
+     * @brief Absolute sample index of the block, on which parameter changes are timed
+     *
+     * Items read on the first input port, or items written on the first output port for
+     * a source
+     */
+    static uint64_t position(const block_execution_plan& plan);
+
+    /**
+     * @brief Fewest items on an input that a work call of the block can make use of
+     *
+     * Enough for the minimum read of the buffer, the min_input_items of the block and
+     * one output multiple at the relative rate of the block
+     */
+    static size_t min_input_needed(const block_sptr& b, const block_work_input_sptr& w);
+    /**
+     * @brief Number of items the next work call may process before the next scheduled
+     * parameter change
+     *
+     * Rounded down to whole output multiples of the block.  Changes that are closer
+     * than that are applied right away.
+     */
+    size_t param_change_limit(block_execution_plan& plan);
+    void apply_parameter_change(block_sptr blk,
+                                std::shared_ptr<param_change_action> item);
+    bool apply_parameter_changes(block_execution_plan& plan);
+
 public:
-    graph_executor(const std::string& name) : executor(name), s_fixed_buf_size(32768){};
+    graph_executor(const std::string& name)
+        : executor(name),
+          d_notify_input_msg(
+              std::make_shared<scheduler_action>(scheduler_action_t::NOTIFY_INPUT)),
+          d_notify_output_msg(
+              std::make_shared<scheduler_action>(scheduler_action_t::NOTIFY_OUTPUT)),
+          s_fixed_buf_size(32768){};
     ~graph_executor(){};
 
     void initialize(buffer_manager::sptr bufman, std::vector<block_sptr> blocks)
     {
         _bufman = bufman;
         d_blocks = blocks;
+        d_plan_built = false;
     }
 
-    std::map<nodeid_t, executor_iteration_status>
-    run_one_iteration(std::vector<block_sptr> blocks = std::vector<block_sptr>());
+    const std::vector<block_sptr>& blocks() const { return d_blocks; }
+
+    /**
+     * @brief Treat the blocks as a fused chain, in the order given to initialize()
+     *
+     * run_one_iteration then keeps calling the chain until a block stops making
+     * progress, so each pass moves one tile of items from the first block to the last.
+     * It returns after s_max_fused_passes passes, with every block READY, so that the
+     * thread handles its messages before it is called again.
+     */
+    void set_fused(bool fused) { d_fused = fused; }
+
+    /**
+     * @brief Run every block assigned to this executor once
+     *
+     * @return const std::vector<executor_iteration_status>& Status of each block,
+     * indexed by the position of the block in the vector passed to initialize()
+     */
+    const std::vector<executor_iteration_status>& run_one_iteration();
+
+    /**
+     * @brief Apply a parameter change, or hold it back until the block reaches the
+     * requested sample
+     *
+     * Work calls are split so that a change with a non-zero at_sample is applied
+     * exactly before that sample.  Changes for blocks not in this executor are ignored.
+     *
+     * @param item
+     */
+    void handle_parameter_change(std::shared_ptr<param_change_action> item);
+
+    /**
+     * @brief The flowgraph is shutting down
+     *
+     * Source blocks are finished on the next iteration, as are inputs whose writer lives
+     * in another process and cannot signal end of stream
+     */
+    void start_flushing() { d_flushing = true; }
+
+    /**
+     * @brief Whether every block with stream ports has finished
+     */
+    bool all_finished() const;
 };
 
 } // namespace schedulers
-} // namespace gr
\ No newline at end of file
+} // namespace gr
@@ -14,6 +14,16 @@ private:
     const int s_fixed_buf_size;
     std::map<nodeid_t, neighbor_interface_sptr> _block_thread_map;
     std::vector<block_group_properties> _block_groups;
+    // threads that have not finished flushing yet
+    std::atomic<size_t> _num_unflushed{ 0 };
+    runtime_monitor_sptr _rtmon;
+
+    void thread_flushed();
+    wait_policy_t _default_wait_policy = wait_policy_t::BLOCK;
+    unsigned int _default_spin_count = block_group_properties::default_spin_count;
+    size_t _fuse_tile_bytes = 0;
+    bool _inplace_buffers = false;
+    std::vector<fused_chain> _fused_chains;
 
 public:
     using sptr = std::shared_ptr<scheduler_nbt>;
@@ -35,6 +45,49 @@ public:
     void add_block_group(const std::vector<block_sptr>& blocks,
                          const std::string& name = "",
                          const std::vector<unsigned int>& affinity_mask = {});
+    void add_block_group(const block_group_properties& bgp);
+
+    /**
+     * @brief Set the wait policy for threads whose block group did not set one
+     *
+     * @param policy
+     * @param spin_count number of polls before blocking, for SPIN_THEN_BLOCK
+     */
+    void set_default_wait_policy(
+        wait_policy_t policy,
+        unsigned int spin_count = block_group_properties::default_spin_count)
+    {
+        _default_wait_policy = policy;
+        _default_spin_count = spin_count;
+    }
+
+    /**
+     * @brief Fuse linear chains of sync blocks
+     *
+     * Each chain found by graph_utils::sync_chains among the blocks that are not in a
+     * block group gets a single thread, which runs the blocks back to back over tiles of
+     * tile_bytes.  The buffers inside the chain are replaced by one tile each, so the
+     * items stay in cache from one block to the next instead of going through memory.
+     *
+     * @param tile_bytes size of the tiles, 0 to not fuse any blocks
+     */
+    void set_fuse_tile_size(size_t tile_bytes) { _fuse_tile_bytes = tile_bytes; }
+
+    /**
+     * @brief The chains fused by the last call to initialize()
+     */
+    const std::vector<fused_chain>& fused_chains() const { return _fused_chains; }
+
+    /**
+     * @brief Let blocks declared in-place write their output over their input
+     *
+     * See buffer_manager::set_inplace.  Long chains of such blocks then share one
+     * buffer, at the cost of the producer waiting for the last block of the chain to
+     * release the memory.
+     *
+     * @param inplace
+     */
+    void set_inplace_buffers(bool inplace) { _inplace_buffers = inplace; }
 
     /**
      * @brief Initialize the multi-threaded scheduler
@@ -53,6 +106,12 @@ public:
     void wait() override;
     void run();
     void kill() override;
+
+    /**
+     * @brief Total number of work notifications that were coalesced into one already
+     * pending on the receiving thread
+     */
+    uint64_t notifications_suppressed();
 };
 } // namespace schedulers
 } // namespace gr
\ No newline at end of file
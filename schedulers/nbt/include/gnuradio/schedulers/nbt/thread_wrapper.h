@@ -7,6 +7,7 @@
 #include <gnuradio/runtime_monitor.h>
 #include <gnuradio/scheduler_message.h>
 #include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <thread>
 
@@ -43,30 +44,71 @@ private:
     logger_ptr d_debug_logger;
 
     runtime_monitor_sptr d_rtmon;
+    std::function<void()> d_on_flushed;
 
     bool d_flushing = false;
-    int d_flush_cnt = 0;
+    bool d_done_reported = false;
+    bool d_flushed_reported = false;
     std::atomic<bool> kick_pending = false;
 
+    // Set while a work notification is sitting in msgq, so that neighbors do not queue
+    // up more than one of them
+    std::atomic<bool> d_notify_pending{ false };
+    std::atomic<uint64_t> d_notifications_suppressed{ 0 };
+
+    static bool is_work_notification(const scheduler_message_sptr& msg);
+
+    /**
+     * @brief Wait for the next message according to the block group wait policy
+     *
+     * @param msg
+     * @return true if a message was popped
+     */
+    bool wait_for_message(scheduler_message_sptr& msg);
+
 public:
     using sptr = std::shared_ptr<thread_wrapper>;
 
+    using flushed_fcn = std::function<void()>;
+
     static sptr make(int id,
                      block_group_properties bgp,
                      buffer_manager::sptr bufman,
-                     runtime_monitor_sptr rtmon)
+                     runtime_monitor_sptr rtmon,
+                     flushed_fcn on_flushed)
     {
-        return std::make_shared<thread_wrapper>(id, bgp, bufman, rtmon);
+        return std::make_shared<thread_wrapper>(id, bgp, bufman, rtmon, on_flushed);
     }
 
+    /**
+     * @brief Construct a new thread wrapper object
+     *
+     * @param id id of the owning scheduler
+     * @param bgp blocks executed by this thread
+     * @param bufman
+     * @param rtmon
+     * @param on_flushed called once, when every block in the thread has finished after
+     * the flowgraph started flushing
+     */
     thread_wrapper(int id,
                    block_group_properties bgp,
                    buffer_manager::sptr bufman,
-                   runtime_monitor_sptr rtmon);
+                   runtime_monitor_sptr rtmon,
+                   flushed_fcn on_flushed);
     int id() { return _id; }
     const std::string& name() { return d_block_group.name(); }
 
-    void push_message(scheduler_message_sptr msg) override { msgq.push(msg); }
+    /**
+     * @brief Queue a message for this thread
+     *
+     * Work notifications (NOTIFY_INPUT/OUTPUT/ALL) are coalesced: if one is already
+     * waiting in the queue, the new one is dropped, since the thread will run all of its
+     * blocks when it gets to the pending one anyway.
+     *
+     * @param msg
+     */
+    void push_message(scheduler_message_sptr msg) override;
+    void push_messages(const std::vector<scheduler_message_sptr>& msgs) override;
     bool pop_message(scheduler_message_sptr& msg) { return msgq.pop(msg); }
     bool pop_message_nonblocking(scheduler_message_sptr& msg)
     {
@@ -90,10 +132,16 @@ public:
     void handle_parameter_change(std::shared_ptr<param_change_action> item);
     static void thread_body(thread_wrapper* top);
 
+    /**
+     * @brief Number of work notifications that were dropped because one was already
+     * pending
+     */
+    uint64_t notifications_suppressed() const { return d_notifications_suppressed; }
+
     void start_flushing()
     {
         d_flushing = true;
-        d_flush_cnt = 0;
+        _exec->start_flushing();
         push_message(
             std::make_shared<scheduler_action>(scheduler_action_t::NOTIFY_ALL, 0));
     }
@@ -1,5 +1,10 @@
 #include "graph_executor.h"
 
+#include <gnuradio/high_res_timer.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace gr {
 namespace schedulers {
 
@@ -8,292 +13,604 @@ inline static unsigned int round_down(unsigned int n, unsigned int multiple)
     return (n / multiple) * multiple;
 }
 
-std::map<nodeid_t, executor_iteration_status>
-graph_executor::run_one_iteration(std::vector<block_sptr> blocks)
+void graph_executor::build_plan()
 {
-    std::map<nodeid_t, executor_iteration_status> per_block_status;
+    d_plan.clear();
+    d_plan.reserve(d_blocks.size());
+
+    for (auto const& b : d_blocks) {
+        block_execution_plan plan;
+        plan.blk = b;
+        plan.input_ports = b->input_stream_ports();
+        plan.output_ports = b->output_stream_ports();
+
+        for (auto& p : plan.input_ports) {
+            plan.work_input.push_back(
+                std::make_shared<block_work_input>(0, p->buffer_reader()));
+        }
+        for (auto& p : plan.output_ports) {
+            plan.work_output.push_back(
+                std::make_shared<block_work_output>(0, p->buffer()));
+        }
+
+        auto tpp = b->tag_propagation_policy();
+        if (tpp == tag_propagation_policy_t::TPP_ALL_TO_ALL ||
+            tpp == tag_propagation_policy_t::TPP_ONE_TO_ONE) {
+            for (auto& w : plan.work_output) {
+                plan.propagate_tags |= w->buffer->tags_needed();
+            }
+        }
 
-    // If no blocks are specified for the iteration, then run over all the blocks
-    // in the default ordering
-    if (blocks.empty()) {
-        blocks = d_blocks;
+        if (d_fused) {
+            plan.fused_input = !d_plan.empty();
+            plan.fused_output = d_plan.size() + 1 < d_blocks.size();
+        }
+
+        d_plan.push_back(std::move(plan));
     }
 
-    for (auto const& b : blocks) { // TODO - order the blocks
+    d_status.assign(d_blocks.size(), executor_iteration_status::READY);
+    d_plan_built = true;
+}
 
-        std::vector<block_work_input_sptr> work_input;   //(num_input_ports);
-        std::vector<block_work_output_sptr> work_output; //(num_output_ports);
+void graph_executor::finish_block(block_execution_plan& plan)
+{
+    d_debug_logger->debug("{} finished", plan.blk->alias());
+    plan.finished = true;
 
-        // If a block is a message port only block, it will raise the finished() flag
-        // to indicate that the rest of the flowgraph should clean up
-        if (b->finished()) {
-            per_block_status[b->id()] = executor_iteration_status::DONE;
-            d_debug_logger->debug("pbs[{}]: {}", b->id(), per_block_status[b->id()]);
-            continue;
+    for (auto& w : plan.work_output) {
+        w->buffer->set_eos();
+    }
+    for (auto& w : plan.work_input) {
+        w->buffer->set_done();
+    }
+
+    // Wake up the neighbors so they can finish in turn
+    for (auto& p : plan.input_ports) {
+        p->notify_connected_ports(d_notify_output_msg);
+    }
+    for (auto& p : plan.output_ports) {
+        p->notify_connected_ports(d_notify_input_msg);
+    }
+
+    // Changes scheduled past the end of the stream are applied now, so that nobody is
+    // left waiting on them
+    apply_parameter_changes(plan);
+}
+
+uint64_t graph_executor::position(const block_execution_plan& plan)
+{
+    if (!plan.work_input.empty()) {
+        return plan.work_input[0]->buffer->total_read();
+    }
+    if (!plan.work_output.empty()) {
+        return plan.work_output[0]->buffer->total_written();
+    }
+    return std::numeric_limits<uint64_t>::max();
+}
+
+size_t graph_executor::min_input_needed(const block_sptr& b,
+                                        const block_work_input_sptr& w)
+{
+    size_t needed = std::max({ static_cast<size_t>(s_min_items_to_process),
+                               w->buffer->min_buffer_read(),
+                               b->min_input_items() });
+    if (b->relative_rate() > 0) {
+        needed = std::max(
+            needed,
+            static_cast<size_t>(std::ceil(b->output_multiple() / b->relative_rate())));
+    }
+    return needed;
+}
+
+void graph_executor::apply_parameter_change(block_sptr blk,
+                                            std::shared_ptr<param_change_action> item)
+{
+    d_debug_logger->debug("apply parameter change {}", blk->alias());
+    blk->on_parameter_change(item->param_action());
+    if (item->cb_fcn() != nullptr)
+        item->cb_fcn()(item->param_action());
+}
+
+size_t graph_executor::param_change_limit(block_execution_plan& plan)
+{
+    auto& b = plan.blk;
+    size_t multiple = 1;
+    if (b->output_multiple_set()) {
+        multiple = b->output_multiple();
+        if (!plan.work_input.empty() && b->relative_rate() > 0) {
+            multiple = std::max(1l, std::lround(multiple / b->relative_rate()));
         }
+    }
+
+    while (!plan.param_changes.empty()) {
+        auto it = plan.param_changes.begin();
+        size_t limit = it->first - position(plan);
+        limit -= limit % multiple;
+        if (limit > 0) {
+            return limit;
+        }
+        // Closer than a whole output multiple, the block cannot stop on it
+        apply_parameter_change(plan.blk, it->second);
+        plan.param_changes.erase(it);
+    }
+    return std::numeric_limits<size_t>::max();
+}
 
-        auto input_stream_ports = b->input_stream_ports();
-        auto output_stream_ports = b->output_stream_ports();
+bool graph_executor::apply_parameter_changes(block_execution_plan& plan)
+{
+    bool applied = false;
+    auto pos = position(plan);
+    auto it = plan.param_changes.begin();
+    while (it != plan.param_changes.end() && (plan.finished || it->first <= pos)) {
+        apply_parameter_change(plan.blk, it->second);
+        it = plan.param_changes.erase(it);
+        applied = true;
+    }
+    return applied;
+}
 
-        if (input_stream_ports.empty() && output_stream_ports.empty()) {
-            // There is no streaming work to do for this block
-            per_block_status[b->id()] = executor_iteration_status::MSG_ONLY;
+void graph_executor::handle_parameter_change(std::shared_ptr<param_change_action> item)
+{
+    if (!d_plan_built) {
+        build_plan();
+    }
+
+    auto at_sample = item->param_action()->at_sample();
+    for (auto& plan : d_plan) {
+        if (plan.blk->id() != item->blkid()) {
             continue;
         }
+        if (at_sample > position(plan) && !plan.finished) {
+            d_debug_logger->debug(
+                "queue parameter change {} at {}", plan.blk->alias(), at_sample);
+            plan.param_changes.emplace(at_sample, item);
+            return;
+        }
+        apply_parameter_change(plan.blk, item);
+        return;
+    }
+}
 
-        // for each input port of the block
-        bool ready = true;
-        for (auto p : input_stream_ports) {
-            auto p_buf = p->buffer_reader();
-            auto max_read = p_buf->max_buffer_read();
-            auto min_read = p_buf->min_buffer_read();
+bool graph_executor::all_finished() const
+{
+    if (!d_plan_built) {
+        return false;
+    }
+    for (auto& plan : d_plan) {
+        if (!plan.finished && (!plan.work_input.empty() || !plan.work_output.empty())) {
+            return false;
+        }
+    }
+    return true;
+}
 
-            buffer_info_t read_info;
-            ready = p_buf->read_info(read_info);
-            d_debug_logger->debug(
-                         "read_info {} - {} - {}",
-                         b->alias(),
-                         read_info.n_items,
-                         read_info.item_size);
+executor_iteration_status graph_executor::run_block(block_execution_plan& plan)
+{
+    auto& b = plan.blk;
+    auto status = executor_iteration_status::READY;
+    auto& work_input = plan.work_input;
+    auto& work_output = plan.work_output;
+    plan.param_split = false;
+
+    if (plan.finished) {
+        return executor_iteration_status::DONE;
+    }
 
-            if (!ready)
-                break;
+    // If a block is a message port only block, it will raise the finished() flag
+    // to indicate that the rest of the flowgraph should clean up
+    if (b->finished()) {
+        status = executor_iteration_status::DONE;
+        d_debug_logger->debug("pbs[{}]: {}", b->id(), status);
+        finish_block(plan);
+        return status;
+    }
 
-            if (read_info.n_items < s_min_items_to_process ||
-                (min_read > 0 && read_info.n_items < (int)min_read)) {
+    if (work_input.empty() && work_output.empty()) {
+        // There is no streaming work to do for this block
+        status = executor_iteration_status::MSG_ONLY;
+        return status;
+    }
 
-                p_buf->input_blocked_callback(s_min_items_to_process);
+    // Sources stop producing once the flowgraph is flushing, and there is no point
+    // in producing what nobody will read
+    bool outputs_abandoned = !work_output.empty();
+    for (auto& w : work_output) {
+        outputs_abandoned &= w->buffer->readers_done();
+    }
+    if ((d_flushing && work_input.empty()) || outputs_abandoned) {
+        status = executor_iteration_status::DONE;
+        d_debug_logger->debug("pbs[{}]: {}", b->id(), status);
+        finish_block(plan);
+        return status;
+    }
 
-                ready = false;
-                break;
-            }
+    // Checked before reading, so that anything written before the end of stream
+    // is seen by this iteration
+    bool inputs_eos = !work_input.empty();
+    for (auto& w : work_input) {
+        inputs_eos &= w->buffer->eos() ||
+                      (d_flushing && !w->buffer->propagates_eos());
+    }
 
-            if (max_read > 0 && read_info.n_items > (int)max_read) {
-                read_info.n_items = max_read;
-            }
+    auto& perf = b->perf_counters();
+
+    // for each input port of the block
+    bool ready = true;
+    for (auto& w : work_input) {
+        auto& p_buf = w->buffer;
+        auto max_read = p_buf->max_buffer_read();
+        auto min_read = p_buf->min_buffer_read();
+
+        buffer_info_t read_info;
+        ready = p_buf->read_info(read_info);
+        d_debug_logger->debug(
+                     "read_info {} - {} - {}",
+                     b->alias(),
+                     read_info.n_items,
+                     read_info.item_size);
 
+        if (!ready)
+            break;
 
-            auto tags = p_buf->get_tags(read_info.n_items);
-            work_input.push_back(
-                std::make_shared<block_work_input>(read_info.n_items, p_buf));
+        auto occupancy = p_buf->occupancy();
+        p_buf->perf_counters().add_occupancy(occupancy);
+        perf.add_input_fullness(occupancy);
+
+        if (read_info.n_items < s_min_items_to_process ||
+            (min_read > 0 && read_info.n_items < (int)min_read)) {
+
+            p_buf->input_blocked_callback(s_min_items_to_process);
+
+            ready = false;
+            break;
         }
 
-        if (!ready) {
-            per_block_status[b->id()] = executor_iteration_status::BLKD_IN;
-            continue;
+        // Blocks asking for larger work calls wait for them while more input can come
+        if (!inputs_eos && read_info.n_items < (int)b->min_work_items()) {
+            p_buf->input_blocked_callback(b->min_work_items());
+            ready = false;
+            break;
         }
 
-        // for each output port of the block
-        for (auto p : output_stream_ports) {
+        if (max_read > 0 && read_info.n_items > (int)max_read) {
+            read_info.n_items = max_read;
+        }
 
-            // When a block has multiple output buffers, it adds the restriction
-            // that the work call can only produce the minimum available across
-            // the buffers.
+        // Tags are not looked up here, blocks that read them ask for them in work
+        w->n_items = read_info.n_items;
+        w->n_consumed = 0;
+    }
 
-            size_t max_output_buffer = std::numeric_limits<int>::max();
+    if (!ready) {
+        status = executor_iteration_status::BLKD_IN;
+        perf.add_blocked_in();
+        if (inputs_eos) {
+            // Whatever is left can never be processed
+            finish_block(plan);
+        }
+        return status;
+    }
 
-            auto p_buf = p->buffer();
-            auto max_fill = p_buf->max_buffer_fill();
-            auto min_fill = p_buf->min_buffer_fill();
+    // Room is needed for the minimum work, or for what the input left can produce
+    size_t min_work_out = b->min_work_items();
+    for (auto& w : work_input) {
+        min_work_out =
+            std::min(min_work_out, static_cast<size_t>(w->n_items * b->relative_rate()));
+    }
 
-            buffer_info_t write_info;
-            ready = p_buf->write_info(write_info);
-            d_debug_logger->debug(
-                         "write_info {} - {} @ {} {}",
-                         b->alias(),
-                         write_info.n_items,
-                         write_info.ptr,
-                         write_info.item_size);
-
-            size_t tmp_buf_size = write_info.n_items;
-            if (tmp_buf_size < s_min_buf_items ||
-                (min_fill > 0 && tmp_buf_size < min_fill)) {
-                ready = false;
-                p_buf->output_blocked_callback(false);
-                break;
-            }
+    // for each output port of the block
+    for (auto& w : work_output) {
 
-            if (tmp_buf_size < max_output_buffer)
-                max_output_buffer = tmp_buf_size;
+        // When a block has multiple output buffers, it adds the restriction
+        // that the work call can only produce the minimum available across
+        // the buffers.
 
-            if (max_fill > 0 && max_output_buffer > max_fill) {
-                max_output_buffer = max_fill;
-            }
+        size_t max_output_buffer = std::numeric_limits<int>::max();
 
-            if (b->output_multiple_set()) {
-                max_output_buffer = round_down(max_output_buffer, b->output_multiple());
-            }
+        auto& p_buf = w->buffer;
+        auto max_fill = p_buf->max_buffer_fill();
+        auto min_fill = p_buf->min_buffer_fill();
 
-            if (max_output_buffer <= 0) {
-                ready = false;
-            }
+        buffer_info_t write_info;
+        ready = p_buf->write_info(write_info);
+        d_debug_logger->debug(
+                     "write_info {} - {} @ {} {}",
+                     b->alias(),
+                     write_info.n_items,
+                     write_info.ptr,
+                     write_info.item_size);
 
-            if (!ready)
-                break;
+        if (p_buf->buf_size() > 0) {
+            perf.add_output_fullness((double)p_buf->bytes_unread() / p_buf->buf_size());
+        }
 
+        size_t tmp_buf_size = write_info.n_items;
+        if (tmp_buf_size < s_min_buf_items ||
+            (min_fill > 0 && tmp_buf_size < min_fill) || tmp_buf_size < min_work_out) {
+            ready = false;
+            p_buf->output_blocked_callback(false);
+            break;
+        }
 
-            std::vector<tag_t> tags; // needs to be associated with edge buffers
+        if (tmp_buf_size < max_output_buffer)
+            max_output_buffer = tmp_buf_size;
 
-            work_output.push_back(
-                std::make_shared<block_work_output>(max_output_buffer, p_buf));
+        if (max_fill > 0 && max_output_buffer > max_fill) {
+            max_output_buffer = max_fill;
         }
 
-        if (!ready) {
-            per_block_status[b->id()] = executor_iteration_status::BLKD_OUT;
-            continue;
+        if (b->output_multiple_set()) {
+            max_output_buffer = round_down(max_output_buffer, b->output_multiple());
         }
 
-        if (ready) {
-            work_return_code_t ret;
-            while (true) {
+        if (max_output_buffer <= 0) {
+            ready = false;
+        }
 
-                if (!work_output.empty()) {
-                    d_debug_logger->debug(
-                                 "do_work (output) for {}, {}",
-                                 b->alias(),
-                                 work_output[0]->n_items);
-                }
-                else if (!work_input.empty())
-                {
-                    d_debug_logger->debug(
-                                 "do_work (input) for {}, {}",
-                                 b->alias(),
-                                 work_input[0]->n_items);
-                }
-                else {
-                    d_debug_logger->debug("do_work for {}", b->alias());
-                }
+        if (!ready)
+            break;
 
+        w->n_items = max_output_buffer;
+        w->n_produced = 0;
+    }
 
-                ret = b->do_work(work_input, work_output);
-                d_debug_logger->debug("do_work returned {}", ret);
-                // ret = work_return_code_t::WORK_OK;
+    if (!ready) {
+        status = executor_iteration_status::BLKD_OUT;
+        perf.add_blocked_out();
+        return status;
+    }
 
-                if (ret == work_return_code_t::WORK_DONE) {
-                    per_block_status[b->id()] = executor_iteration_status::DONE;
-                    d_debug_logger->debug("pbs[{}]: {}", b->id(), per_block_status[b->id()]);
-                    break;
-                }
-                else if (ret == work_return_code_t::WORK_OK) {
-                    per_block_status[b->id()] = executor_iteration_status::READY;
-                    d_debug_logger->debug("pbs[{}]: {}", b->id(), per_block_status[b->id()]);
+    // Stop the work call right before the next scheduled parameter change.  Sources
+    // count the position on their output.
+    if (!plan.param_changes.empty()) {
+        auto limit = param_change_limit(plan);
+        if (!work_input.empty() && limit < work_input[0]->n_items) {
+            work_input[0]->n_items = limit;
+            plan.param_split = true;
+        }
+        for (auto& w : work_output) {
+            if (work_input.empty() && limit < w->n_items) {
+                w->n_items = limit;
+                plan.param_split = true;
+            }
+        }
+    }
 
-                    // If a source block, and no outputs were produced, mark as BLKD_IN
-                    if (work_input.empty() && !work_output.empty()) {
-                        size_t max_output = 0;
-                        for (auto& w : work_output) {
-                            max_output = std::max(w->n_produced, max_output);
-                        }
-                        if (max_output <= 0) {
-                            per_block_status[b->id()] =
-                                executor_iteration_status::BLKD_IN;
-                            d_debug_logger->debug(
-                                         "pbs[{}]: {}",
-                                         b->id(),
-                                         per_block_status[b->id()]);
-                        }
-                    }
+    if (ready) {
+        work_return_code_t ret;
+        auto work_start = high_res_timer_now();
+        while (true) {
+
+            if (!work_output.empty()) {
+                d_debug_logger->debug(
+                             "do_work (output) for {}, {}",
+                             b->alias(),
+                             work_output[0]->n_items);
+            }
+            else if (!work_input.empty())
+            {
+                d_debug_logger->debug(
+                             "do_work (input) for {}, {}",
+                             b->alias(),
+                             work_input[0]->n_items);
+            }
+            else {
+                d_debug_logger->debug("do_work for {}", b->alias());
+            }
 
 
-                    break;
-                }
-                else if (ret == work_return_code_t::WORK_INSUFFICIENT_INPUT_ITEMS) {
-                    if (b->output_multiple_set()) {
-                        work_output[0]->n_items -= b->output_multiple();
-                    }
-                    else {
-                        work_output[0]->n_items >>= 1;
+            ret = b->do_work(work_input, work_output);
+            d_debug_logger->debug("do_work returned {}", ret);
+            // ret = work_return_code_t::WORK_OK;
+
+            if (ret == work_return_code_t::WORK_DONE) {
+                status = executor_iteration_status::DONE;
+                d_debug_logger->debug("pbs[{}]: {}", b->id(), status);
+                break;
+            }
+            else if (ret == work_return_code_t::WORK_OK) {
+                status = executor_iteration_status::READY;
+                d_debug_logger->debug("pbs[{}]: {}", b->id(), status);
+
+                // If a source block, and no outputs were produced, mark as BLKD_IN
+                if (work_input.empty() && !work_output.empty()) {
+                    size_t max_output = 0;
+                    for (auto& w : work_output) {
+                        max_output = std::max(w->n_produced, max_output);
                     }
-                    if (work_output[0]->n_items < b->output_multiple()) // min block size
-                    {
-                        per_block_status[b->id()] = executor_iteration_status::BLKD_IN;
-                        d_debug_logger->debug(
-                                     "pbs[{}]: {}",
-                                     b->id(),
-                                     per_block_status[b->id()]);
-                        // call the input blocked callback
-                        break;
+                    if (max_output <= 0) {
+                        status = executor_iteration_status::BLKD_IN;
+                        d_debug_logger->debug("pbs[{}]: {}", b->id(), status);
                     }
                 }
-                else if (ret == work_return_code_t::WORK_INSUFFICIENT_OUTPUT_ITEMS) {
-                    per_block_status[b->id()] = executor_iteration_status::BLKD_OUT;
-                    d_debug_logger->debug("pbs[{}]: {}", b->id(), per_block_status[b->id()]);
-                    // call the output blocked callback
+
+
+                break;
+            }
+            else if (ret == work_return_code_t::WORK_INSUFFICIENT_INPUT_ITEMS) {
+                if (b->output_multiple_set()) {
+                    work_output[0]->n_items -= b->output_multiple();
+                }
+                else {
+                    work_output[0]->n_items >>= 1;
+                }
+                if (work_output[0]->n_items < b->output_multiple()) // min block size
+                {
+                    status = executor_iteration_status::BLKD_IN;
+                    d_debug_logger->debug("pbs[{}]: {}", b->id(), status);
+                    // call the input blocked callback
                     break;
                 }
             }
-            // TODO - handle READY_NO_OUTPUT
-
-            if (ret == work_return_code_t::WORK_OK ||
-                ret == work_return_code_t::WORK_DONE) {
+            else if (ret == work_return_code_t::WORK_INSUFFICIENT_OUTPUT_ITEMS) {
+                status = executor_iteration_status::BLKD_OUT;
+                d_debug_logger->debug("pbs[{}]: {}", b->id(), status);
+                // call the output blocked callback
+                break;
+            }
+        }
+        // TODO - handle READY_NO_OUTPUT
 
+        if (status == executor_iteration_status::BLKD_IN) {
+            perf.add_blocked_in();
+        }
+        else if (status == executor_iteration_status::BLKD_OUT) {
+            perf.add_blocked_out();
+        }
 
-                int input_port_index = 0;
-                for (auto p : b->input_stream_ports()) {
-                    auto p_buf = p->buffer_reader();
+        if (ret == work_return_code_t::WORK_OK ||
+            ret == work_return_code_t::WORK_DONE) {
+            uint64_t items_in = 0;
+            uint64_t items_out = 0;
+            for (auto& w : work_input) {
+                items_in += w->n_consumed;
+            }
+            for (auto& w : work_output) {
+                items_out += w->n_produced;
+            }
+            perf.add_work(items_in, items_out, high_res_timer_now() - work_start);
 
-                    if (!p_buf->tags().empty()) {
-                        // Pass the tags according to TPP
-                        if (b->tag_propagation_policy() ==
-                            tag_propagation_policy_t::TPP_ALL_TO_ALL) {
-                            int output_port_index = 0;
-                            for (auto op : b->output_stream_ports()) {
-                                auto p_out_buf = op->buffer();
-                                p_out_buf->propagate_tags(
-                                    p_buf, work_input[input_port_index]->n_consumed);
+            int input_port_index = 0;
+            for (auto& p : plan.input_ports) {
+                auto& p_buf = work_input[input_port_index]->buffer;
 
-                                output_port_index++;
-                            }
+                if (plan.propagate_tags && !p_buf->tags().empty()) {
+                    // Pass the tags according to TPP
+                    if (b->tag_propagation_policy() ==
+                        tag_propagation_policy_t::TPP_ALL_TO_ALL) {
+                        for (auto& w : work_output) {
+                            w->buffer->propagate_tags(
+                                p_buf, work_input[input_port_index]->n_consumed);
                         }
-                        else if (b->tag_propagation_policy() ==
-                                 tag_propagation_policy_t::TPP_ONE_TO_ONE) {
-                            int output_port_index = 0;
-                            for (auto op : b->output_stream_ports()) {
-                                if (output_port_index == input_port_index) {
-                                    auto p_out_buf = op->buffer();
-                                    p_out_buf->propagate_tags(
-                                        p_buf, work_input[input_port_index]->n_consumed);
-                                }
-                                output_port_index++;
-                            }
+                    }
+                    else if (b->tag_propagation_policy() ==
+                             tag_propagation_policy_t::TPP_ONE_TO_ONE) {
+                        if (input_port_index < (int)work_output.size()) {
+                            work_output[input_port_index]->buffer->propagate_tags(
+                                p_buf, work_input[input_port_index]->n_consumed);
                         }
                     }
+                }
 
-                    d_debug_logger->debug(
-                                 "post_read {} - {}",
-                                 b->alias(),
-                                 work_input[input_port_index]->n_consumed);
-
-                    p_buf->post_read(work_input[input_port_index]->n_consumed);
-                    p->notify_connected_ports(std::make_shared<scheduler_action>(
-                        scheduler_action_t::NOTIFY_OUTPUT));
+                d_debug_logger->debug(
+                             "post_read {} - {}",
+                             b->alias(),
+                             work_input[input_port_index]->n_consumed);
 
-                    input_port_index++;
+                p_buf->post_read(work_input[input_port_index]->n_consumed);
+                p_buf->perf_counters().add_bytes(
+                    work_input[input_port_index]->n_consumed * p_buf->item_size());
+                if (!plan.fused_input) {
+                    p->notify_connected_ports(d_notify_output_msg);
                 }
 
-                int output_port_index = 0;
-                for (auto p : b->output_stream_ports()) {
-                    auto p_buf = p->buffer();
-
-                    d_debug_logger->debug(
-                                 "post_write {} - {}",
-                                 b->alias(),
-                                 work_output[output_port_index]->n_produced);
-                    p_buf->post_write(work_output[output_port_index]->n_produced);
+                input_port_index++;
+            }
 
-                    p->notify_connected_ports(std::make_shared<scheduler_action>(
-                        scheduler_action_t::NOTIFY_INPUT));
+            int output_port_index = 0;
+            for (auto& p : plan.output_ports) {
+                auto& p_buf = work_output[output_port_index]->buffer;
 
-                    output_port_index++;
+                d_debug_logger->debug(
+                             "post_write {} - {}",
+                             b->alias(),
+                             work_output[output_port_index]->n_produced);
+                p_buf->post_write(work_output[output_port_index]->n_produced);
 
-                    p_buf->prune_tags();
+                if (!plan.fused_output) {
+                    p->notify_connected_ports(d_notify_input_msg);
                 }
+
+                output_port_index++;
+
+                p_buf->prune_tags();
+            }
+        }
+
+        if (status == executor_iteration_status::DONE) {
+            finish_block(plan);
+        }
+        else if (inputs_eos) {
+            // Blocked on input only ends the block when what is left can never be
+            // enough: the work call may have been given a shorter window than that, e.g.
+            // by max_buffer_read or a parameter change
+            bool drained = true;
+            bool starved = true;
+            for (auto& w : work_input) {
+                buffer_info_t read_info;
+                bool valid = w->buffer->read_info(read_info);
+                drained &= valid && read_info.n_items == 0;
+                starved &= valid && read_info.n_items < (int)min_input_needed(b, w);
+            }
+            if (drained || (status == executor_iteration_status::BLKD_IN && starved)) {
+                finish_block(plan);
             }
         }
     }
 
+    return status;
+}
+
+const std::vector<executor_iteration_status>& graph_executor::run_one_iteration()
+{
+    if (!d_plan_built) {
+        build_plan();
+    }
+
+    // A chain whose input never runs dry would otherwise keep the thread from its
+    // messages, e.g. EXIT or parameter changes
+    size_t passes = 0;
+    do {
+        run_all_blocks();
+    } while (d_fused && ++passes < s_max_fused_passes && chain_progressed());
+
+    return d_status;
+}
+
+bool graph_executor::chain_progressed() const
+{
+    // Every block has to have been called, and the last one to have passed items on
+    for (auto status : d_status) {
+        if (status != executor_iteration_status::READY) {
+            return false;
+        }
+    }
+    auto& last = d_plan.back();
+    return !last.work_output.empty() && last.work_output[0]->n_produced > 0;
+}
 
-    return per_block_status;
+void graph_executor::run_all_blocks()
+{
+    for (size_t blk_idx = 0; blk_idx < d_plan.size(); blk_idx++) {
+        auto& plan = d_plan[blk_idx];
+        auto& status = d_status[blk_idx];
+
+        apply_parameter_changes(plan);
+        status = run_block(plan);
+
+        while (true) {
+            if (status == executor_iteration_status::READY &&
+                apply_parameter_changes(plan)) {
+                // The work call stopped short at a scheduled parameter change, pick up
+                // the rest of the input with the new value
+            }
+            else if ((status == executor_iteration_status::BLKD_IN ||
+                      status == executor_iteration_status::BLKD_OUT) &&
+                     plan.param_split && !plan.param_changes.empty()) {
+                // The block made no progress on the shortened call, it cannot stop
+                // exactly at the requested sample (e.g. it works on whole blocks of
+                // items), so apply the change as close as it can
+                auto it = plan.param_changes.begin();
+                apply_parameter_change(plan.blk, it->second);
+                plan.param_changes.erase(it);
+            }
+            else {
+                break;
+            }
+            status = run_block(plan);
+        }
+    }
 }
 
 } // namespace schedulers
@@ -1,5 +1,8 @@
 #include <gnuradio/schedulers/nbt/scheduler_nbt.h>
+#include <gnuradio/buffer_cpu_lockfree.h>
+#include <gnuradio/thread.h>
 #include <yaml-cpp/yaml.h>
+#include <algorithm>
 
 namespace gr {
 namespace schedulers {
@@ -26,25 +29,78 @@ void scheduler_nbt::add_block_group(const std::vector<block_sptr>& blocks,
         std::move(block_group_properties(blocks, name, affinity_mask)));
 }
 
+void scheduler_nbt::add_block_group(const block_group_properties& bgp)
+{
+    _block_groups.push_back(bgp);
+}
+
 void scheduler_nbt::initialize(flat_graph_sptr fg, runtime_monitor_sptr fgmon)
 {
+    _rtmon = fgmon;
+    auto on_flushed = [this]() { thread_flushed(); };
 
     auto bufman = std::make_shared<buffer_manager>(s_fixed_buf_size);
+    bufman->set_latency_target(_buffer_sample_rate, _buffer_max_latency);
+
+    auto blocks = fg->calc_used_blocks();
+
+    // Chains of sync blocks outside of the block groups become groups of their own, with
+    // tiles in place of the buffers between their blocks
+    auto block_groups = _block_groups;
+    _fused_chains.clear();
+    if (_fuse_tile_bytes > 0) {
+        auto candidates = blocks;
+        for (auto& bg : _block_groups) {
+            for (auto& b : bg.blocks()) {
+                candidates.erase(std::remove(candidates.begin(), candidates.end(), b),
+                                 candidates.end());
+            }
+        }
+        _fused_chains = graph_utils::sync_chains(fg, candidates);
+
+        edge_vector_t tile_edges;
+        for (auto& chain : _fused_chains) {
+            tile_edges.insert(tile_edges.end(), chain.edges.begin(), chain.edges.end());
+            auto bgp =
+                block_group_properties(chain.blocks, chain.blocks[0]->alias() + "_fused");
+            bgp.set_fused(true);
+            block_groups.push_back(bgp);
+        }
+        bufman->set_tile_edges(tile_edges, _fuse_tile_bytes);
+    }
+    bufman->set_inplace(_inplace_buffers);
+
     bufman->initialize_buffers(fg, _default_buf_properties, base());
+    _buffer_sizes = bufman->size_report();
 
     //  Partition the flowgraph according to how blocks are specified in groups
     //  By default, one Thread Per Block
 
-    auto blocks = fg->calc_used_blocks();
-
     // look at our block groups, create confs and remove from blocks
-    for (auto& bg : _block_groups) {
+    for (auto& bg : block_groups) {
         std::vector<block_sptr> blocks_for_this_thread;
 
         if (!bg.blocks().empty()) {
-            auto t = thread_wrapper::make(id(), bg, bufman, fgmon);
+            if (!bg.wait_policy_set()) {
+                bg.set_wait_policy(_default_wait_policy, _default_spin_count);
+            }
+            auto t = thread_wrapper::make(id(), bg, bufman, fgmon, on_flushed);
             _threads.push_back(t);
 
+            // Keep the buffers written by a pinned group on the memory of its node
+            if (!bg.processor_affinity().empty()) {
+                auto node = thread::numa_node_of_processor(bg.processor_affinity()[0]);
+                if (node >= 0) {
+                    for (auto& b : bg.blocks()) {
+                        for (auto& p : b->output_stream_ports()) {
+                            if (p->buffer()) {
+                                p->buffer()->set_numa_node(node);
+                            }
+                        }
+                    }
+                }
+            }
+
             std::vector<node_sptr> node_vec;
             for (auto& b : bg.blocks()) {
                 auto it = std::find(blocks.begin(), blocks.end(), b);
@@ -69,7 +125,9 @@ void scheduler_nbt::initialize(flat_graph_sptr fg, runtime_monitor_sptr fgmon)
         std::vector<node_sptr> node_vec;
         node_vec.push_back(b);
 
-        auto t = thread_wrapper::make(id(), block_group_properties({ b }), bufman, fgmon);
+        auto bgp = block_group_properties({ b });
+        bgp.set_wait_policy(_default_wait_policy, _default_spin_count);
+        auto t = thread_wrapper::make(id(), bgp, bufman, fgmon, on_flushed);
         _threads.push_back(t);
 
         b->set_parent_intf(t);
@@ -79,6 +137,18 @@ void scheduler_nbt::initialize(flat_graph_sptr fg, runtime_monitor_sptr fgmon)
 
         _block_thread_map[b->id()] = t;
     }
+
+    _num_unflushed = _threads.size();
+}
+
+void scheduler_nbt::thread_flushed()
+{
+    // The runtime monitor tracks flushing per scheduler, so only report once the last
+    // thread has drained
+    if (--_num_unflushed == 0) {
+        _rtmon->push_message(
+            rt_monitor_message::make(rt_monitor_message_t::FLUSHED, id()));
+    }
 }
 
 void scheduler_nbt::start()
@@ -116,6 +186,15 @@ void scheduler_nbt::kill()
     }
 }
 
+uint64_t scheduler_nbt::notifications_suppressed()
+{
+    uint64_t ret = 0;
+    for (const auto& thd : _threads) {
+        ret += thd->notifications_suppressed();
+    }
+    return ret;
+}
+
 } // namespace schedulers
 } // namespace gr
 
@@ -133,6 +212,54 @@ std::shared_ptr<gr::scheduler> factory(const std::string& options)
     auto buf_size = opt_yaml["buffer_size"].as<size_t>(32768);
     auto name = opt_yaml["name"].as<std::string>("nbt");
 
-    return gr::schedulers::scheduler_nbt::make(name, buf_size);
+    auto sched = gr::schedulers::scheduler_nbt::make(name, buf_size);
+
+    // How idle threads wait for notifications: block, spin, or poll
+    auto wait_policy = opt_yaml["wait_policy"].as<std::string>("block");
+    auto spin_count = opt_yaml["spin_count"].as<unsigned int>(
+        gr::block_group_properties::default_spin_count);
+    if (wait_policy == "block") {
+        sched->set_default_wait_policy(gr::wait_policy_t::BLOCK);
+    }
+    else if (wait_policy == "spin") {
+        sched->set_default_wait_policy(gr::wait_policy_t::SPIN_THEN_BLOCK, spin_count);
+    }
+    else if (wait_policy == "poll") {
+        sched->set_default_wait_policy(gr::wait_policy_t::BUSY_POLL);
+    }
+    else {
+        throw std::invalid_argument("Unknown wait_policy: " + wait_policy);
+    }
+
+    // Run chains of sync blocks back to back on one thread, 0 to disable
+    auto fuse_tile_bytes = opt_yaml["fuse_tile_bytes"].as<size_t>(0);
+    sched->set_fuse_tile_size(fuse_tile_bytes);
+
+    // Write the output of in-place capable blocks over their input
+    auto inplace_buffers = opt_yaml["inplace_buffers"].as<bool>(false);
+    sched->set_inplace_buffers(inplace_buffers);
+
+    // Bound the default buffer size by how much time of data it holds
+    auto sample_rate = opt_yaml["sample_rate"].as<double>(0);
+    auto max_latency = opt_yaml["max_latency"].as<double>(0);
+    sched->set_buffer_latency_target(sample_rate, max_latency);
+
+    // Default buffer type for edges that do not set a custom buffer
+    auto buffer_type = opt_yaml["buffer_type"].as<std::string>("vmcirc");
+    auto hugepages = opt_yaml["hugepages"].as<bool>(false);
+    if (buffer_type == "lockfree") {
+        sched->set_default_buffer_factory(
+            gr::buffer_cpu_lockfree_properties::make()->set_hugepages(hugepages));
+    }
+    else if (buffer_type != "vmcirc") {
+        throw std::invalid_argument("Unknown buffer_type: " + buffer_type);
+    }
+    else if (hugepages) {
+        sched->set_default_buffer_factory(
+            gr::buffer_cpu_vmcirc_properties::make(gr::buffer_cpu_vmcirc_type::AUTO)
+                ->set_hugepages(true));
+    }
+
+    return sched;
 }
 }
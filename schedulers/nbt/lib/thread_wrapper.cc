@@ -1,16 +1,37 @@
 #include "thread_wrapper.h"
 #include <gnuradio/thread.h>
 #include <fmt/core.h>
+#include <algorithm>
 #include <thread>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
 namespace gr {
 namespace schedulers {
 
+namespace {
+// Tell the core we are in a spin loop, so that the sibling hyperthread is not starved
+// and we do not pay for a memory order violation when the queue changes
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+} // namespace
+
 thread_wrapper::thread_wrapper(int id,
                                block_group_properties bgp,
                                buffer_manager::sptr bufman,
-                               runtime_monitor_sptr rtmon)
-    : _id(id), d_block_group(bgp), d_blocks(bgp.blocks())
+                               runtime_monitor_sptr rtmon,
+                               flushed_fcn on_flushed)
+    : _id(id), d_block_group(bgp), d_blocks(bgp.blocks()), d_on_flushed(on_flushed)
 {
     gr::configure_default_loggers(d_logger, d_debug_logger, bgp.name());
 
@@ -21,9 +42,66 @@ thread_wrapper::thread_wrapper(int id,
     d_rtmon = rtmon;
     _exec = std::make_unique<graph_executor>(bgp.name());
     _exec->initialize(bufman, d_blocks);
+    _exec->set_fused(bgp.fused());
     d_thread = std::thread(thread_body, this);
 }
 
+bool thread_wrapper::is_work_notification(const scheduler_message_sptr& msg)
+{
+    if (msg->type() != scheduler_message_t::SCHEDULER_ACTION) {
+        return false;
+    }
+    switch (std::static_pointer_cast<scheduler_action>(msg)->action()) {
+    case scheduler_action_t::NOTIFY_INPUT:
+    case scheduler_action_t::NOTIFY_OUTPUT:
+    case scheduler_action_t::NOTIFY_ALL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void thread_wrapper::push_message(scheduler_message_sptr msg)
+{
+    if (is_work_notification(msg) && d_notify_pending.exchange(true)) {
+        d_notifications_suppressed++;
+        return;
+    }
+    msgq.push(msg);
+}
+
+void thread_wrapper::push_messages(const std::vector<scheduler_message_sptr>& msgs)
+{
+    // Work notifications are coalesced one at a time, anything else goes in as a batch
+    if (std::any_of(msgs.begin(), msgs.end(), is_work_notification)) {
+        neighbor_interface::push_messages(msgs);
+        return;
+    }
+    msgq.push_bulk(msgs.begin(), msgs.size());
+}
+
+bool thread_wrapper::wait_for_message(scheduler_message_sptr& msg)
+{
+    switch (d_block_group.wait_policy()) {
+    case wait_policy_t::BUSY_POLL:
+        // EXIT also comes through the queue, so this cannot spin forever
+        while (!msgq.try_pop(msg)) {
+            cpu_relax();
+        }
+        return true;
+    case wait_policy_t::SPIN_THEN_BLOCK:
+        for (unsigned int i = 0; i < d_block_group.spin_count(); i++) {
+            if (msgq.try_pop(msg)) {
+                return true;
+            }
+            cpu_relax();
+        }
+        return pop_message(msg);
+    default:
+        return pop_message(msg);
+    }
+}
+
 void thread_wrapper::start()
 {
     for (auto& b : d_blocks) {
@@ -66,69 +144,41 @@ void thread_wrapper::kill()
 
 bool thread_wrapper::handle_work_notification()
 {
-    auto s = _exec->run_one_iteration(d_blocks);
+    auto& s = _exec->run_one_iteration();
 
     // Based on state of the run_one_iteration, do things
     // If any of the blocks are done, notify the flowgraph monitor
-    for (auto elem : s) {
-        if (elem.second == executor_iteration_status::DONE) {
-            d_debug_logger->debug("Signalling DONE to RTMON from block {}", elem.first);
-            d_rtmon->push_message(
-                rt_monitor_message::make(rt_monitor_message_t::DONE, id(), elem.first));
-            break; // only notify the fgmon once
+    for (size_t idx = 0; idx < s.size() && !d_done_reported; idx++) {
+        if (s[idx] == executor_iteration_status::DONE) {
+            d_debug_logger->debug("Signalling DONE to RTMON from block {}",
+                                  d_blocks[idx]->id());
+            d_rtmon->push_message(rt_monitor_message::make(
+                rt_monitor_message_t::DONE, id(), d_blocks[idx]->id()));
+            d_done_reported = true; // only notify the fgmon once
         }
     }
 
     bool notify_self_ = false;
     // bool kick = false;
-    bool all_blkd = true;
-    for (auto elem : s) {
-        if (elem.second == executor_iteration_status::READY ||
-            elem.second == executor_iteration_status::BLKD_OUT) {
+    for (size_t idx = 0; idx < s.size(); idx++) {
+        auto status = s[idx];
+        if (status == executor_iteration_status::READY ||
+            status == executor_iteration_status::BLKD_OUT) {
             notify_self_ = true;
         }
-        else if (elem.second == executor_iteration_status::BLKD_IN) {
+        else if (status == executor_iteration_status::BLKD_IN) {
             // kick = true;
         }
-
-        if (elem.second == executor_iteration_status::MSG_ONLY) {
-            //     gr_log_debug(d_debug_logger,
-            //                  "size_approx {}",
-            //                  msgq.size_approx());
-            // if (msgq.size_approx() != 0)
-            // {
-            //     all_blkd = false;
-            // }
-        }
-        else if (elem.second != executor_iteration_status::BLKD_IN &&
-                 elem.second != executor_iteration_status::BLKD_OUT) {
-            // Ignore source blocks
-            if (d_block_id_to_block_map[elem.first]->input_stream_ports().empty()) {
-                all_blkd = false;
-            }
-        }
     }
 
-    if (d_flushing) {
-        if (all_blkd) {
-            if (++d_flush_cnt >= 8) {
-                d_debug_logger->debug(
-                             "All blocks in thread {} blocked, pushing flushed",
-                             id());
-                d_rtmon->push_message(
-                    rt_monitor_message::make(rt_monitor_message_t::FLUSHED, id()));
-                return false;
-            }
-            else {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
-                push_message(std::make_shared<scheduler_action>(
-                    scheduler_action_t::NOTIFY_ALL, 0));
-            }
-        }
-        else {
-            d_flush_cnt = 0;
-            d_debug_logger->debug("Not all blocks reporting BLKD");
+    // End of stream has reached every block in this thread, nothing more will happen
+    if (d_flushing && _exec->all_finished()) {
+        if (!d_flushed_reported) {
+            d_debug_logger->debug("All blocks in thread {} finished", name());
+            d_flushed_reported = true;
+            d_on_flushed();
         }
+        return false;
     }
 
 
@@ -172,10 +222,8 @@ void thread_wrapper::handle_parameter_change(std::shared_ptr<param_change_action
 
     d_debug_logger->debug("handle parameter change {} - {}", item->blkid(), b->alias());
 
-    b->on_parameter_change(item->param_action());
-
-    if (item->cb_fcn() != nullptr)
-        item->cb_fcn()(item->param_action());
+    // Applied right away, or between work calls once the block reaches at_sample
+    _exec->handle_parameter_change(item);
 }
 
 
@@ -221,7 +269,7 @@ void thread_wrapper::thread_body(thread_wrapper* top)
         while (valid && !top->d_thread_stopped) {
             if (blocking_queue) {
                 top->d_debug_logger->debug("Going into blocking queue");
-                valid = top->pop_message(msg);
+                valid = top->wait_for_message(msg);
             }
             else {
                 top->d_debug_logger->debug("Going into nonblocking queue");
@@ -238,6 +286,10 @@ void thread_wrapper::thread_body(thread_wrapper* top)
                     // either from runtime or upstream or downstream or from self
 
                     auto action = std::static_pointer_cast<scheduler_action>(msg);
+                    if (is_work_notification(msg)) {
+                        // Anything that changes from here on needs a new notification
+                        top->d_notify_pending = false;
+                    }
                     switch (action->action()) {
                     case scheduler_action_t::DONE:
                         // rtmon says that we need to be done, wrap it up
@@ -285,8 +337,7 @@ void thread_wrapper::thread_body(thread_wrapper* top)
                 }
                 case scheduler_message_t::MSGPORT_MESSAGE: {
 
-                    auto m = std::static_pointer_cast<msgport_message>(msg);
-                    m->callback()(m->message());
+                    std::static_pointer_cast<msgport_message>(msg)->dispatch();
 
                     break;
                 }
@@ -316,7 +367,8 @@ void thread_wrapper::thread_body(thread_wrapper* top)
         }
     }
 
-    top->d_debug_logger->debug("Exiting Thread");
+    top->d_debug_logger->debug("Exiting Thread, {} notifications suppressed",
+                               top->d_notifications_suppressed);
 }
 
 } // namespace schedulers
@@ -39,14 +39,35 @@ PYBIND11_MODULE(scheduler_nbt_python, m)
     // Allow access to base block methods
     py::module::import("gnuradio.gr");
 
+    py::enum_<gr::wait_policy_t>(m, "wait_policy_t")
+        .value("BLOCK", gr::wait_policy_t::BLOCK)
+        .value("SPIN_THEN_BLOCK", gr::wait_policy_t::SPIN_THEN_BLOCK)
+        .value("BUSY_POLL", gr::wait_policy_t::BUSY_POLL)
+        .export_values();
+
     using nbt = gr::schedulers::scheduler_nbt;
     py::class_<nbt, gr::scheduler, std::shared_ptr<nbt>>(m, "scheduler_nbt")
         .def(py::init(&gr::schedulers::scheduler_nbt::make),
              py::arg("name") = "multi_threaded",
              py::arg("fixed_buf_size") = 32768)
         .def("add_block_group",
-             &gr::schedulers::scheduler_nbt::add_block_group,
+             py::overload_cast<const std::vector<gr::block_sptr>&,
+                               const std::string&,
+                               const std::vector<unsigned int>&>(
+                 &gr::schedulers::scheduler_nbt::add_block_group),
              py::arg("blocks"),
              py::arg("name") = "",
-             py::arg("affinity_mask") = std::vector<unsigned int>{});
+             py::arg("affinity_mask") = std::vector<unsigned int>{})
+        .def("set_default_wait_policy",
+             &gr::schedulers::scheduler_nbt::set_default_wait_policy,
+             py::arg("policy"),
+             py::arg("spin_count") = gr::block_group_properties::default_spin_count)
+        .def("set_fuse_tile_size",
+             &gr::schedulers::scheduler_nbt::set_fuse_tile_size,
+             py::arg("tile_bytes"))
+        .def("set_inplace_buffers",
+             &gr::schedulers::scheduler_nbt::set_inplace_buffers,
+             py::arg("inplace"))
+        .def("notifications_suppressed",
+             &gr::schedulers::scheduler_nbt::notifications_suppressed);
 }
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <gnuradio/block.h>
+#include <gnuradio/concurrent_queue.h>
+#include <gnuradio/neighbor_interface.h>
+#include <gnuradio/runtime_monitor.h>
+#include <gnuradio/scheduler_message.h>
+#include <gnuradio/schedulers/nbt/graph_executor.h>
+
+#include <atomic>
+
+namespace gr {
+namespace schedulers {
+
+class scheduler_ws;
+
+/**
+ * @brief A block wrapped as a schedulable task
+ *
+ * The block_task is the parent interface of a block and its ports in the work-stealing
+ * scheduler.  Notifications from neighboring blocks do not go through a queue, they
+ * only mark the task as having work and put it on one of the worker deques.  A task is
+ * only ever executed by one worker at a time.
+ *
+ */
+class block_task : public neighbor_interface
+{
+public:
+    enum class state : int {
+        IDLE,               // not on any deque
+        SCHEDULED,          // sitting on a worker deque
+        RUNNING,            // being executed by a worker
+        RUNNING_RENOTIFIED, // being executed, and notified again in the meantime
+    };
+
+    using sptr = std::shared_ptr<block_task>;
+    static sptr make(block_sptr blk,
+                     scheduler_ws* sched,
+                     buffer_manager::sptr bufman,
+                     runtime_monitor_sptr rtmon)
+    {
+        return std::make_shared<block_task>(blk, sched, bufman, rtmon);
+    }
+
+    block_task(block_sptr blk,
+               scheduler_ws* sched,
+               buffer_manager::sptr bufman,
+               runtime_monitor_sptr rtmon);
+
+    void push_message(scheduler_message_sptr msg) override;
+    void push_messages(const std::vector<scheduler_message_sptr>& msgs) override;
+
+    /**
+     * @brief Mark the task as having work and put it on a deque if it is not already
+     *
+     * @param work true if the block should be executed, false if only the message
+     * queue needs to be serviced
+     */
+    void notify(bool work = true);
+
+    /**
+     * @brief Execute the task on the calling worker thread
+     *
+     * Services the message queue and runs the block once if it was notified of work.
+     * When the block made progress, or was notified while running, the task is put back
+     * on the deque of the calling worker.
+     */
+    void run();
+
+    block_sptr blk() { return d_block; }
+    bool is_source() { return d_is_source; }
+
+    /**
+     * @brief Number of notifications that found the task already scheduled or already
+     * marked to run again
+     */
+    uint64_t notifications_suppressed() const { return d_notifications_suppressed; }
+
+private:
+    block_sptr d_block;
+    scheduler_ws* d_sched;
+    runtime_monitor_sptr d_rtmon;
+    graph_executor d_exec;
+    bool d_is_source;
+    bool d_done_reported = false;
+
+    std::atomic<state> d_state{ state::IDLE };
+    std::atomic<bool> d_work_pending{ false };
+    std::atomic<uint64_t> d_notifications_suppressed{ 0 };
+    concurrent_queue<scheduler_message_sptr> d_msgq;
+
+    logger_ptr d_logger;
+    logger_ptr d_debug_logger;
+
+    void handle_message(scheduler_message_sptr msg);
+    bool handle_work();
+};
+
+} // namespace schedulers
+} // namespace gr
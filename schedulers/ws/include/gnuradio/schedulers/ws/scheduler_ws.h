@@ -0,0 +1,135 @@
+#pragma once
+
+#include <gnuradio/buffer_cpu_vmcirc.h>
+#include <gnuradio/scheduler.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "block_task.h"
+
+namespace gr {
+namespace schedulers {
+
+/**
+ * @brief Work-stealing multi-threaded scheduler
+ *
+ * Rather than dedicating a thread to every block (or block group), blocks are executed
+ * as tasks on a fixed pool of worker threads.  Each worker owns a deque of tasks that
+ * are ready to run: it pushes and pops at the back of its own deque, and when it runs
+ * dry it steals from the front of the other workers' deques.  Tasks become ready when
+ * a neighboring block reads from or writes to a connected buffer.
+ *
+ */
+class scheduler_ws : public scheduler
+{
+private:
+    struct worker {
+        std::mutex mutex;
+        std::deque<block_task*> tasks;
+        std::thread thread;
+    };
+
+    const int s_fixed_buf_size;
+    const unsigned int d_num_workers;
+    const bool d_pin_workers;
+
+    std::vector<std::unique_ptr<worker>> d_workers;
+    std::vector<block_task::sptr> d_tasks;
+    std::map<nodeid_t, block_task::sptr> d_block_task_map;
+    runtime_monitor_sptr d_rtmon;
+
+    bool d_started = false;
+    std::atomic<bool> d_stopped{ false };
+    bool d_blocks_stopped = false;
+    std::atomic<unsigned int> d_next_worker{ 0 };
+
+    // idle workers sleep until a task is queued
+    std::mutex d_sleep_mutex;
+    std::condition_variable d_sleep_cv;
+    std::atomic<size_t> d_num_queued{ 0 };
+    std::atomic<size_t> d_num_sleeping{ 0 };
+
+    // number of tasks that are either queued or running
+    std::atomic<size_t> d_num_active{ 0 };
+    std::atomic<bool> d_flushing{ false };
+    std::atomic<bool> d_flushed_reported{ false };
+
+    void worker_body(unsigned int idx);
+    block_task* pop_task(unsigned int idx);
+    void start_flushing();
+    void stop_workers();
+
+public:
+    using sptr = std::shared_ptr<scheduler_ws>;
+    static sptr make(const std::string name = "ws",
+                     const unsigned int num_workers = 0,
+                     const unsigned int fixed_buf_size = 32768,
+                     const bool pin_workers = false)
+    {
+        return std::make_shared<scheduler_ws>(
+            name, num_workers, fixed_buf_size, pin_workers);
+    }
+
+    /**
+     * @brief Construct a new work-stealing scheduler
+     *
+     * @param name
+     * @param num_workers number of worker threads, 0 to use one per hardware thread
+     * @param fixed_buf_size default buffer size in bytes
+     * @param pin_workers pin worker N to core N
+     */
+    scheduler_ws(const std::string name = "ws",
+                 const unsigned int num_workers = 0,
+                 const unsigned int fixed_buf_size = 32768,
+                 const bool pin_workers = false);
+    ~scheduler_ws() override;
+
+    void push_message(scheduler_message_sptr msg) override;
+
+    /**
+     * @brief Initialize the work-stealing scheduler
+     *
+     * Creates the buffers and a task for each block in the flowgraph
+     *
+     * @param fg subgraph assigned to this scheduler
+     * @param fgmon sptr to flowgraph monitor object
+     */
+    void initialize(flat_graph_sptr fg, runtime_monitor_sptr fgmon) override;
+    void start() override;
+    void stop() override;
+    void wait() override;
+    void kill() override;
+
+    unsigned int num_workers() { return d_num_workers; }
+
+    /**
+     * @brief Total number of notifications that were coalesced into one already pending
+     * on the notified task
+     */
+    uint64_t notifications_suppressed();
+
+    /**
+     * @brief Put a ready task on a worker deque
+     *
+     * Called from block_task; the task is pushed on the calling worker's own deque when
+     * called from a worker thread, otherwise the workers are picked round robin
+     *
+     * @param task
+     * @param newly_active true if the task was idle before being queued
+     */
+    void enqueue(block_task* task, bool newly_active);
+
+    /**
+     * @brief Called by a task when it has gone back to idle
+     *
+     */
+    void task_idle();
+
+    bool flushing() { return d_flushing; }
+};
+} // namespace schedulers
+} // namespace gr
@@ -0,0 +1,165 @@
+#include "block_task.h"
+#include "scheduler_ws.h"
+
+namespace gr {
+namespace schedulers {
+
+block_task::block_task(block_sptr blk,
+                       scheduler_ws* sched,
+                       buffer_manager::sptr bufman,
+                       runtime_monitor_sptr rtmon)
+    : d_block(blk),
+      d_sched(sched),
+      d_rtmon(rtmon),
+      d_exec(blk->alias()),
+      d_is_source(blk->input_stream_ports().empty())
+{
+    gr::configure_default_loggers(d_logger, d_debug_logger, "ws_" + blk->alias());
+    d_exec.initialize(bufman, { blk });
+}
+
+void block_task::push_message(scheduler_message_sptr msg)
+{
+    // Notifications from neighbors carry no state, so there is nothing to queue
+    if (msg->type() == scheduler_message_t::SCHEDULER_ACTION) {
+        notify(true);
+        return;
+    }
+
+    d_msgq.push(msg);
+    notify(false);
+}
+
+void block_task::push_messages(const std::vector<scheduler_message_sptr>& msgs)
+{
+    if (msgs.empty()) {
+        return;
+    }
+    bool work = false;
+    for (auto& msg : msgs) {
+        if (msg->type() == scheduler_message_t::SCHEDULER_ACTION) {
+            work = true;
+        }
+        else {
+            d_msgq.push(msg);
+        }
+    }
+    notify(work);
+}
+
+void block_task::notify(bool work)
+{
+    // The flag must be visible before the state is inspected so that a worker that is
+    // currently running the task either sees it, or gets told to run again
+    if (work) {
+        d_work_pending = true;
+    }
+
+    auto s = d_state.load();
+    while (true) {
+        switch (s) {
+        case state::IDLE:
+            if (d_state.compare_exchange_weak(s, state::SCHEDULED)) {
+                d_sched->enqueue(this, true);
+                return;
+            }
+            break;
+        case state::RUNNING:
+            if (d_state.compare_exchange_weak(s, state::RUNNING_RENOTIFIED)) {
+                return;
+            }
+            break;
+        default:
+            // Already on a deque, or already marked to run again
+            d_notifications_suppressed++;
+            return;
+        }
+    }
+}
+
+void block_task::run()
+{
+    d_state = state::RUNNING;
+
+    scheduler_message_sptr msg;
+    while (d_msgq.try_pop(msg)) {
+        handle_message(msg);
+    }
+
+    bool reschedule = false;
+    if (d_work_pending.exchange(false)) {
+        reschedule = handle_work();
+    }
+
+    if (reschedule) {
+        // The block made progress, there may be more to do
+        d_work_pending = true;
+        d_state = state::SCHEDULED;
+        d_sched->enqueue(this, false);
+        return;
+    }
+
+    auto expected = state::RUNNING;
+    if (d_state.compare_exchange_strong(expected, state::IDLE)) {
+        d_sched->task_idle();
+    }
+    else {
+        // Notified while running
+        d_state = state::SCHEDULED;
+        d_sched->enqueue(this, false);
+    }
+}
+
+bool block_task::handle_work()
+{
+    // While flushing, sources stop producing and only the data in flight is drained
+    if (d_is_source && d_sched->flushing()) {
+        return false;
+    }
+
+    auto status = d_exec.run_one_iteration()[0];
+    d_debug_logger->debug("{} returned {}", d_block->alias(), status);
+
+    switch (status) {
+    case executor_iteration_status::DONE:
+        if (!d_done_reported) {
+            d_done_reported = true;
+            d_debug_logger->debug("Signalling DONE to RTMON from block {}",
+                                  d_block->id());
+            d_rtmon->push_message(rt_monitor_message::make(
+                rt_monitor_message_t::DONE, d_sched->id(), d_block->id()));
+        }
+        return false;
+    case executor_iteration_status::READY:
+        return true;
+    default:
+        // Blocked tasks are woken up by their neighbors
+        return false;
+    }
+}
+
+void block_task::handle_message(scheduler_message_sptr msg)
+{
+    switch (msg->type()) {
+    case scheduler_message_t::MSGPORT_MESSAGE: {
+        std::static_pointer_cast<msgport_message>(msg)->dispatch();
+    } break;
+    case scheduler_message_t::PARAMETER_QUERY: {
+        auto item = std::static_pointer_cast<param_query_action>(msg);
+        d_debug_logger->debug("handle parameter query {}", d_block->alias());
+        d_block->on_parameter_query(item->param_action());
+        if (item->cb_fcn() != nullptr)
+            item->cb_fcn()(item->param_action());
+    } break;
+    case scheduler_message_t::PARAMETER_CHANGE: {
+        auto item = std::static_pointer_cast<param_change_action>(msg);
+        d_debug_logger->debug("handle parameter change {}", d_block->alias());
+        d_exec.handle_parameter_change(item);
+    } break;
+    default:
+        break;
+    }
+}
+
+} // namespace schedulers
+} // namespace gr
@@ -0,0 +1,330 @@
+#include <gnuradio/schedulers/ws/scheduler_ws.h>
+#include <gnuradio/buffer_cpu_lockfree.h>
+#include <gnuradio/thread.h>
+#include <fmt/core.h>
+#include <yaml-cpp/yaml.h>
+
+namespace gr {
+namespace schedulers {
+
+namespace {
+// Identifies the worker running on the current thread, so that tasks that become ready
+// while a worker is executing are pushed onto that worker's own deque
+thread_local scheduler_ws* t_sched = nullptr;
+thread_local unsigned int t_worker_idx = 0;
+} // namespace
+
+scheduler_ws::scheduler_ws(const std::string name,
+                           const unsigned int num_workers,
+                           const unsigned int fixed_buf_size,
+                           const bool pin_workers)
+    : scheduler(name),
+      s_fixed_buf_size(fixed_buf_size),
+      d_num_workers(num_workers > 0 ? num_workers
+                                    : std::max(1u, std::thread::hardware_concurrency())),
+      d_pin_workers(pin_workers)
+{
+    _default_buf_properties =
+        buffer_cpu_vmcirc_properties::make(buffer_cpu_vmcirc_type::AUTO);
+
+    for (unsigned int i = 0; i < d_num_workers; i++) {
+        d_workers.push_back(std::make_unique<worker>());
+    }
+}
+
+scheduler_ws::~scheduler_ws()
+{
+    stop_workers();
+    for (auto& w : d_workers) {
+        if (w->thread.joinable()) {
+            w->thread.join();
+        }
+    }
+}
+
+void scheduler_ws::push_message(scheduler_message_sptr msg)
+{
+    // Use 0 for blkid all tasks
+    if (msg->blkid() == 0) {
+        if (msg->type() == scheduler_message_t::SCHEDULER_ACTION) {
+            auto action = std::static_pointer_cast<scheduler_action>(msg);
+            switch (action->action()) {
+            case scheduler_action_t::DONE:
+                // rtmon says that we need to be done, drain what is in flight
+                d_debug_logger->debug("rtmon signaled DONE, start flushing");
+                start_flushing();
+                return;
+            case scheduler_action_t::EXIT:
+                d_debug_logger->debug("rtmon signaled EXIT, stopping workers");
+                stop_workers();
+                return;
+            default:
+                break;
+            }
+        }
+        for (auto& t : d_tasks) {
+            t->push_message(msg);
+        }
+    }
+    else {
+        d_block_task_map[msg->blkid()]->push_message(msg);
+    }
+}
+
+void scheduler_ws::initialize(flat_graph_sptr fg, runtime_monitor_sptr fgmon)
+{
+    d_rtmon = fgmon;
+
+    auto bufman = std::make_shared<buffer_manager>(s_fixed_buf_size);
+    bufman->set_latency_target(_buffer_sample_rate, _buffer_max_latency);
+    bufman->initialize_buffers(fg, _default_buf_properties, base());
+    _buffer_sizes = bufman->size_report();
+
+    // One task per block, all sharing the same pool of workers
+    for (auto& b : fg->calc_used_blocks()) {
+        auto t = block_task::make(b, this, bufman, fgmon);
+
+        b->set_parent_intf(t);
+        for (auto& p : b->all_ports()) {
+            p->set_parent_intf(t); // give a shared pointer to the task
+        }
+
+        d_tasks.push_back(t);
+        d_block_task_map[b->id()] = t;
+    }
+
+    // Workers are created here so that wait() can join them regardless of when the
+    // runtime monitor gets around to calling start()
+    for (unsigned int i = 0; i < d_num_workers; i++) {
+        d_workers[i]->thread = std::thread(&scheduler_ws::worker_body, this, i);
+    }
+}
+
+void scheduler_ws::start()
+{
+    for (auto& t : d_tasks) {
+        t->blk()->start();
+    }
+    {
+        std::lock_guard<std::mutex> lk(d_sleep_mutex);
+        d_started = true;
+    }
+    d_sleep_cv.notify_all();
+
+    for (auto& t : d_tasks) {
+        t->notify();
+    }
+}
+
+void scheduler_ws::stop()
+{
+    stop_workers();
+    for (auto& w : d_workers) {
+        if (w->thread.joinable()) {
+            w->thread.join();
+        }
+    }
+    if (!d_blocks_stopped) {
+        for (auto& t : d_tasks) {
+            t->blk()->stop();
+        }
+        d_blocks_stopped = true;
+    }
+}
+
+void scheduler_ws::wait()
+{
+    for (auto& w : d_workers) {
+        if (w->thread.joinable()) {
+            w->thread.join();
+        }
+    }
+    if (!d_blocks_stopped) {
+        for (auto& t : d_tasks) {
+            t->blk()->stop();
+        }
+        d_blocks_stopped = true;
+    }
+    for (auto& t : d_tasks) {
+        t->blk()->done();
+    }
+}
+
+void scheduler_ws::kill() { stop_workers(); }
+
+uint64_t scheduler_ws::notifications_suppressed()
+{
+    uint64_t ret = 0;
+    for (const auto& t : d_tasks) {
+        ret += t->notifications_suppressed();
+    }
+    return ret;
+}
+
+void scheduler_ws::stop_workers()
+{
+    {
+        std::lock_guard<std::mutex> lk(d_sleep_mutex);
+        d_stopped = true;
+    }
+    d_sleep_cv.notify_all();
+}
+
+void scheduler_ws::enqueue(block_task* task, bool newly_active)
+{
+    if (newly_active) {
+        d_num_active++;
+    }
+
+    unsigned int idx;
+    if (t_sched == this) {
+        idx = t_worker_idx;
+    }
+    else {
+        idx = d_next_worker++ % d_num_workers;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(d_workers[idx]->mutex);
+        d_workers[idx]->tasks.push_back(task);
+    }
+    d_num_queued++;
+
+    if (d_num_sleeping > 0) {
+        std::lock_guard<std::mutex> lk(d_sleep_mutex);
+        d_sleep_cv.notify_one();
+    }
+}
+
+block_task* scheduler_ws::pop_task(unsigned int idx)
+{
+    // The most recently queued task on our own deque is the most likely to still have
+    // its data in cache
+    {
+        auto& w = *d_workers[idx];
+        std::lock_guard<std::mutex> lk(w.mutex);
+        if (!w.tasks.empty()) {
+            auto task = w.tasks.back();
+            w.tasks.pop_back();
+            d_num_queued--;
+            return task;
+        }
+    }
+
+    // Otherwise steal the oldest task from another worker
+    for (unsigned int i = 1; i < d_num_workers; i++) {
+        auto& victim = *d_workers[(idx + i) % d_num_workers];
+        std::lock_guard<std::mutex> lk(victim.mutex);
+        if (!victim.tasks.empty()) {
+            auto task = victim.tasks.front();
+            victim.tasks.pop_front();
+            d_num_queued--;
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+void scheduler_ws::worker_body(unsigned int idx)
+{
+    t_sched = this;
+    t_worker_idx = idx;
+
+    thread::set_thread_name(thread::get_current_thread_id(),
+                            fmt::format("{}_w{}", name(), idx));
+
+    if (d_pin_workers) {
+        thread::thread_bind_to_processor(idx % std::thread::hardware_concurrency());
+    }
+
+    // Wait here until the scheduler starts
+    {
+        std::unique_lock<std::mutex> lk(d_sleep_mutex);
+        d_sleep_cv.wait(lk, [this] { return d_started || d_stopped; });
+    }
+
+    while (!d_stopped) {
+        auto task = pop_task(idx);
+        if (task) {
+            task->run();
+            continue;
+        }
+
+        d_num_sleeping++;
+        {
+            std::unique_lock<std::mutex> lk(d_sleep_mutex);
+            d_sleep_cv.wait(lk, [this] { return d_num_queued > 0 || d_stopped; });
+        }
+        d_num_sleeping--;
+    }
+
+    d_debug_logger->debug("Exiting worker {}", idx);
+}
+
+void scheduler_ws::task_idle()
+{
+    if (--d_num_active == 0 && d_flushing) {
+        // Nothing is queued or running, so no block can make any more progress
+        if (!d_flushed_reported.exchange(true)) {
+            d_debug_logger->debug("All tasks idle, pushing flushed");
+            d_rtmon->push_message(
+                rt_monitor_message::make(rt_monitor_message_t::FLUSHED, id()));
+        }
+    }
+}
+
+void scheduler_ws::start_flushing()
+{
+    // Hold a reference so the count cannot reach zero before every task was notified
+    d_num_active++;
+    d_flushing = true;
+    for (auto& t : d_tasks) {
+        t->notify();
+    }
+    task_idle();
+}
+
+} // namespace schedulers
+} // namespace gr
+
+
+// External plugin interface for instantiating out of tree schedulers
+// TODO: name, version, other info methods
+extern "C" {
+std::shared_ptr<gr::scheduler> factory(const std::string& options)
+{
+    auto opt_yaml = YAML::Load(options);
+
+    auto buf_size = opt_yaml["buffer_size"].as<size_t>(32768);
+    auto name = opt_yaml["name"].as<std::string>("ws");
+    auto num_workers = opt_yaml["num_workers"].as<unsigned int>(0);
+    auto pin_workers = opt_yaml["pin_workers"].as<bool>(false);
+
+    auto sched =
+        gr::schedulers::scheduler_ws::make(name, num_workers, buf_size, pin_workers);
+
+    // Bound the default buffer size by how much time of data it holds
+    auto sample_rate = opt_yaml["sample_rate"].as<double>(0);
+    auto max_latency = opt_yaml["max_latency"].as<double>(0);
+    sched->set_buffer_latency_target(sample_rate, max_latency);
+
+    // Default buffer type for edges that do not set a custom buffer
+    auto buffer_type = opt_yaml["buffer_type"].as<std::string>("vmcirc");
+    auto hugepages = opt_yaml["hugepages"].as<bool>(false);
+    if (buffer_type == "lockfree") {
+        sched->set_default_buffer_factory(
+            gr::buffer_cpu_lockfree_properties::make()->set_hugepages(hugepages));
+    }
+    else if (buffer_type != "vmcirc") {
+        throw std::invalid_argument("Unknown buffer_type: " + buffer_type);
+    }
+    else if (hugepages) {
+        sched->set_default_buffer_factory(
+            gr::buffer_cpu_vmcirc_properties::make(gr::buffer_cpu_vmcirc_type::AUTO)
+                ->set_hugepages(true));
+    }
+
+    return sched;
+}
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <gnuradio/types.h>
+#include <numpy/arrayobject.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/schedulers/ws/scheduler_ws.h>
+
+// We need this hack because import_array() returns NULL
+// for newer Python versions.
+// This function is also necessary because it ensures access to the C API
+// and removes a warning.
+void* init_numpy()
+{
+    import_array();
+    return NULL;
+}
+
+PYBIND11_MODULE(scheduler_ws_python, m)
+{
+    // Initialize the numpy C API
+    // (otherwise we will see segmentation faults)
+    init_numpy();
+
+    // Allow access to base block methods
+    py::module::import("gnuradio.gr");
+
+    using ws = gr::schedulers::scheduler_ws;
+    py::class_<ws, gr::scheduler, std::shared_ptr<ws>>(m, "scheduler_ws")
+        .def(py::init(&gr::schedulers::scheduler_ws::make),
+             py::arg("name") = "ws",
+             py::arg("num_workers") = 0,
+             py::arg("fixed_buf_size") = 32768,
+             py::arg("pin_workers") = false)
+        .def("num_workers", &gr::schedulers::scheduler_ws::num_workers)
+        .def("notifications_suppressed",
+             &gr::schedulers::scheduler_ws::notifications_suppressed);
+}
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/null_source.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/buffer_cpu_vmcirc.h>
+#include <gnuradio/buffer_management.h>
+#include <gnuradio/flat_graph.h>
+#include <gnuradio/flowgraph.h>
+#include <gnuradio/math/multiply_const.h>
+#include <gnuradio/schedulers/nbt/graph_executor.h>
+#include <gnuradio/streamops/copy.h>
+#include <gnuradio/streamops/keep_m_in_n.h>
+
+using namespace gr;
+
+// Count the heap allocations made by the thread running the executor
+static thread_local bool s_count_allocs = false;
+static std::atomic<size_t> s_num_allocs{ 0 };
+
+void* operator new(std::size_t size)
+{
+    if (s_count_allocs) {
+        s_num_allocs++;
+    }
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+// Swallows the notifications that the executor sends to neighboring ports
+struct null_neighbor : public neighbor_interface {
+    size_t num_messages = 0;
+    void push_message(scheduler_message_sptr msg) override { num_messages++; }
+};
+} // namespace
+
+TEST(GraphExecutor, SteadyStateIsAllocationFree)
+{
+    size_t itemsize = sizeof(gr_complex);
+    auto src = blocks::null_source::make({ 1, itemsize });
+    auto cp1 = streamops::copy::make({ itemsize });
+    auto cp2 = streamops::copy::make({ itemsize });
+    auto snk = blocks::null_sink::make({ 1, itemsize });
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, cp1, 0);
+    fg->connect(cp1, 0, cp2, 0);
+    fg->connect(cp2, 0, snk, 0);
+
+    auto ffg = flat_graph::make_flat(fg);
+    auto bufman = std::make_shared<buffer_manager>(32768);
+    bufman->initialize_buffers(ffg, BUFFER_CPU_VMCIRC_ARGS);
+
+    auto neighbor = std::make_shared<null_neighbor>();
+    std::vector<block_sptr> blks{ src, cp1, cp2, snk };
+    for (auto& b : blks) {
+        for (auto& p : b->all_ports()) {
+            p->set_parent_intf(neighbor);
+        }
+    }
+
+    schedulers::graph_executor exec("qa_graph_executor");
+    exec.initialize(bufman, blks);
+
+    // The first iterations build the execution plan
+    for (int i = 0; i < 10; i++) {
+        exec.run_one_iteration();
+    }
+
+    s_num_allocs = 0;
+    s_count_allocs = true;
+    for (int i = 0; i < 1000; i++) {
+        exec.run_one_iteration();
+    }
+    s_count_allocs = false;
+
+    EXPECT_EQ(s_num_allocs, 0);
+    EXPECT_EQ(exec.run_one_iteration().size(), blks.size());
+    EXPECT_GT(neighbor->num_messages, 0);
+    EXPECT_GT(snk->input_stream_ports()[0]->buffer_reader()->total_read(), 0);
+}
+
+TEST(GraphExecutor, EndOfStreamPropagates)
+{
+    std::vector<float> input_data(10000);
+    for (size_t i = 0; i < input_data.size(); i++) {
+        input_data[i] = i;
+    }
+    auto src = blocks::vector_source_f::make_cpu({ input_data, false });
+    auto cp = streamops::copy::make({ sizeof(float) });
+    auto snk = blocks::vector_sink_f::make({});
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, cp, 0);
+    fg->connect(cp, 0, snk, 0);
+
+    auto ffg = flat_graph::make_flat(fg);
+    auto bufman = std::make_shared<buffer_manager>(4096);
+    bufman->initialize_buffers(ffg, BUFFER_CPU_VMCIRC_ARGS);
+
+    auto neighbor = std::make_shared<null_neighbor>();
+    std::vector<block_sptr> blks{ src, cp, snk };
+    for (auto& b : blks) {
+        for (auto& p : b->all_ports()) {
+            p->set_parent_intf(neighbor);
+        }
+    }
+
+    schedulers::graph_executor exec("qa_graph_executor");
+    exec.initialize(bufman, blks);
+
+    // No flushing needed, the end of the source data finishes every block
+    int iterations = 0;
+    while (!exec.all_finished() && iterations < 10000) {
+        exec.run_one_iteration();
+        iterations++;
+    }
+
+    EXPECT_TRUE(exec.all_finished());
+    EXPECT_EQ(snk->data(), input_data);
+    EXPECT_TRUE(src->output_stream_ports()[0]->buffer()->eos());
+}
+
+TEST(GraphExecutor, ParameterChangeAtSample)
+{
+    std::vector<float> input_data(10000, 1.0);
+    auto src = blocks::vector_source_f::make_cpu({ input_data, false });
+    auto mult = math::multiply_const_ff::make({ 1.0 });
+    auto snk = blocks::vector_sink_f::make({});
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, mult, 0);
+    fg->connect(mult, 0, snk, 0);
+
+    auto ffg = flat_graph::make_flat(fg);
+    auto bufman = std::make_shared<buffer_manager>(32768);
+    bufman->initialize_buffers(ffg, BUFFER_CPU_VMCIRC_ARGS);
+
+    auto neighbor = std::make_shared<null_neighbor>();
+    std::vector<block_sptr> blks{ src, mult, snk };
+    for (auto& b : blks) {
+        for (auto& p : b->all_ports()) {
+            p->set_parent_intf(neighbor);
+        }
+    }
+
+    schedulers::graph_executor exec("qa_graph_executor");
+    exec.initialize(bufman, blks);
+
+    // Both changes are queued, and land exactly on their sample even though each
+    // work call could process far more items
+    size_t change1 = 1234, change2 = 4321;
+    int ncallbacks = 0;
+    auto cb = [&ncallbacks](param_action_sptr) { ncallbacks++; };
+    exec.handle_parameter_change(std::make_shared<param_change_action>(
+        mult->id(),
+        param_action::make(mult->get_param_id("k"), pmtf::pmt(3.0f), change2),
+        cb));
+    exec.handle_parameter_change(std::make_shared<param_change_action>(
+        mult->id(),
+        param_action::make(mult->get_param_id("k"), pmtf::pmt(2.0f), change1),
+        cb));
+
+    int iterations = 0;
+    while (!exec.all_finished() && iterations < 10000) {
+        exec.run_one_iteration();
+        iterations++;
+    }
+
+    auto data = snk->data();
+    ASSERT_EQ(data.size(), input_data.size());
+    EXPECT_EQ(ncallbacks, 2);
+    for (size_t i = 0; i < data.size(); i++) {
+        float expected = i < change1 ? 1.0 : (i < change2 ? 2.0 : 3.0);
+        EXPECT_EQ(data[i], expected) << "at sample " << i;
+        if (data[i] != expected) {
+            break;
+        }
+    }
+}
+
+TEST(GraphExecutor, ParameterChangeOutputMultiple)
+{
+    std::vector<float> input_data(10000);
+    for (size_t i = 0; i < input_data.size(); i++) {
+        input_data[i] = i;
+    }
+    // Works on whole blocks of 8 input items
+    auto src = blocks::vector_source_f::make_cpu({ input_data, false });
+    auto keep = streamops::keep_m_in_n::make({ 4, 8, 0, sizeof(float) });
+    auto snk = blocks::vector_sink_f::make({});
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, keep, 0);
+    fg->connect(keep, 0, snk, 0);
+
+    auto ffg = flat_graph::make_flat(fg);
+    auto bufman = std::make_shared<buffer_manager>(32768);
+    bufman->initialize_buffers(ffg, BUFFER_CPU_VMCIRC_ARGS);
+
+    auto neighbor = std::make_shared<null_neighbor>();
+    std::vector<block_sptr> blks{ src, keep, snk };
+    for (auto& b : blks) {
+        for (auto& p : b->all_ports()) {
+            p->set_parent_intf(neighbor);
+        }
+    }
+
+    schedulers::graph_executor exec("qa_graph_executor");
+    exec.initialize(bufman, blks);
+
+    // Not on a block boundary, so the change is applied at the boundary before it
+    size_t change = 1001, applied_at = 1000;
+    bool called = false;
+    exec.handle_parameter_change(std::make_shared<param_change_action>(
+        keep->id(),
+        param_action::make(keep->get_param_id("offset"), pmtf::pmt(size_t(4)), change),
+        [&called](param_action_sptr) { called = true; }));
+
+    int iterations = 0;
+    while (!exec.all_finished() && iterations < 10000) {
+        exec.run_one_iteration();
+        iterations++;
+    }
+    ASSERT_TRUE(exec.all_finished());
+    EXPECT_TRUE(called);
+
+    auto data = snk->data();
+    ASSERT_EQ(data.size(), input_data.size() / 2);
+    for (size_t i = 0; i < data.size(); i++) {
+        size_t blk = i / 4;
+        size_t offset = blk * 8 < applied_at ? 0 : 4;
+        float expected = blk * 8 + offset + i % 4;
+        EXPECT_EQ(data[i], expected) << "at output " << i;
+        if (data[i] != expected) {
+            break;
+        }
+    }
+}
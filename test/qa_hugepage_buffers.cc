@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include <gnuradio/buffer_cpu_lockfree.h>
+#include <gnuradio/buffer_cpu_vmcirc.h>
+
+using namespace gr;
+
+namespace {
+
+// Huge pages reserved on the system and not in use, see /proc/sys/vm/nr_hugepages
+size_t free_hugepages()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    size_t value;
+    while (meminfo >> key) {
+        if (key == "HugePages_Free:" && meminfo >> value) {
+            return value;
+        }
+        meminfo.ignore(256, '\n');
+    }
+    return 0;
+}
+
+// Whether or not the system has huge pages reserved, the buffer has to come up and
+// wrap around correctly
+void check_wraparound(buffer_sptr buf)
+{
+    auto rdr = buf->add_reader(nullptr, sizeof(uint32_t));
+    EXPECT_GE(buf->num_items(), 1024u);
+
+    uint32_t next = 0, expected = 0;
+    size_t n_errors = 0;
+    while (expected < 4 * buf->num_items()) {
+        buffer_info_t wi;
+        buf->write_info(wi);
+        auto wptr = (uint32_t*)wi.ptr;
+        for (int i = 0; i < wi.n_items; i++) {
+            wptr[i] = next++;
+        }
+        buf->post_write(wi.n_items);
+
+        buffer_info_t ri;
+        rdr->read_info(ri);
+        auto rptr = (const uint32_t*)ri.ptr;
+        for (int i = 0; i < ri.n_items; i++) {
+            if (rptr[i] != expected++) {
+                n_errors++;
+            }
+        }
+        rdr->post_read(ri.n_items);
+    }
+    EXPECT_EQ(n_errors, 0u);
+}
+
+} // namespace
+
+TEST(HugepageBuffers, Lockfree)
+{
+    bool available = free_hugepages() > 0;
+    auto props = buffer_cpu_lockfree_properties::make()->set_hugepages(true);
+    auto buf = buffer_cpu_lockfree::make(1024, sizeof(uint32_t), props);
+    check_wraparound(buf);
+
+    if (!available) {
+        GTEST_SKIP() << "no huge pages reserved";
+    }
+    EXPECT_TRUE(buf->hugepages());
+}
+
+TEST(HugepageBuffers, VmcircSysv)
+{
+    bool available = free_hugepages() > 0;
+    auto props = BUFFER_CPU_VMCIRC_SYSV_SHM_ARGS->set_hugepages(true);
+    auto buf = props->factory()(1024, sizeof(uint32_t), props);
+    check_wraparound(buf);
+
+    if (!available) {
+        GTEST_SKIP() << "no huge pages reserved";
+    }
+    EXPECT_TRUE(buf->hugepages());
+}
+
+TEST(HugepageBuffers, NotRequested)
+{
+    auto buf =
+        buffer_cpu_lockfree::make(1024, sizeof(uint32_t), BUFFER_CPU_LOCKFREE_ARGS);
+    EXPECT_FALSE(buf->hugepages());
+
+    auto props = BUFFER_CPU_VMCIRC_ARGS;
+    EXPECT_FALSE(props->factory()(1024, sizeof(uint32_t), props)->hugepages());
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/buffer_cpu_lockfree.h>
+#include <gnuradio/flowgraph.h>
+#include <gnuradio/math/multiply_const.h>
+#include <gnuradio/runtime.h>
+#include <gnuradio/schedulers/nbt/scheduler_nbt.h>
+
+using namespace gr;
+
+// One writer thread and several reader threads hammering the same buffer
+TEST(LockfreeBuffers, SPMCDirect)
+{
+    size_t nitems = 2000000;
+    int nreaders = 3;
+    auto buf =
+        buffer_cpu_lockfree::make(8192, sizeof(uint32_t), BUFFER_CPU_LOCKFREE_ARGS);
+
+    std::vector<buffer_reader_sptr> rdrs;
+    for (int i = 0; i < nreaders; i++) {
+        rdrs.push_back(buf->add_reader(nullptr, sizeof(uint32_t)));
+    }
+
+    std::thread writer([&]() {
+        uint32_t next = 0;
+        while (next < nitems) {
+            buffer_info_t wi;
+            buf->write_info(wi);
+            int n = std::min((size_t)wi.n_items, nitems - next);
+            auto ptr = (uint32_t*)wi.ptr;
+            for (int i = 0; i < n; i++) {
+                ptr[i] = next++;
+            }
+            buf->post_write(n);
+        }
+    });
+
+    std::vector<size_t> n_errors(nreaders, 0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < nreaders; r++) {
+        readers.emplace_back([&, r]() {
+            uint32_t expected = 0;
+            while (expected < nitems) {
+                buffer_info_t ri;
+                rdrs[r]->read_info(ri);
+                auto ptr = (const uint32_t*)ri.ptr;
+                for (int i = 0; i < ri.n_items; i++) {
+                    if (ptr[i] != expected++) {
+                        n_errors[r]++;
+                    }
+                }
+                rdrs[r]->post_read(ri.n_items);
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    for (int r = 0; r < nreaders; r++) {
+        EXPECT_EQ(n_errors[r], 0);
+        EXPECT_EQ(rdrs[r]->total_read(), nitems);
+    }
+    EXPECT_EQ(buf->total_written(), nitems);
+}
+
+TEST(LockfreeBuffers, CustomBuffer)
+{
+    int nsamples = 1000000;
+    std::vector<gr_complex> input_data(nsamples);
+    std::vector<gr_complex> expected_data(nsamples);
+
+    float k = 1.0;
+    for (int i = 0; i < nsamples; i++) {
+        input_data[i] = gr_complex(2 * i, 2 * i + 1);
+        expected_data[i] = gr_complex(k * 2 * i, k * (2 * i + 1));
+    }
+
+    int nblocks = 4;
+    auto src = blocks::vector_source_c::make({ input_data });
+    auto snk = blocks::vector_sink_c::make({});
+    std::vector<math::multiply_const_cc::sptr> mult_blks(nblocks);
+    for (int i = 0; i < nblocks; i++) {
+        mult_blks[i] = math::multiply_const_cc::make_cpu({ k, 1 });
+    }
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, mult_blks[0], 0)->set_custom_buffer(BUFFER_CPU_LOCKFREE_ARGS);
+    for (int i = 1; i < nblocks; i++) {
+        fg->connect(mult_blks[i - 1], 0, mult_blks[i], 0)
+            ->set_custom_buffer(BUFFER_CPU_LOCKFREE_ARGS);
+    }
+    fg->connect(mult_blks[nblocks - 1], 0, snk, 0);
+
+    auto rt = runtime::make();
+    rt->initialize(fg);
+    rt->start();
+    rt->wait();
+
+    EXPECT_EQ(snk->data(), expected_data);
+}
+
+// Multiple readers of a single block with lock-free buffers as the scheduler default
+TEST(LockfreeBuffers, DefaultBufferFanout)
+{
+    int nsamples = 1000000;
+    std::vector<gr_complex> input_data(nsamples);
+    std::vector<gr_complex> expected_data(nsamples);
+
+    float k = 2.0;
+    for (int i = 0; i < nsamples; i++) {
+        input_data[i] = gr_complex(2 * i, 2 * i + 1);
+        expected_data[i] = gr_complex(k * 2 * i, k * (2 * i + 1));
+    }
+
+    int nblocks = 4;
+    auto src = blocks::vector_source_c::make({ input_data });
+    std::vector<math::multiply_const_cc::sptr> mult_blks(nblocks);
+    std::vector<blocks::vector_sink_c::sptr> sink_blks(nblocks);
+
+    auto fg = flowgraph::make();
+    for (int i = 0; i < nblocks; i++) {
+        mult_blks[i] = math::multiply_const_cc::make_cpu({ k, 1 });
+        sink_blks[i] = blocks::vector_sink_c::make({});
+        fg->connect(src, 0, mult_blks[i], 0);
+        fg->connect(mult_blks[i], 0, sink_blks[i], 0);
+    }
+
+    auto sched = schedulers::scheduler_nbt::make();
+    sched->set_default_buffer_factory(BUFFER_CPU_LOCKFREE_ARGS);
+    auto rt = runtime::make();
+    rt->add_scheduler(sched);
+    rt->initialize(fg);
+    rt->start();
+    rt->wait();
+
+    for (int i = 0; i < nblocks; i++) {
+        EXPECT_EQ(sink_blks[i]->data(), expected_data);
+    }
+}
+
+TEST(LockfreeBuffers, FillPolicy)
+{
+    auto space_with = [](std::shared_ptr<buffer_properties> props) {
+        auto buf = buffer_cpu_lockfree::make(8192, sizeof(uint32_t), props);
+        auto rdr = buf->add_reader(nullptr, sizeof(uint32_t));
+        return std::make_pair(buf->space_available(), buf->num_items());
+    };
+
+    // Half filling stays the default
+    auto [half, n] = space_with(BUFFER_CPU_LOCKFREE_ARGS);
+    EXPECT_EQ(half, n / 2);
+
+    auto [full, n_full] =
+        space_with(buffer_cpu_lockfree_properties::make()->set_fill_policy(
+            buffer_fill_policy_t::FULL));
+    EXPECT_EQ(full, n_full);
+
+    auto [quarter, n_quarter] =
+        space_with(buffer_cpu_lockfree_properties::make()->set_fill_policy(
+            buffer_fill_policy_t::FRACTION, 0.25));
+    EXPECT_EQ(quarter, n_quarter / 4);
+
+    // With a reader that keeps up, the adaptive policy offers more than half
+    auto [adaptive, n_adaptive] =
+        space_with(buffer_cpu_lockfree_properties::make()->set_fill_policy(
+            buffer_fill_policy_t::ADAPTIVE));
+    EXPECT_GT(adaptive, n_adaptive / 2);
+
+    EXPECT_THROW(buffer_cpu_lockfree_properties::make()->set_fill_policy(
+                     buffer_fill_policy_t::FRACTION, 1.5),
+                 std::invalid_argument);
+}
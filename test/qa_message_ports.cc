@@ -56,3 +56,39 @@ TEST(SchedulerMTMessagePassing, Forward)
     EXPECT_EQ(cnt, 10);
     rt->stop();
 }
+
+TEST(SchedulerMTMessagePassing, FanoutPostMany)
+{
+    auto blk1 = blocks::msg_forward::make({});
+    auto blk2 = blocks::msg_forward::make({});
+    auto blk3 = blocks::msg_forward::make({});
+
+    // Each destination of blk1 gets its own copy of every message
+    flowgraph_sptr fg(new flowgraph());
+    fg->connect(blk1, "out", blk2, "in");
+    fg->connect(blk1, "out", blk3, "in");
+
+    auto rt = runtime::make();
+    rt->initialize(fg);
+
+    std::vector<pmtf::pmt> msgs;
+    for (int i = 0; i < 10; i++) {
+        msgs.push_back(pmtf::string("message"));
+    }
+    blk1->get_message_port("in")->post_many(msgs);
+
+    rt->start();
+
+    int num_iters = 0;
+    while (blk2->message_count() < 10 || blk3->message_count() < 10) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (++num_iters >= 50) {
+            break;
+        }
+    }
+
+    EXPECT_EQ(blk1->message_count(), 10);
+    EXPECT_EQ(blk2->message_count(), 10);
+    EXPECT_EQ(blk3->message_count(), 10);
+    rt->stop();
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gnuradio/blocks/null_source.h>
+#include <gnuradio/flowgraph.h>
+#include <gnuradio/parameter.h>
+#include <gnuradio/runtime.h>
+#include <gnuradio/streamops/probe_signal.h>
+
+using namespace gr;
+
+namespace {
+
+struct counted {
+    counted() = default;
+    counted(const counted& other) : value(other.value) { copies++; }
+    counted& operator=(const counted& other)
+    {
+        value = other.value;
+        copies++;
+        return *this;
+    }
+
+    int value = 0;
+    static inline size_t copies = 0;
+};
+
+// probe_signal with its generated level snapshot exposed to the test
+class level_reader : public streamops::probe_signal<float>
+{
+public:
+    level_reader() : sync_block("level_reader", "test"), streamops::probe_signal<float>({})
+    {
+    }
+
+    work_return_code_t work(std::vector<block_work_input_sptr>& work_input,
+                            std::vector<block_work_output_sptr>& work_output) override
+    {
+        seen = this->snapshot_level.get();
+        consume_each(work_input[0]->n_items, work_input);
+        return work_return_code_t::WORK_OK;
+    }
+
+    // The way probe_signal_cpu records the last sample it saw
+    void write_level(float level)
+    {
+        *this->param_level = level;
+        this->update_param_snapshot(this->id_level);
+    }
+
+    float snapshot() { return this->snapshot_level.get(); }
+
+    std::atomic<float> seen{ 0.0f };
+};
+
+} // namespace
+
+TEST(ParamSnapshot, CopiesOnlyWhenEpochMoves)
+{
+    param_snapshot<counted> snap;
+    counted v;
+    v.value = 3;
+    snap.set(v);
+
+    counted::copies = 0;
+    EXPECT_EQ(snap.get().value, 3);
+    EXPECT_EQ(counted::copies, 1u);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(snap.get().value, 3);
+    }
+    EXPECT_EQ(counted::copies, 1u);
+
+    v.value = 4;
+    snap.set(v);
+    EXPECT_EQ(counted::copies, 2u);
+    EXPECT_EQ(snap.get().value, 4);
+    EXPECT_EQ(snap.get().value, 4);
+    EXPECT_EQ(counted::copies, 3u);
+}
+
+TEST(ParamSnapshot, SeesSetFromAnotherThread)
+{
+    const int nsets = 100000;
+    param_snapshot<int> snap;
+
+    std::thread writer([&snap] {
+        for (int i = 1; i <= nsets; i++) {
+            snap.set(i);
+        }
+    });
+
+    // Every value read was set at some point, and they never go backwards
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    int last = 0;
+    while (last != nsets && std::chrono::steady_clock::now() < deadline) {
+        auto v = snap.get();
+        ASSERT_GE(v, last);
+        ASSERT_LE(v, nsets);
+        last = v;
+    }
+    writer.join();
+
+    EXPECT_EQ(snap.get(), nsets);
+}
+
+TEST(ParamSnapshot, BlockSeesParameterChange)
+{
+    auto src = blocks::null_source::make({ 1, sizeof(float) });
+    auto blk = std::make_shared<level_reader>();
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, blk, 0);
+
+    auto rt = runtime::make();
+    rt->initialize(fg);
+    rt->start();
+
+    // Changed from this thread, read by work() on the thread running the block
+    blk->request_parameter_change("level", pmtf::pmt(5.0f));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (blk->seen.load() != 5.0f && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    rt->stop();
+
+    EXPECT_EQ(blk->seen.load(), 5.0f);
+}
+
+TEST(ParamSnapshot, ProbeWriteUpdatesSnapshot)
+{
+    level_reader blk;
+    EXPECT_EQ(blk.snapshot(), 0.0f);
+
+    blk.write_level(7.0f);
+    EXPECT_EQ(blk.snapshot(), 7.0f);
+    EXPECT_EQ(blk.level(), 7.0f);
+
+    blk.write_level(-1.5f);
+    EXPECT_EQ(blk.snapshot(), -1.5f);
+    EXPECT_EQ(blk.level(), -1.5f);
+}
@@ -2,6 +2,7 @@
 
 from gnuradio import gr_unittest, gr, blocks, math, streamops
 from time import time, sleep
+import pmtf
 
 class test_basic(gr_unittest.TestCase):
 
@@ -70,5 +71,30 @@ class test_basic(gr_unittest.TestCase):
         # // TODO - check for query
         # // TODO - set changes at specific sample numbers
 
+    def test_async(self):
+        src = blocks.null_source(itemsize=gr.sizeof_float)
+        mult = math.multiply_const_ff(1.0)
+        snk = blocks.null_sink(itemsize=gr.sizeof_float)
+
+        self.tb.connect([src, mult, snk])
+        self.rt.initialize(self.tb)
+        self.rt.start()
+
+        changes = [mult.request_parameter_change_async('k', pmtf.pmt(float(k)))
+                   for k in range(1, 9)]
+        query = mult.request_parameter_query_async('k')
+        batch = mult.request_parameters_query_async(['k', 'vlen'])
+
+        for c in changes:
+            self.assertTrue(c.wait_for(5.0))
+        self.assertTrue(query.wait_for(5.0))
+        self.assertTrue(query.ready())
+        self.assertEqual(query.get().to_base64(),
+                         mult.request_parameter_query('k').to_base64())
+        self.assertEqual(mult.k(), 8.0)
+        self.assertEqual(len(batch.get()), 2)
+
+        self.rt.stop()
+
 if __name__ == "__main__":
     gr_unittest.run(test_basic)
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/null_source.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/flowgraph.h>
+#include <gnuradio/runtime.h>
+#include <gnuradio/schedulers/nbt/scheduler_nbt.h>
+#include <gnuradio/streamops/copy.h>
+
+using namespace gr;
+
+TEST(PerfCounters, ItemsAndBytes)
+{
+    std::vector<float> input_data(100000);
+    std::iota(input_data.begin(), input_data.end(), 0.0f);
+
+    auto src = blocks::vector_source_f::make({ input_data, false });
+    auto cp = streamops::copy::make({ sizeof(float) });
+    auto snk = blocks::vector_sink_f::make({});
+
+    auto fg = flowgraph::make();
+    auto e1 = fg->connect(src, 0, cp, 0);
+    auto e2 = fg->connect(cp, 0, snk, 0);
+
+    auto rt = runtime::make();
+    rt->add_scheduler(schedulers::scheduler_nbt::make("nbt"));
+    rt->initialize(fg);
+    rt->start();
+    rt->wait();
+
+    auto pc = cp->perf_counters().snapshot();
+    EXPECT_GT(pc.work_calls, 0u);
+    EXPECT_EQ(pc.items_in, input_data.size());
+    EXPECT_EQ(pc.items_out, input_data.size());
+    EXPECT_GT(pc.work_time, 0.0);
+    EXPECT_GE(pc.avg_input_fullness, 0.0);
+    EXPECT_LE(pc.avg_input_fullness, 1.0);
+    EXPECT_GE(pc.avg_output_fullness, 0.0);
+    EXPECT_LE(pc.avg_output_fullness, 1.0);
+
+    EXPECT_EQ(src->perf_counters().snapshot().items_out, input_data.size());
+    EXPECT_EQ(snk->perf_counters().snapshot().items_in, input_data.size());
+
+    for (auto& e : { e1, e2 }) {
+        auto epc = e->perf_counters();
+        EXPECT_EQ(epc.bytes, input_data.size() * sizeof(float));
+        auto nsamples = std::accumulate(epc.occupancy.begin(), epc.occupancy.end(), 0ul);
+        EXPECT_GT(nsamples, 0u);
+    }
+}
+
+TEST(PerfCounters, ReadWhileRunning)
+{
+    auto src = blocks::null_source::make({ 1, sizeof(float) });
+    auto cp = streamops::copy::make({ sizeof(float) });
+    auto snk = blocks::null_sink::make({ 1, sizeof(float) });
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, cp, 0);
+    auto e = fg->connect(cp, 0, snk, 0);
+
+    auto rt = runtime::make();
+    rt->add_scheduler(schedulers::scheduler_nbt::make("nbt"));
+    rt->initialize(fg);
+    rt->start();
+
+    // The counters only ever go up while the flowgraph runs
+    uint64_t last_items = 0;
+    uint64_t last_bytes = 0;
+    for (int i = 0; i < 5; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto pc = cp->perf_counters().snapshot();
+        auto epc = e->perf_counters();
+        EXPECT_GE(pc.items_out, last_items);
+        EXPECT_GE(epc.bytes, last_bytes);
+        last_items = pc.items_out;
+        last_bytes = epc.bytes;
+    }
+    EXPECT_GT(last_items, 0u);
+
+    rt->stop();
+}
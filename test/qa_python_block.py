@@ -13,10 +13,11 @@ from gnuradio import gr, gr_unittest, blocks, math
 
 #This test is a pure python block that inherits from sync_block
 class add_2_f32_1_f32(gr.sync_block):
-    def __init__(self, shape=[1]):
+    def __init__(self, shape=[1], min_work_items=0):
         gr.sync_block.__init__(
             self,
-            name="add 2 f32")
+            name="add 2 f32",
+            min_work_items=min_work_items)
 
         self.add_port(gr.port_f("in1", gr.INPUT, shape))
         self.add_port(gr.port_f("in2", gr.INPUT, shape))
@@ -38,8 +39,9 @@ class add_2_f32_1_f32(gr.sync_block):
 # This test extends the existing add_ff block by adding a custom python implementation
 class add_ff_numpy(math.add_ff):
     def __init__(self, shape=[1]):
-        math.add_ff.__init__(self, impl = math.add_ff.available_impl.pyshell)
+        math.add_ff.__init__(self, vlen = shape[0], impl = math.add_ff.available_impl.pyshell)
         self.set_pyblock_detail(gr.pyblock_detail(self))
+        self.f_contiguous = False
 
     def work(self, inputs, outputs):
         noutput_items = outputs[0].n_items
@@ -49,6 +51,9 @@ class add_ff_numpy(math.add_ff):
         inbuf1 = gr.get_input_array(self, inputs, 0)
         inbuf2 = gr.get_input_array(self, inputs, 1)
         outbuf1 = gr.get_output_array(self, outputs, 0)
+        for arr in (inbuf1, inbuf2, outbuf1):
+            if arr.ndim > 1 and arr.shape[0] > 1 and arr.flags['F_CONTIGUOUS']:
+                self.f_contiguous = True
 
         outbuf1[:] = inbuf1 + inbuf2
 
@@ -70,6 +75,19 @@ class test_block_gateway(gr_unittest.TestCase):
         rt.run()
         self.assertEqual(sink.data(), [1, 5, 9, 13, 17])
 
+    def test_add_ff_deriv_vector(self):
+        tb = gr.flowgraph()
+        src0 = blocks.vector_source_f(10*[1, 3, 5, 7, 9], False, 5)
+        src1 = blocks.vector_source_f(10*[0, 2, 4, 6, 8], False, 5)
+        adder = add_ff_numpy(shape=[5])
+        sink = blocks.vector_sink_f(5)
+        tb.connect((src0, 0), (adder, 0))
+        tb.connect((src1, 0), (adder, 1))
+        tb.connect(adder, sink)
+        tb.run()
+        self.assertEqual(sink.data(), 10*[1, 5, 9, 13, 17])
+        self.assertFalse(adder.f_contiguous)
+
     def test_add_f32(self):
         tb = gr.flowgraph()
         rt = gr.runtime()
@@ -96,6 +114,21 @@ class test_block_gateway(gr_unittest.TestCase):
         tb.run()
         self.assertEqual(sink.data(), 10*[1, 5, 9, 13, 17])
 
+    def test_add_f32_min_work_items(self):
+        nitems = 100003
+        min_items = 8192
+        tb = gr.flowgraph()
+        src0 = blocks.vector_source_f(list(range(nitems)), False)
+        src1 = blocks.vector_source_f(nitems*[1], False)
+        adder = add_2_f32_1_f32(min_work_items=min_items)
+        sink = blocks.vector_sink_f()
+        tb.connect((src0, 0), (adder, 0))
+        tb.connect((src1, 0), (adder, 1))
+        tb.connect(adder, sink)
+        tb.run()
+        self.assertEqual(sink.data(), [float(x + 1) for x in range(nitems)])
+        self.assertLessEqual(adder.perf_counters().work_calls, nitems // min_items + 1)
+
 
 if __name__ == '__main__':
     gr_unittest.run(test_block_gateway)
@@ -1,10 +1,16 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <future>
 #include <iostream>
+#include <map>
 #include <thread>
 
 #include <gnuradio/streamops/copy.h>
+#include <gnuradio/streamops/head.h>
+#include <gnuradio/streamops/throttle.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/null_source.h>
 #include <gnuradio/blocks/vector_sink.h>
 #include <gnuradio/blocks/vector_source.h>
 #include <gnuradio/buffer_cpu_vmcirc.h>
@@ -178,3 +184,449 @@ TEST(SchedulerMTTest, CustomCPUBuffers)
     EXPECT_EQ(snk1->data(), input_data);
     EXPECT_EQ(snk2->data(), input_data);
 }
+
+TEST(SchedulerMTTest, CoalescedNotifications)
+{
+    // Small buffers generate a notification per handful of samples, most of which
+    // should be folded into one already waiting on the neighboring thread
+    int nsamples = 1000000;
+    std::vector<float> input_data(nsamples);
+    for (int i = 0; i < nsamples; i++) {
+        input_data[i] = i;
+    }
+    auto src = blocks::vector_source_f::make_cpu({ input_data, false });
+    auto snk = blocks::vector_sink_f::make({});
+
+    auto fg = flowgraph::make();
+    block_sptr last = src;
+    for (int i = 0; i < 4; i++) {
+        auto c = streamops::copy::make({ sizeof(float) });
+        fg->connect(last, 0, c, 0);
+        last = c;
+    }
+    fg->connect(last, 0, snk, 0);
+
+    auto sched = schedulers::scheduler_nbt::make("nbt", 4096);
+    auto rt = runtime::make();
+    rt->add_scheduler(sched);
+    rt->initialize(fg);
+    rt->start();
+    rt->wait();
+
+    EXPECT_EQ(snk->data(), input_data);
+    EXPECT_GT(sched->notifications_suppressed(), 0u);
+}
+
+TEST(SchedulerMTTest, WaitPolicies)
+{
+    int nsamples = 100000;
+    std::vector<float> input_data(nsamples);
+    for (int i = 0; i < nsamples; i++) {
+        input_data[i] = i;
+    }
+
+    for (auto policy : { wait_policy_t::BLOCK,
+                         wait_policy_t::SPIN_THEN_BLOCK,
+                         wait_policy_t::BUSY_POLL }) {
+        auto src = blocks::vector_source_f::make_cpu({ input_data, false });
+        auto cp1 = streamops::copy::make({ sizeof(float) });
+        auto cp2 = streamops::copy::make({ sizeof(float) });
+        auto snk = blocks::vector_sink_f::make({});
+
+        auto fg = flowgraph::make();
+        fg->connect(src, 0, cp1, 0);
+        fg->connect(cp1, 0, cp2, 0);
+        fg->connect(cp2, 0, snk, 0);
+
+        // The copy blocks get their own policy, the rest use the scheduler default
+        auto sched = schedulers::scheduler_nbt::make("nbt");
+        sched->set_default_wait_policy(policy, 100);
+        block_group_properties bgp({ cp1, cp2 }, "copies");
+        bgp.set_wait_policy(wait_policy_t::SPIN_THEN_BLOCK);
+        sched->add_block_group(bgp);
+
+        auto rt = runtime::make();
+        rt->add_scheduler(sched);
+        rt->initialize(fg);
+        rt->start();
+        rt->wait();
+
+        EXPECT_EQ(snk->data(), input_data);
+    }
+}
+
+TEST(SchedulerMTTest, FlushLatency)
+{
+    // Once the head block is done, end of stream reaches each block downstream with
+    // the notification that follows the last items.  Blocks should finish within an
+    // iteration or two of that instead of retrying until they have been blocked often
+    // enough.
+    size_t nsamples = 1000;
+    auto src = blocks::null_source::make({ 1, sizeof(float) });
+    auto hd = streamops::head::make({ nsamples, sizeof(float) });
+    auto cp = streamops::copy::make({ sizeof(float) });
+    auto snk = blocks::vector_sink_f::make({});
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, hd, 0);
+    fg->connect(hd, 0, cp, 0);
+    fg->connect(cp, 0, snk, 0);
+
+    auto rt = runtime::make();
+    rt->initialize(fg);
+
+    block_perf_snapshot cp_at_eos, snk_at_eos;
+    auto hd_buf = hd->output_stream_ports()[0]->buffer();
+    std::thread watcher([&] {
+        while (!hd_buf->eos()) {
+            std::this_thread::yield();
+        }
+        cp_at_eos = cp->perf_counters().snapshot();
+        snk_at_eos = snk->perf_counters().snapshot();
+    });
+
+    rt->start();
+    rt->wait();
+    watcher.join();
+
+    EXPECT_EQ(snk->data().size(), nsamples);
+    EXPECT_TRUE(cp->input_stream_ports()[0]->buffer_reader()->done());
+    EXPECT_TRUE(snk->input_stream_ports()[0]->buffer_reader()->done());
+    EXPECT_LE(cp->perf_counters().snapshot().blocked_in - cp_at_eos.blocked_in, 2u);
+    EXPECT_LE(snk->perf_counters().snapshot().blocked_in - snk_at_eos.blocked_in, 3u);
+}
+
+TEST(SchedulerMTTest, AsyncParameterAccess)
+{
+    auto src = blocks::null_source::make({ 1, sizeof(float) });
+    auto mult = math::multiply_const_ff::make({ 1.0 });
+    auto snk = blocks::null_sink::make({ 1, sizeof(float) });
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, mult, 0);
+    fg->connect(mult, 0, snk, 0);
+
+    auto rt = runtime::make();
+    rt->initialize(fg);
+    rt->start();
+
+    // Keep several requests in flight before waiting on any of them
+    auto k_id = mult->get_param_id("k");
+    std::vector<std::future<void>> changes;
+    for (int i = 1; i <= 8; i++) {
+        changes.push_back(
+            mult->request_parameter_change_async(k_id, pmtf::pmt((float)i)));
+    }
+    auto query = mult->request_parameter_query_async(k_id);
+    auto batch =
+        mult->request_parameters_query_async({ k_id, mult->get_param_id("vlen") });
+
+    for (auto& c : changes) {
+        EXPECT_EQ(c.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    }
+    ASSERT_EQ(query.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(pmtf::get_as<float>(query.get()), 8.0f);
+
+    ASSERT_EQ(batch.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    auto values = batch.get();
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_EQ(pmtf::get_as<float>(values[0]), 8.0f);
+    EXPECT_EQ(pmtf::get_as<size_t>(values[1]), 1u);
+
+    auto blocking = mult->request_parameters_query({ "k" });
+    ASSERT_EQ(blocking.size(), 1u);
+    EXPECT_EQ(pmtf::get_as<float>(blocking[0]), 8.0f);
+
+    rt->stop();
+}
+
+namespace {
+
+// A scheduler that stops before it gets to the messages pushed to it
+struct dropping_scheduler : neighbor_interface {
+    void push_message(scheduler_message_sptr msg) override {}
+};
+
+template <typename T>
+void expect_broken_promise(std::future<T>& f)
+{
+    try {
+        f.get();
+        FAIL() << "dropped request did not break its promise";
+    } catch (const std::future_error& e) {
+        EXPECT_EQ(e.code(), std::future_errc::broken_promise);
+    }
+}
+
+} // namespace
+
+TEST(SchedulerMTTest, AsyncParameterRequestDropped)
+{
+    auto mult = math::multiply_const_ff::make({ 1.0 });
+    mult->set_parent_intf(std::make_shared<dropping_scheduler>());
+    mult->start();
+
+    auto k_id = mult->get_param_id("k");
+    auto change = mult->request_parameter_change_async(k_id, pmtf::pmt(2.0f));
+    auto query = mult->request_parameter_query_async(k_id);
+    auto batch = mult->request_parameters_query_async({ k_id });
+    expect_broken_promise(change);
+    expect_broken_promise(query);
+    expect_broken_promise(batch);
+
+    // Once the block is no longer running, requests are serviced in place
+    mult->stop();
+    EXPECT_EQ(pmtf::get_as<float>(mult->request_parameter_query_async(k_id).get()),
+              1.0f);
+}
+
+TEST(SchedulerMTTest, BufferSizing)
+{
+    std::vector<float> input_data(300000);
+    for (size_t i = 0; i < input_data.size(); i++) {
+        input_data[i] = i;
+    }
+    auto src = blocks::vector_source_f::make({ input_data, false });
+    auto cp1 = streamops::copy::make({ sizeof(float) });
+    auto cp2 = streamops::copy::make({ sizeof(float) });
+    auto snk = blocks::vector_sink_f::make({});
+
+    // More than half of the default buffer, so the buffer feeding it has to grow
+    size_t min_items = 50000;
+    cp2->set_min_input_items(min_items);
+
+    auto fg = flowgraph::make();
+    auto e0 = fg->connect(src, 0, cp1, 0);
+    auto e1 = fg->connect(cp1, 0, cp2, 0);
+    auto e2 = fg->connect(cp2, 0, snk, 0);
+
+    // 1 ms at 1 Msps is about a thousand items
+    auto sched = schedulers::scheduler_nbt::make("nbt");
+    sched->set_buffer_latency_target(1e6, 1e-3);
+
+    auto rt = runtime::make();
+    rt->add_scheduler(sched);
+    rt->initialize(fg);
+
+    std::map<std::string, buffer_size_report> sizes;
+    for (auto& s : sched->buffer_sizes()) {
+        sizes[s.edge] = s;
+    }
+    ASSERT_EQ(sizes.size(), 3u);
+
+    // Buffers are rounded up to whole pages
+    for (auto& e : { e0, e2 }) {
+        auto& s = sizes.at(e->identifier());
+        EXPECT_EQ(s.reason, "latency target");
+        EXPECT_GE(s.num_items, 1000u);
+        EXPECT_LT(s.num_items, 4096u);
+    }
+    auto& s1 = sizes.at(e1->identifier());
+    EXPECT_EQ(s1.reason, "minimum input of " + cp2->alias());
+    EXPECT_GE(s1.num_items, 2 * min_items);
+
+    EXPECT_EQ(src->output_stream_ports()[0]->buffer()->num_items(),
+              sizes.at(e0->identifier()).num_items);
+    EXPECT_EQ(cp1->output_stream_ports()[0]->buffer()->num_items(), s1.num_items);
+
+    rt->start();
+    rt->wait();
+
+    EXPECT_EQ(snk->data(), input_data);
+}
+
+TEST(SchedulerMTTest, MinWorkItems)
+{
+    std::vector<float> input_data(100003);
+    for (size_t i = 0; i < input_data.size(); i++) {
+        input_data[i] = i;
+    }
+    auto src = blocks::vector_source_f::make({ input_data, false });
+    auto cp = streamops::copy::make({ sizeof(float) });
+    auto snk = blocks::vector_sink_f::make({});
+
+    size_t min_items = 8192;
+    cp->set_min_work_items(min_items);
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, cp, 0);
+    fg->connect(cp, 0, snk, 0);
+
+    auto rt = runtime::make();
+    rt->initialize(fg);
+
+    EXPECT_GE(src->output_stream_ports()[0]->buffer()->num_items(), 2 * min_items);
+    EXPECT_GE(cp->output_stream_ports()[0]->buffer()->num_items(), 2 * min_items);
+
+    rt->start();
+    rt->wait();
+
+    // The items short of the minimum at the end of the stream still go through
+    EXPECT_EQ(snk->data(), input_data);
+    EXPECT_LE(cp->perf_counters().snapshot().work_calls,
+              input_data.size() / min_items + 1);
+}
+
+TEST(SchedulerMTTest, FusedChain)
+{
+    std::vector<float> input_data(300000);
+    std::vector<float> expected_data(input_data.size());
+    for (size_t i = 0; i < input_data.size(); i++) {
+        input_data[i] = i;
+        expected_data[i] = 2.0f * 3.0f * 4.0f * i;
+    }
+    auto src = blocks::vector_source_f::make({ input_data, false });
+    auto mult1 = math::multiply_const_ff::make_cpu({ 2.0 });
+    auto mult2 = math::multiply_const_ff::make_cpu({ 3.0 });
+    auto mult3 = math::multiply_const_ff::make_cpu({ 4.0 });
+    auto snk1 = blocks::vector_sink_f::make({});
+    auto snk2 = blocks::vector_sink_f::make({});
+
+    // mult1 feeds two blocks, so only mult2 and mult3 form a chain
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, mult1, 0);
+    fg->connect(mult1, 0, mult2, 0);
+    fg->connect(mult1, 0, snk2, 0);
+    fg->connect(mult2, 0, mult3, 0);
+    fg->connect(mult3, 0, snk1, 0);
+
+    // A tile that is not a multiple of the item counts of the other buffers
+    size_t tile_bytes = 1000;
+    auto sched = schedulers::scheduler_nbt::make("nbt");
+    sched->set_fuse_tile_size(tile_bytes);
+
+    auto rt = runtime::make();
+    rt->add_scheduler(sched);
+    rt->initialize(fg);
+
+    auto& chains = sched->fused_chains();
+    ASSERT_EQ(chains.size(), 1u);
+    ASSERT_EQ(chains[0].blocks.size(), 2u);
+    EXPECT_EQ(chains[0].blocks[0], mult2);
+    EXPECT_EQ(chains[0].blocks[1], mult3);
+    EXPECT_EQ(mult2->output_stream_ports()[0]->buffer()->num_items(),
+              tile_bytes / sizeof(float));
+
+    rt->start();
+    rt->wait();
+
+    EXPECT_EQ(snk1->data(), expected_data);
+    EXPECT_EQ(snk2->data().size(), input_data.size());
+}
+
+TEST(SchedulerMTTest, FusedChainStops)
+{
+    // The source never runs dry, so the chain always has input to work on
+    auto src = blocks::null_source::make({ 1, sizeof(float) });
+    auto mult1 = math::multiply_const_ff::make_cpu({ 2.0 });
+    auto mult2 = math::multiply_const_ff::make_cpu({ 3.0 });
+    auto snk = blocks::null_sink::make({ 1, sizeof(float) });
+
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, mult1, 0);
+    fg->connect(mult1, 0, mult2, 0);
+    fg->connect(mult2, 0, snk, 0);
+
+    auto sched = schedulers::scheduler_nbt::make("nbt");
+    sched->set_fuse_tile_size(1024);
+
+    auto rt = runtime::make();
+    rt->add_scheduler(sched);
+    rt->initialize(fg);
+    ASSERT_EQ(sched->fused_chains().size(), 1u);
+
+    rt->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto stopped = std::async(std::launch::async, [&rt] { rt->stop(); });
+    ASSERT_EQ(stopped.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_GT(mult2->perf_counters().snapshot().work_calls, 0u);
+}
+
+TEST(SchedulerMTTest, InplaceBuffers)
+{
+    std::vector<float> input_data(300000);
+    std::vector<float> expected_data(input_data.size());
+    for (size_t i = 0; i < input_data.size(); i++) {
+        input_data[i] = i;
+        expected_data[i] = 2.0f * 3.0f * i;
+    }
+    auto src = blocks::vector_source_f::make({ input_data, false });
+    auto mult1 = math::multiply_const_ff::make_cpu({ 2.0 });
+    auto mult2 = math::multiply_const_ff::make_cpu({ 3.0 });
+    auto cp = streamops::copy::make({ sizeof(float) });
+    auto mult3 = math::multiply_const_ff::make_cpu({ 4.0 });
+    auto snk1 = blocks::vector_sink_f::make({});
+    auto snk2 = blocks::vector_sink_f::make({});
+    auto snk3 = blocks::vector_sink_f::make({});
+
+    // mult2 has two readers, so the output of cp and mult3 cannot reuse its memory
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, mult1, 0);
+    fg->connect(mult1, 0, mult2, 0);
+    fg->connect(mult2, 0, cp, 0);
+    fg->connect(mult2, 0, mult3, 0);
+    fg->connect(cp, 0, snk1, 0);
+    fg->connect(cp, 0, snk2, 0);
+    fg->connect(mult3, 0, snk3, 0);
+
+    // A small buffer, so that the shared memory wraps many times
+    auto sched = schedulers::scheduler_nbt::make("nbt", 4096);
+    sched->set_inplace_buffers(true);
+
+    auto rt = runtime::make();
+    rt->add_scheduler(sched);
+    rt->initialize(fg);
+
+    EXPECT_EQ(mult1->output_stream_ports()[0]->buffer()->type(), "buffer_cpu_inplace");
+    EXPECT_EQ(mult2->output_stream_ports()[0]->buffer()->type(), "buffer_cpu_inplace");
+    EXPECT_NE(cp->output_stream_ports()[0]->buffer()->type(), "buffer_cpu_inplace");
+    EXPECT_NE(mult3->output_stream_ports()[0]->buffer()->type(), "buffer_cpu_inplace");
+
+    rt->start();
+    rt->wait();
+
+    EXPECT_EQ(snk1->data(), expected_data);
+    EXPECT_EQ(snk2->data(), expected_data);
+    for (auto& x : expected_data) {
+        x *= 4.0f;
+    }
+    EXPECT_EQ(snk3->data(), expected_data);
+}
+
+TEST(SchedulerMTTest, InplaceBuffersSlowReader)
+{
+    std::vector<float> input_data(400000);
+    std::vector<float> expected_data(input_data.size());
+    for (size_t i = 0; i < input_data.size(); i++) {
+        input_data[i] = i;
+        expected_data[i] = 2.0f * 3.0f * i;
+    }
+    auto src = blocks::vector_source_f::make({ input_data, false });
+    auto mult1 = math::multiply_const_ff::make_cpu({ 2.0 });
+    auto mult2 = math::multiply_const_ff::make_cpu({ 3.0 });
+    auto thr = streamops::throttle::make({ 8e6, true, sizeof(float) });
+    auto snk = blocks::vector_sink_f::make({});
+
+    // The throttle is the only reader of the shared memory and lags behind, so the
+    // source keeps the small buffer full and writes as soon as any space is handed back
+    auto fg = flowgraph::make();
+    fg->connect(src, 0, mult1, 0);
+    fg->connect(mult1, 0, mult2, 0);
+    fg->connect(mult2, 0, thr, 0);
+    fg->connect(thr, 0, snk, 0);
+
+    auto sched = schedulers::scheduler_nbt::make("nbt", 4096);
+    sched->set_inplace_buffers(true);
+
+    auto rt = runtime::make();
+    rt->add_scheduler(sched);
+    rt->initialize(fg);
+
+    EXPECT_EQ(mult2->output_stream_ports()[0]->buffer()->type(), "buffer_cpu_inplace");
+
+    rt->start();
+    rt->wait();
+
+    EXPECT_EQ(snk->data(), expected_data);
+}
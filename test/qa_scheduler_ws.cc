@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/flowgraph.h>
+#include <gnuradio/math/multiply_const.h>
+#include <gnuradio/runtime.h>
+#include <gnuradio/schedulers/ws/scheduler_ws.h>
+#include <gnuradio/streamops/copy.h>
+
+using namespace gr;
+
+TEST(SchedulerWSTest, CopyChain)
+{
+    int nsamples = 100000;
+    std::vector<float> input_data(nsamples);
+    for (int i = 0; i < nsamples; i++) {
+        input_data[i] = i;
+    }
+
+    for (auto nworkers : { 1, 2, 4 }) {
+        auto src = blocks::vector_source_f::make({ input_data, false });
+        std::vector<streamops::copy::sptr> copy_blks(8);
+        for (auto& c : copy_blks) {
+            c = streamops::copy::make({ sizeof(float) });
+        }
+        auto snk = blocks::vector_sink_f::make({});
+
+        auto fg = flowgraph::make();
+        fg->connect(src, 0, copy_blks[0], 0);
+        for (size_t i = 1; i < copy_blks.size(); i++) {
+            fg->connect(copy_blks[i - 1], 0, copy_blks[i], 0);
+        }
+        fg->connect(copy_blks.back(), 0, snk, 0);
+
+        auto sched = schedulers::scheduler_ws::make("ws", nworkers);
+        EXPECT_EQ(sched->num_workers(), (unsigned int)nworkers);
+
+        auto rt = runtime::make();
+        rt->add_scheduler(sched);
+        rt->initialize(fg);
+        rt->start();
+        rt->wait();
+
+        EXPECT_EQ(snk->data(), input_data);
+    }
+}
+
+TEST(SchedulerWSTest, BlockFanout)
+{
+    int nsamples = 1000000;
+    std::vector<gr_complex> input_data(nsamples);
+    std::vector<gr_complex> expected_data(nsamples);
+    float k = 2.0;
+    for (int i = 0; i < nsamples; i++) {
+        input_data[i] = gr_complex(2 * i, 2 * i + 1);
+        expected_data[i] = gr_complex(k * 2 * i, k * (2 * i + 1));
+    }
+
+    int nblocks = 16;
+    auto src = blocks::vector_source_c::make_cpu({ input_data });
+    std::vector<blocks::vector_sink_c::sptr> sink_blks(nblocks);
+    std::vector<math::multiply_const_cc::sptr> mult_blks(nblocks);
+
+    auto fg = flowgraph::make();
+    for (int i = 0; i < nblocks; i++) {
+        mult_blks[i] = math::multiply_const_cc::make_cpu({ k, 1 });
+        sink_blks[i] = blocks::vector_sink_c::make({});
+        fg->connect(src, 0, mult_blks[i], 0);
+        fg->connect(mult_blks[i], 0, sink_blks[i], 0);
+    }
+
+    auto rt = runtime::make();
+    rt->add_scheduler(schedulers::scheduler_ws::make("ws", 4));
+    rt->initialize(fg);
+    rt->start();
+    rt->wait();
+
+    for (int n = 0; n < nblocks; n++) {
+        EXPECT_EQ(sink_blks[n]->data(), expected_data);
+    }
+}
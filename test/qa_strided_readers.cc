@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/buffer_cpu_lockfree.h>
+#include <gnuradio/buffer_cpu_vmcirc.h>
+#include <gnuradio/edge.h>
+#include <gnuradio/flowgraph.h>
+#include <gnuradio/math/multiply_const.h>
+#include <gnuradio/runtime.h>
+
+using namespace gr;
+
+namespace {
+
+// Write an interleaved ramp through the buffer and read it back as nstreams strided
+// views, with the writer wrapping around the end of the buffer several times
+void check_strided_readers(buffer_sptr buf, size_t nstreams)
+{
+    size_t nframes = 100000;
+    std::vector<buffer_reader_sptr> rdrs;
+    for (size_t j = 0; j < nstreams; j++) {
+        rdrs.push_back(buf->add_reader(nullptr, sizeof(uint32_t)));
+        rdrs[j]->set_stride(j, nstreams);
+        EXPECT_EQ(rdrs[j]->item_size(), nstreams * sizeof(uint32_t));
+    }
+
+    uint32_t next = 0;
+    std::vector<uint32_t> expected(nstreams);
+    for (size_t j = 0; j < nstreams; j++) {
+        expected[j] = j;
+    }
+    size_t n_errors = 0;
+    while (next < nframes * nstreams) {
+        buffer_info_t wi;
+        buf->write_info(wi);
+        // write a number of items that is not a whole number of frames
+        size_t n = std::min({ (size_t)wi.n_items, nframes * nstreams - next, 777ul });
+        auto wptr = (uint32_t*)wi.ptr;
+        for (size_t i = 0; i < n; i++) {
+            wptr[i] = next++;
+        }
+        buf->post_write(n);
+
+        for (size_t j = 0; j < nstreams; j++) {
+            buffer_info_t ri;
+            rdrs[j]->read_info(ri);
+            EXPECT_EQ(ri.ptr, rdrs[j]->read_ptr());
+            auto rptr = (const uint32_t*)ri.ptr;
+            for (int i = 0; i < ri.n_items; i++) {
+                if (rptr[i * nstreams] != expected[j]) {
+                    n_errors++;
+                }
+                expected[j] += nstreams;
+            }
+            rdrs[j]->post_read(ri.n_items);
+        }
+    }
+
+    EXPECT_EQ(n_errors, 0);
+    for (auto& r : rdrs) {
+        EXPECT_EQ(r->total_read(), nframes);
+    }
+}
+
+} // namespace
+
+TEST(StridedReaders, Lockfree)
+{
+    for (size_t nstreams : { 2, 3, 4 }) {
+        auto buf = buffer_cpu_lockfree::make(
+            8192, sizeof(uint32_t), BUFFER_CPU_LOCKFREE_ARGS);
+        check_strided_readers(buf, nstreams);
+    }
+}
+
+TEST(StridedReaders, Vmcirc)
+{
+    for (size_t nstreams : { 2, 3, 4 }) {
+        auto props = BUFFER_CPU_VMCIRC_ARGS;
+        auto buf = props->factory()(8192, sizeof(uint32_t), props);
+        check_strided_readers(buf, nstreams);
+    }
+}
+
+TEST(StridedReaders, InvalidStride)
+{
+    auto buf =
+        buffer_cpu_lockfree::make(8192, sizeof(uint32_t), BUFFER_CPU_LOCKFREE_ARGS);
+    auto rdr = buf->add_reader(nullptr, sizeof(uint32_t));
+    EXPECT_THROW(rdr->set_stride(0, 0), std::invalid_argument);
+    EXPECT_THROW(rdr->set_stride(2, 2), std::invalid_argument);
+
+    // The view is over items of the buffer, not of a vector reader
+    auto vec_rdr = buf->add_reader(nullptr, 4 * sizeof(uint32_t));
+    EXPECT_THROW(vec_rdr->set_stride(0, 2), std::invalid_argument);
+
+    edge e(nullptr, nullptr, nullptr, nullptr);
+    EXPECT_THROW(e.set_stride(3, 3), std::invalid_argument);
+}
+
+TEST(StridedReaders, PruneTags)
+{
+    auto buf =
+        buffer_cpu_lockfree::make(8192, sizeof(uint32_t), BUFFER_CPU_LOCKFREE_ARGS);
+    auto rdr0 = buf->add_reader(nullptr, sizeof(uint32_t));
+    auto rdr1 = buf->add_reader(nullptr, sizeof(uint32_t));
+    rdr0->set_stride(0, 2);
+    rdr1->set_stride(1, 2);
+
+    // tag offsets are in items of the buffer
+    for (uint64_t offset = 0; offset < 6; offset++) {
+        buf->add_tag(tag_t(offset, tag_map{}));
+    }
+    buf->post_write(6);
+
+    // the readers are next at buffer items 4 and 3
+    rdr0->post_read(2);
+    rdr1->post_read(1);
+    buf->prune_tags();
+    EXPECT_EQ(buf->tags().size(), (size_t)3);
+    EXPECT_EQ(buf->tags().front().offset(), (uint64_t)3);
+
+    // and then at 4 and 7
+    rdr1->post_read(2);
+    buf->prune_tags();
+    EXPECT_EQ(buf->tags().size(), (size_t)2);
+    EXPECT_EQ(buf->tags().front().offset(), (uint64_t)4);
+}
+
+TEST(StridedReaders, Flowgraph)
+{
+    size_t nstreams = 3;
+    size_t nframes = 100000;
+    std::vector<float> input_data(nstreams * nframes);
+    for (size_t i = 0; i < input_data.size(); i++) {
+        input_data[i] = i;
+    }
+
+    auto fg = flowgraph::make();
+    auto src = blocks::vector_source_f::make_cpu({ input_data, false });
+    std::vector<blocks::vector_sink_f::sptr> snks(nstreams);
+    for (size_t j = 0; j < nstreams; j++) {
+        snks[j] = blocks::vector_sink_f::make({});
+        fg->connect(src, 0, snks[j], 0)->set_stride(j, nstreams);
+    }
+
+    auto rt = runtime::make();
+    rt->initialize(fg);
+    rt->start();
+    rt->wait();
+
+    for (size_t j = 0; j < nstreams; j++) {
+        std::vector<float> expected_data(nframes);
+        for (size_t i = 0; i < nframes; i++) {
+            expected_data[i] = i * nstreams + j;
+        }
+        EXPECT_EQ(snks[j]->data(), expected_data);
+    }
+}
+
+TEST(StridedReaders, UnsupportedConsumer)
+{
+    std::vector<float> input_data(1000);
+
+    auto fg = flowgraph::make();
+    auto src = blocks::vector_source_f::make_cpu({ input_data, false });
+    auto mult = math::multiply_const_ff::make_cpu({ 2.0 });
+    auto snk = blocks::vector_sink_f::make({});
+    fg->connect(src, 0, mult, 0)->set_stride(0, 2);
+    fg->connect(mult, 0, snk, 0);
+
+    // multiply_const reads its input contiguously
+    auto rt = runtime::make();
+    EXPECT_THROW(rt->initialize(fg), std::invalid_argument);
+}
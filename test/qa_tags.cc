@@ -5,11 +5,13 @@
 #include <thread>
 
 #include <gnuradio/streamops/annotator.h>
+#include <gnuradio/streamops/copy.h>
 #include <gnuradio/streamops/head.h>
 #include <gnuradio/blocks/null_sink.h>
 #include <gnuradio/blocks/null_source.h>
 #include <gnuradio/blocks/vector_sink.h>
 #include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/block_work_io.h>
 #include <gnuradio/buffer_cpu_vmcirc.h>
 #include <gnuradio/flowgraph.h>
 #include <gnuradio/runtime.h>
@@ -210,6 +212,96 @@ TEST(SchedulerMTTags, t3)
 }
 
 
+TEST(SchedulerMTTags, SortedTagStore)
+{
+    auto buf = buffer_cpu_vmcirc::make(8192, sizeof(float), BUFFER_CPU_VMCIRC_ARGS);
+    auto rdr = buf->add_reader(nullptr, sizeof(float));
+    // reader that sees each pair of floats as one item
+    auto rdr2 = buf->add_reader(nullptr, 2 * sizeof(float));
+
+    // out of order insertion, with a duplicate offset
+    for (auto offset : { 10, 30, 20, 0, 20, 40 }) {
+        buf->add_tag(tag_t(offset, tag_map{}));
+    }
+
+    std::vector<uint64_t> offsets;
+    for (auto& t : buf->tags()) {
+        offsets.push_back(t.offset());
+    }
+    EXPECT_EQ(offsets, std::vector<uint64_t>({ 0, 10, 20, 20, 30, 40 }));
+
+    auto window = rdr->get_tags(21);
+    EXPECT_EQ(window.size(), (size_t)4);
+    EXPECT_EQ(rdr->tags_in_window(10, 30).size(), (size_t)3);
+    EXPECT_EQ(rdr->tags_in_window(41, 100).size(), (size_t)0);
+
+    // A vector reused across lookups is refilled, not appended to
+    std::vector<tag_t> tags;
+    rdr->tags_in_range(10, 30, tags);
+    EXPECT_EQ(tags.size(), (size_t)3);
+    EXPECT_EQ(tags.front().offset(), (uint64_t)10);
+    rdr->tags_in_range(30, 100, tags);
+    EXPECT_EQ(tags.size(), (size_t)2);
+
+    // The buffer is not locked between lookups, e.g. for the writer adding tags
+    block_work_input in(100, rdr);
+    auto& in_tags = in.tags();
+    EXPECT_EQ(rdr->tags_in_window(0, 100).size(), in_tags.size());
+    buf->add_tag(tag_t(50, tag_map{}));
+    EXPECT_EQ(in.tags().size(), (size_t)7);
+
+    // offsets are scaled into the reader items
+    auto window2 = rdr2->get_tags(11);
+    EXPECT_EQ(window2.size(), (size_t)4);
+    EXPECT_EQ(window2.back().offset(), (uint64_t)10);
+
+    // tags are dropped once every reader has gone past them
+    buf->post_write(25);
+    rdr->post_read(25);
+    buf->prune_tags();
+    EXPECT_EQ(buf->tags().size(), (size_t)6);
+    rdr2->post_read(12);
+    buf->prune_tags();
+    EXPECT_EQ(buf->tags().size(), (size_t)4);
+    EXPECT_EQ(buf->tags().front().offset(), (uint64_t)20);
+}
+
+TEST(SchedulerMTTags, TagsOnlyKeptForConsumers)
+{
+    size_t N = 40000;
+    auto fg = flowgraph::make();
+    auto src = gr::blocks::null_source::make({});
+    auto head = gr::streamops::head::make_cpu({ N });
+    auto ann0 = gr::streamops::annotator::make_cpu(
+        { 10000, 1, 1, tag_propagation_policy_t::TPP_ALL_TO_ALL });
+    auto ann1 = gr::streamops::annotator::make_cpu(
+        { 10000, 1, 1, tag_propagation_policy_t::TPP_ALL_TO_ALL });
+    auto cp0 = gr::streamops::copy::make({});
+    auto cp1 = gr::streamops::copy::make({});
+    auto snk0 = gr::blocks::null_sink::make({});
+
+    // Only ann1 reads tags, so nothing downstream of it needs to keep them
+    fg->connect(src, 0, head, 0);
+    fg->connect(head, 0, ann0, 0);
+    fg->connect(ann0, 0, cp0, 0);
+    fg->connect(cp0, 0, ann1, 0);
+    fg->connect(ann1, 0, cp1, 0);
+    fg->connect(cp1, 0, snk0, 0);
+
+    auto rt = runtime::make();
+    rt->initialize(fg);
+    rt->start();
+    rt->wait();
+
+    EXPECT_TRUE(ann0->output_stream_ports()[0]->buffer()->tags_needed());
+    EXPECT_TRUE(cp0->output_stream_ports()[0]->buffer()->tags_needed());
+    EXPECT_FALSE(ann1->output_stream_ports()[0]->buffer()->tags_needed());
+    EXPECT_FALSE(cp1->output_stream_ports()[0]->buffer()->tags_needed());
+
+    // Tags still make it through the copy block to the annotator that reads them
+    EXPECT_EQ(ann1->data().size(), (size_t)4);
+}
+
 #if 0 // TODO Rate Change Blocks
 TEST(SchedulerMTTags, t5)
 {